@@ -1,7 +1,7 @@
 #include "stdafx.h"
 #include "Actor.h"
 #include "Zone.h"
-#include "InterestArea.h"
+#include "protocol_cs_helper.h"
 
 Actor::Actor(const uuid & entity_id)
     : GameObject(entity_id)
@@ -16,7 +16,7 @@ Actor::~Actor()
 
 void Actor::UpdateInterest()
 {
-    // ڿ ̵ ˸
+    // 관찰자에게 이동변경 알림
     poistion_update_signal(GetPosition());
 
     if (zone_ == nullptr) return;
@@ -25,45 +25,34 @@ void Actor::UpdateInterest()
     ZoneCell* new_cell = zone_->GetCell(GetPosition());
 
     if (new_cell == current_cell_)
+    {
+        // 같은 구역 안에서 움직였으면
+        if (current_cell_ != nullptr)
+            current_cell_->NotifyActorMove();
         return;
+    }
 
-    // ٸ  Ѿ
+    // 다른 구역으로 넘어갔으면
     current_cell_ = new_cell;
-    //  
-    for (auto& conn : cell_connections_)
-    {
-        conn.disconnect();
-    }
-    cell_connections_.clear();
 
     if (prev_cell != nullptr)
     {
-        //  ٲ ˸.
-        prev_cell->actor_cell_change_signal(prev_cell, new_cell, this);
+        // 지역이 바뀜을 알린다.
+        prev_cell->NotifyActorCellChange(prev_cell, new_cell, this);
     }
     if (new_cell != nullptr)
     {
-        //  ٲ ˸.
-        new_cell->actor_cell_change_signal(prev_cell, new_cell, this);
-
-        cell_connections_.emplace_back(new_cell->interest_area_enter_signal.connect([this](InterestArea* var) { var->OnActorEnter(this); }));
-        cell_connections_.emplace_back(new_cell->interest_area_exit_signal.connect([this](InterestArea* var) { var->OnActorExit(this); }));
+        // 지역이 바뀜을 알린다.
+        new_cell->NotifyActorCellChange(prev_cell, new_cell, this);
     }
 }
 
 void Actor::ResetInterest()
 {
-    //  
-    for (auto& conn : cell_connections_)
-    {
-        conn.disconnect();
-    }
-    cell_connections_.clear();
-
     if (current_cell_ != nullptr)
     {
-        //  ˸.
-        current_cell_->actor_cell_change_signal(current_cell_, nullptr, this);
+        // 나감을 알린다.
+        current_cell_->NotifyActorCellChange(current_cell_, nullptr, this);
     }
 
     current_cell_ = nullptr;
@@ -74,7 +63,15 @@ void Actor::PublishActorUpdate(PCS::World::Notify_UpdateT * message)
     if (current_cell_ == nullptr)
         return;
 
-    current_cell_->actor_update_signal(message);
+    // 받을 대상이 없으면 인코딩하지 않는다.
+    if (current_cell_->actor_update_observers.Empty())
+        return;
+
+    // 이동은 마지막 위치만 의미가 있다. 나머지 상태 변경은 모두 전달해야 한다.
+    bool latest_only = (message->update_data.type == PCS::World::UpdateType::MoveActionInfo);
+
+    // 한번만 인코딩해서 구독자 모두에게 같은 버퍼를 보낸다.
+    current_cell_->actor_update_observers.Notify(PCS::Encode(*message), this, latest_only);
 }
 
 void Actor::Spawn(const Vector3 & position)
@@ -10,7 +10,7 @@ namespace PCS = ProtocolCS;
 class Zone;
 class ZoneCell;
 
-// ӻ󿡼  ȣ ۿϴ ֻ Ŭ
+// 개임상에서 서로 상호 작용하는 최상위 클래스
 class Actor : public GameObject
 {
 public:
@@ -67,5 +67,4 @@ private:
 	std::string name_;
 	Zone* zone_;
     ZoneCell* current_cell_;
-    std::vector<signals2::connection> cell_connections_;
 };
@@ -31,12 +31,12 @@ struct BoundingBox
         return (point.X < min.X || point.X > max.X || point.Y < min.Y || point.Y > max.Y) ==
             false;
     }
-    // ġ 
+    // 겹치는 영역
     BoundingBox IntersectWith(const BoundingBox& other) const
     {
         return BoundingBox(Max(min, other.min), Min(max, other.max));
     }
-    // ο ϴ 
+    // 두영역을 포함하는 영역
     BoundingBox UnionWith(const BoundingBox& other) const
     {
         return BoundingBox(Min(min, other.min), Max(max, other.max));
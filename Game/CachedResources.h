@@ -9,9 +9,9 @@
 
 namespace db = db_schema;
 
-// DB Ͽ ̸ о ӿ ʿ  ̺
+// DB나 파일에서 미리 읽어놓은 게임에 필요한 데이터 테이블들
 
-//  ̺
+// 맵 테이블
 class MapTable : public Singleton<MapTable>
 {
 public:
@@ -65,7 +65,7 @@ private:
 	std::vector<db::Map> data_;
 };
 
-//  Ա ̺
+// 맵 출입구 테이블
 class MapGateTable : public Singleton<MapGateTable>
 {
 public:
@@ -117,7 +117,7 @@ private:
     std::vector<db::MapGate> data_;
 };
 
-//  ɷġ ̺
+// 영웅 능력치 테이블
 class HeroAttributeTable : public Singleton<HeroAttributeTable>
 {
 public:
@@ -173,7 +173,7 @@ private:
 	std::vector<db::HeroAttribute> data_;
 };
 
-//  ̺
+// 몬스터 테이블
 class MonsterTable : public Singleton<MonsterTable>
 {
 public:
@@ -227,7 +227,7 @@ private:
 
 };
 
-//   ̺
+// 몬스터 스폰 테이블
 class MonsterSpawnTable : public Singleton<MonsterSpawnTable>
 {
 public:
@@ -277,7 +277,7 @@ private:
     std::unordered_map<int, db::MonsterSpawn> data_;
 };
 
-// ų ̺
+// 스킬 테이블
 class SkillTable : public Singleton<SkillTable>
 {
 public:
@@ -332,7 +332,7 @@ private:
     std::unordered_map<int, db::Skill> data_;
 };
 
-// ÷̾  ĳ Ȱ ̺
+// 플레이어 영웅 캐릭터 부활지점 테이블
 class HeroSpawnTable : public Singleton<HeroSpawnTable>
 {
 public:
@@ -4,6 +4,34 @@
 #include "Zone.h"
 #include "Actor.h"
 
+namespace {
+
+// 영역을 65535 등분한 위치. 영역 밖은 경계로 자른다.
+uint16_t QuantizePosition(float value, float min, float size)
+{
+    if (size <= 0.0f)
+        return 0;
+    float t = std::min(std::max((value - min) / size, 0.0f), 1.0f);
+    return static_cast<uint16_t>(std::lround(t * 65535.0f));
+}
+
+// 360 도를 65536 등분한 회전
+uint16_t QuantizeRotation(float degrees)
+{
+    degrees = std::fmod(degrees, 360.0f);
+    if (degrees < 0.0f)
+        degrees += 360.0f;
+    return static_cast<uint16_t>(std::lround(degrees / 360.0f * 65536.0f) & 0xFFFF);
+}
+
+// 0.01 단위 속도
+int16_t QuantizeVelocity(float value)
+{
+    return static_cast<int16_t>(std::lround(std::min(std::max(value * 100.0f, -32767.0f), 32767.0f)));
+}
+
+} // namespace
+
 ClientInterestArea::ClientInterestArea(RemoteClient * rc, GridType * grid)
     : InterestArea(grid)
     , rc_(rc)
@@ -12,59 +40,247 @@ ClientInterestArea::ClientInterestArea(RemoteClient * rc, GridType * grid)
 
 ClientInterestArea::~ClientInterestArea()
 {
-    for (auto& e : update_connections_)
-    {
-        e.second.disconnect();
-    }
 }
 
-//   Cell ö
-void ClientInterestArea::OnCellEnter(CellType * cell)
+// 관심 지역에 Cell이 들어올때
+void ClientInterestArea::OnCellEnter(CellObserver & observer)
 {
-    InterestArea::OnCellEnter(cell);
+    InterestArea::OnCellEnter(observer);
 
-    signals2::connection conn = cell->actor_update_signal.connect(std::bind(&ClientInterestArea::OnActorUpdate, this, std::placeholders::_1));
-    update_connections_.emplace(cell, std::move(conn));
+    observer.actor_update.Bind<ClientInterestArea, &ClientInterestArea::OnActorUpdate>(this);
+    observer.cell->actor_update_observers.Subscribe(observer.actor_update);
 }
 
-//   Cell 
-void ClientInterestArea::OnCellExit(CellType * cell)
+// 관심 지역에 Actor가 들어올때
+void ClientInterestArea::OnActorEnter(Actor * actor)
 {
-    InterestArea::OnCellExit(cell);
+    if (actor == nullptr) return;
 
-    //      
-    auto iter = update_connections_.find(cell);
-    if (iter != update_connections_.end())
+    // 나타남 메시지가 현재 상태를 가지고 있으므로 이번 틱에 보낸 것으로 한다.
+    auto iter = std::lower_bound(replications_.begin(), replications_.end(), actor, ReplicationLess);
+    if (iter == replications_.end() || iter->actor != actor)
     {
-        iter->second.disconnect();
-        update_connections_.erase(iter);
+        Replication replication{ actor, tick_, nullptr, 0, false, {} };
+        if (snapshot_)
+        {
+            // 나타남 메시지의 상태가 스냅샷의 기준이다. 속도는 들어 있지 않으므로 0 으로 한다.
+            replication.net_id = AllocateNetId();
+            replication.sent = Quantize(actor);
+            replication.sent.velocity_x = replication.sent.velocity_y = replication.sent.velocity_z = 0;
+        }
+        iter = replications_.insert(iter, replication);
     }
-}
-
-//   Actor ö
-void ClientInterestArea::OnActorEnter(Actor * actor)
-{
-    if (actor == nullptr) return;
 
-    flatbuffers::FlatBufferBuilder fbb;
+    flatbuffers::FlatBufferBuilder fbb(BUILDER_INITIAL_SIZE, &PooledBuilderAllocator::Instance());
     auto actor_offset = actor->Serialize(fbb);
-    auto notify = PCS::World::CreateNotify_Appear(fbb, actor_offset);
+    auto notify = PCS::World::CreateNotify_Appear(fbb, actor_offset, iter->net_id);
     PCS::Send(*rc_, fbb, notify);
 }
 
-//   Actor 
+// 관심 지역에 Actor가 나갈때
 void ClientInterestArea::OnActorExit(Actor * actor)
 {
     if (actor == nullptr) return;
 
-    flatbuffers::FlatBufferBuilder fbb;
+    auto iter = std::lower_bound(replications_.begin(), replications_.end(), actor, ReplicationLess);
+    if (iter != replications_.end() && iter->actor == actor)
+    {
+        if (iter->pending != nullptr)
+            pending_count_--;
+        if (iter->dirty)
+            dirty_count_--;
+        if (iter->net_id != 0)
+            FreeNetId(iter->net_id);
+        replications_.erase(iter);
+    }
+
+    flatbuffers::FlatBufferBuilder fbb(BUILDER_INITIAL_SIZE, &PooledBuilderAllocator::Instance());
     auto notify = PCS::World::CreateNotify_DisappearDirect(fbb, uuids::to_string(actor->GetEntityID()).c_str());
     PCS::Send(*rc_, fbb, notify);
 }
 
-void ClientInterestArea::OnActorUpdate(PCS::World::Notify_UpdateT * message)
+void ClientInterestArea::OnActorUpdate(const Ptr<net::SendBuffer>& message, const Actor* actor, bool latest_only)
 {
     if (message == nullptr) return;
+    // 구독하는 셀에 있어도 아직 보이지 않는 Actor 의 갱신은 보내지 않는다.
+    if (actor != nullptr && !IsVisible(actor)) return;
+
+    if (!latest_only || actor == nullptr)
+    {
+        rc_->Send(message);
+        return;
+    }
+
+    auto iter = std::lower_bound(replications_.begin(), replications_.end(), actor, ReplicationLess);
+    if (iter == replications_.end() || iter->actor != actor)
+    {
+        SendMove(message, actor);
+        return;
+    }
+
+    // 스냅샷은 틱에서 그때의 상태로 만든다.
+    if (iter->net_id != 0)
+    {
+        if (!iter->dirty)
+        {
+            iter->dirty = true;
+            dirty_count_++;
+        }
+        return;
+    }
+
+    // 주기가 되었으면 바로 보내고 아니면 마지막 갱신만 남겨 두었다가 틱에서 보낸다.
+    if (tick_ - iter->last_sent_tick >= ReplicationInterval(actor))
+    {
+        if (iter->pending != nullptr)
+        {
+            iter->pending = nullptr;
+            pending_count_--;
+        }
+        iter->last_sent_tick = tick_;
+        SendMove(message, actor);
+    }
+    else
+    {
+        if (iter->pending == nullptr)
+            pending_count_++;
+        iter->pending = message;
+    }
+}
+
+void ClientInterestArea::OnVisibilityUpdated()
+{
+    if (pending_count_ > 0)
+    {
+        for (auto& replication : replications_)
+        {
+            if (replication.pending == nullptr)
+                continue;
+            if (tick_ - replication.last_sent_tick < ReplicationInterval(replication.actor))
+                continue;
+
+            replication.last_sent_tick = tick_;
+            SendMove(replication.pending, replication.actor);
+            replication.pending = nullptr;
+            pending_count_--;
+        }
+    }
+
+    if (dirty_count_ > 0)
+        SendSnapshot();
+
+    tick_++;
+}
+
+bool ClientInterestArea::ReplicationLess(const Replication & replication, const Actor * actor)
+{
+    return replication.actor < actor;
+}
 
-    PCS::Send(*rc_, *message);
+uint32_t ClientInterestArea::ReplicationInterval(const Actor * actor) const
+{
+    if (tiers_.empty())
+        return 1;
+
+    float distance_sq = DistanceSquaredXZ(actor->GetPosition(), Position());
+    for (auto& tier : tiers_)
+    {
+        if (distance_sq <= tier.radius * tier.radius)
+            return tier.interval;
+    }
+    // 마지막 단계보다 멀어도 최소 주기로 보낸다.
+    return tiers_.back().interval;
+}
+
+void ClientInterestArea::SendMove(const Ptr<net::SendBuffer>& message, const Actor * actor)
+{
+    // 이동은 UDP 로 보내서 유실된 패킷이 뒤의 갱신을 막지 않게 한다.
+    // UDP 가 없으면 같은 Actor 의 보내지 못한 이동 메시지가 새 메시지로 교체된다.
+    // 멈춘 Actor 는 뒤에 올 갱신이 없어서 잃어버리면 클라이언트에 틀린 위치가 남으므로 TCP 로 보낸다.
+    net::Channel channel = actor->GetVelocity() == Vector3::Zero ? net::Channel::Latest : net::Channel::Unreliable;
+    rc_->Send(channel, boost::hash<uuid>()(actor->GetEntityID()), message);
 }
+
+uint16_t ClientInterestArea::AllocateNetId()
+{
+    if (!free_net_ids_.empty())
+    {
+        uint16_t net_id = free_net_ids_.back();
+        free_net_ids_.pop_back();
+        return net_id;
+    }
+    // 65535 개를 모두 쓰면 0 이 되고 그 뒤로는 0 을 돌려준다.
+    if (next_net_id_ == 0)
+        return 0;
+    return next_net_id_++;
+}
+
+void ClientInterestArea::FreeNetId(uint16_t net_id)
+{
+    // 사라짐 메시지가 먼저 도착하므로 바로 다시 써도 된다.
+    free_net_ids_.push_back(net_id);
+}
+
+ClientInterestArea::SnapshotState ClientInterestArea::Quantize(const Actor * actor) const
+{
+    const BoundingBox& area = Grid()->Area();
+    Vector3 size = area.Size();
+    const Vector3& position = actor->GetPosition();
+    const Vector3& velocity = actor->GetVelocity();
+
+    SnapshotState state;
+    state.x = QuantizePosition(position.X, area.min.X, size.X);
+    state.y = QuantizePosition(position.Y, area.min.Y, size.Y);
+    state.z = QuantizePosition(position.Z, area.min.Z, size.Z);
+    state.rotation = QuantizeRotation(actor->GetRotation());
+    state.velocity_x = QuantizeVelocity(velocity.X);
+    state.velocity_y = QuantizeVelocity(velocity.Y);
+    state.velocity_z = QuantizeVelocity(velocity.Z);
+    return state;
+}
+
+void ClientInterestArea::SendSnapshot()
+{
+    snapshot_positions_.clear();
+    snapshot_rotations_.clear();
+    snapshot_velocities_.clear();
+
+    for (auto& replication : replications_)
+    {
+        if (!replication.dirty)
+            continue;
+        if (tick_ - replication.last_sent_tick < ReplicationInterval(replication.actor))
+            continue;
+
+        replication.dirty = false;
+        dirty_count_--;
+        replication.last_sent_tick = tick_;
+
+        // 클라이언트가 가진 상태와 다른 필드만 보낸다.
+        SnapshotState state = Quantize(replication.actor);
+        SnapshotState& sent = replication.sent;
+        if (state.x != sent.x || state.y != sent.y || state.z != sent.z)
+            snapshot_positions_.emplace_back(replication.net_id, state.x, state.y, state.z);
+        if (state.rotation != sent.rotation)
+            snapshot_rotations_.emplace_back(replication.net_id, state.rotation);
+        if (state.velocity_x != sent.velocity_x || state.velocity_y != sent.velocity_y || state.velocity_z != sent.velocity_z)
+            snapshot_velocities_.emplace_back(replication.net_id, state.velocity_x, state.velocity_y, state.velocity_z);
+        sent = state;
+    }
+
+    if (snapshot_positions_.empty() && snapshot_rotations_.empty() && snapshot_velocities_.empty())
+        return;
+
+    // 보낸 상태를 기준으로 다음 차이를 만들므로 유실되지 않는 채널로 보낸다.
+    // 보이는 Actor 가 많으면 스냅샷이 커지므로 목록 크기로 빌더를 잡는다.
+    size_t snapshot_bytes = snapshot_positions_.size() * sizeof(PCS::World::SnapshotPosition)
+        + snapshot_rotations_.size() * sizeof(PCS::World::SnapshotRotation)
+        + snapshot_velocities_.size() * sizeof(PCS::World::SnapshotVelocity);
+    flatbuffers::FlatBufferBuilder fbb(BuilderSize(snapshot_bytes), &PooledBuilderAllocator::Instance());
+    auto snapshot = PCS::World::CreateMoveSnapshot(fbb,
+        snapshot_positions_.empty() ? 0 : fbb.CreateVectorOfStructs(snapshot_positions_),
+        snapshot_rotations_.empty() ? 0 : fbb.CreateVectorOfStructs(snapshot_rotations_),
+        snapshot_velocities_.empty() ? 0 : fbb.CreateVectorOfStructs(snapshot_velocities_));
+    auto notify = PCS::World::CreateNotify_Update(fbb, 0, PCS::World::UpdateType::MoveSnapshot, snapshot.Union());
+    PCS::Send(*rc_, fbb, notify);
+}
\ No newline at end of file
@@ -1,8 +1,8 @@
 #pragma once
 #include "InterestArea.h"
 #include "protocol_cs_helper.h"
+#include "TypeDef.h"
 
-using namespace boost;
 namespace PCS = ProtocolCS;
 
 class RemoteClient;
@@ -13,20 +13,72 @@ public:
     ClientInterestArea(RemoteClient* rc, GridType* grid);
     ~ClientInterestArea();
 
+    // 거리별 이동 갱신 주기. 반경 순서로 정렬되어 있어야 한다. 비어 있으면 매번 보낸다.
+    // 이동이 아닌 갱신(데미지, 사망 등)은 거리와 관계없이 바로 보낸다.
+    void ReplicationTiers(const std::vector<ReplicationTier>& tiers) { tiers_ = tiers; }
+    // true 이면 이동을 MoveSnapshot 으로 모아서 보낸다.
+    // Actor 마다 마지막으로 보낸 양자화 상태를 기억하고 바뀐 필드만 보낸다. 보이는 Actor 가 없을때 바꿔야 한다.
+    void SnapshotReplication(bool enable) { snapshot_ = enable; }
+
 protected:
-    //   Cell ö
-    virtual void OnCellEnter(CellType* cell) override;
-    //   Cell 
-    virtual void OnCellExit(CellType* cell) override;
+    // 관심 지역에 Cell이 들어올때
+    virtual void OnCellEnter(CellObserver& observer) override;
 
-    //   Actor ö
+    // 관심 지역에 Actor가 들어올때
     virtual void OnActorEnter(Actor* actor) override;
-    //   Actor 
+    // 관심 지역에 Actor가 나갈때
     virtual void OnActorExit(Actor* actor) override;
+    // 틱마다 주기가 된 이동 갱신을 보낸다.
+    virtual void OnVisibilityUpdated() override;
 
-    void OnActorUpdate(PCS::World::Notify_UpdateT* message);
+    void OnActorUpdate(const Ptr<net::SendBuffer>& message, const Actor* actor, bool latest_only);
 
 private:
+    // MoveSnapshot 으로 보내는 양자화된 이동 상태
+    struct SnapshotState
+    {
+        uint16_t x, y, z;
+        uint16_t rotation;
+        int16_t velocity_x, velocity_y, velocity_z;
+    };
+
+    // 보이는 Actor 마다 이동 갱신을 보낸 틱과 아직 보내지 않은 마지막 이동 갱신.
+    // 스냅샷 모드에서는 메시지 대신 dirty 를 표시하고 클라이언트가 가진 상태(sent)와 비교해서 보낸다.
+    struct Replication
+    {
+        const Actor* actor;
+        uint32_t last_sent_tick;
+        Ptr<net::SendBuffer> pending;
+        uint16_t net_id;
+        bool dirty;
+        SnapshotState sent;
+    };
+
+    static bool ReplicationLess(const Replication& replication, const Actor* actor);
+    // actor 와의 거리에 해당하는 주기(틱)
+    uint32_t ReplicationInterval(const Actor* actor) const;
+    void SendMove(const Ptr<net::SendBuffer>& message, const Actor* actor);
+
+    // 0 이면 남은 번호가 없다. 그 Actor 는 MoveActionInfo 로 보낸다.
+    uint16_t AllocateNetId();
+    void FreeNetId(uint16_t net_id);
+    SnapshotState Quantize(const Actor* actor) const;
+    // 주기가 된 dirty Actor 의 바뀐 필드를 모아서 하나의 메시지로 보낸다.
+    void SendSnapshot();
+
     RemoteClient* rc_;
-    std::map<CellType*, signals2::connection> update_connections_;
+    std::vector<ReplicationTier> tiers_;
+    // actor 주소 순서로 정렬되어 있다.
+    std::vector<Replication> replications_;
+    size_t pending_count_ = 0;
+    uint32_t tick_ = 0;
+
+    bool snapshot_ = false;
+    size_t dirty_count_ = 0;
+    uint16_t next_net_id_ = 1;
+    std::vector<uint16_t> free_net_ids_;
+    // 스냅샷을 만들때 재사용하는 버퍼.
+    std::vector<PCS::World::SnapshotPosition> snapshot_positions_;
+    std::vector<PCS::World::SnapshotRotation> snapshot_rotations_;
+    std::vector<PCS::World::SnapshotVelocity> snapshot_velocities_;
 };
@@ -6,10 +6,10 @@
 namespace fb = flatbuffers;
 namespace PCS = ProtocolCS;
 
-// DB ̺ 
+// DB 테이블을 정의
 namespace db_schema {
 
-//  
+// 계정 정보
 class Account
 {
 public:
@@ -66,7 +66,7 @@ public:
 	}
 };
 
-// 
+// 맵정보
 class Map
 {
 public:
@@ -77,7 +77,7 @@ public:
 	MapType	    type;
 };
 
-//  Ա
+// 맵 출입구
 class MapGate
 {
 public:
@@ -87,7 +87,7 @@ public:
     int dest_uid;
 };
 
-//  ɷġ
+// 영웅 능력치
 class HeroAttribute
 {
 public:
@@ -99,7 +99,7 @@ public:
 	int       def;
 };
 
-//  
+// 영웅 정보
 class Hero
 {
 public:
@@ -123,7 +123,7 @@ public:
     static Ptr<Hero> Create(Ptr<MySQLPool> db, int account_uid, const std::string& name, ClassType class_type, int level)
 	{
         ConnectionPtr conn = db->GetConnection();
-        //  ν
+        // 저장 프로시져
         PstmtPtr pstmt(conn->prepareStatement("CALL create_hero(?,?,?,?,@pop)"));
         pstmt->setInt(1, account_uid);
         pstmt->setString(2, name.c_str());
@@ -299,7 +299,7 @@ private:
 	}
 };
 
-//  
+// 몬스터 정보
 class Monster
 {
 public:
@@ -313,7 +313,7 @@ public:
     int            def;
 };
 
-//   
+// 몬스터 스폰 정보
 class MonsterSpawn
 {
 public:
@@ -324,7 +324,7 @@ public:
     duration interval_s;
 };
 
-// ų 
+// 스킬 정보
 class Skill
 {
 public:
@@ -340,7 +340,7 @@ public:
     int           damage;
 };
 
-//  Ȱ  
+// 영웅 부활 지점 정보
 class HeroSpawn
 {
 public:
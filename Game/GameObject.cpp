@@ -3,6 +3,7 @@
 
 GameObject::GameObject(const uuid& entity_id)
 	: entity_id_(entity_id)
+	, velocity_(Vector3::Zero)
 {
 }
 
@@ -34,3 +35,13 @@ float GameObject::GetRotation() const
 {
 	return rotation_;
 }
+
+void GameObject::SetVelocity(const Vector3 & velocity)
+{
+	velocity_ = velocity;
+}
+
+const Vector3 & GameObject::GetVelocity() const
+{
+	return velocity_;
+}
\ No newline at end of file
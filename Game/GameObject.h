@@ -17,9 +17,13 @@ public:
 	const Vector3& GetPosition() const;
 	void SetRotation(float rotation);
 	float GetRotation() const;
+	// 마지막 이동의 초당 속도
+	void SetVelocity(const Vector3& velocity);
+	const Vector3& GetVelocity() const;
 
 private:
 	uuid entity_id_;
 	Vector3 position_;
 	float rotation_;
+	Vector3 velocity_;
 };
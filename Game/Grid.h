@@ -1,124 +1,191 @@
 #pragma once
 #include <cmath>
 #include <algorithm>
+#include <memory>
 #include <vector>
 #include "BoundingBox.h"
 
+// 2D 그리드의 셀. 좌표는 X, Z 평면의 타일 번호.
 class BasicCell
 {
 public:
-    BasicCell(int x, int y, int z)
-        : x_(x), y_(y), z_(z) {}
+    BasicCell(int x, int z)
+        : x_(x), z_(z) {}
     virtual ~BasicCell() {}
 
-    int X() { return x_; }
-    int Y() { return y_; }
-    int Z() { return z_; }
+    int X() const { return x_; }
+    int Z() const { return z_; }
 
 private:
     int x_;
-    int y_;
     int z_;
 };
 
+// 중심 셀에서 시야 거리 안에 들어올수 있는 셀들의 상대 좌표.
+// (dz, dx) 순서로 정렬되어 있어서 순서대로 방문하면 셀이 그리드의 메모리 순서로 나온다.
+class GridStencil
+{
+public:
+    struct Offset
+    {
+        int dx;
+        int dz;
+    };
+
+    GridStencil(int radius_x, int radius_z)
+        : radius_x_(radius_x), radius_z_(radius_z)
+    {
+        offsets_.reserve((2 * radius_x + 1) * (2 * radius_z + 1));
+        for (int dz = -radius_z; dz <= radius_z; dz++)
+        {
+            for (int dx = -radius_x; dx <= radius_x; dx++)
+            {
+                offsets_.push_back({ dx, dz });
+            }
+        }
+    }
+
+    int RadiusX() const { return radius_x_; }
+    int RadiusZ() const { return radius_z_; }
+    const std::vector<Offset>& Offsets() const { return offsets_; }
+
+private:
+    int radius_x_;
+    int radius_z_;
+    std::vector<Offset> offsets_;
+};
+
+// X, Z 평면의 2D 그리드. 셀은 Z 행 우선으로 하나의 배열에 있다.
+// 높이(Y)는 셀을 나누지 않는다.
+// 조회 함수는 할당하지 않으며 셀의 주소는 그리드가 없어질때까지 유지된다.
 template <typename T = BasicCell>
 class Grid
 {
 public:
-	using CellType = T;
+    using CellType = T;
 
-	Grid(BoundingBox area, Vector3 tileDimensions)
-		: area_(area), tileDimensions_(tileDimensions)
-	{
-		tile_x_ = (int)std::ceil(area_.Size().X / (double)tileDimensions_.X);
-		tile_y_ = (int)std::ceil(area_.Size().Y / (double)tileDimensions_.Y);
-        tile_z_ = (int)std::ceil(area_.Size().Z / (double)tileDimensions_.Z);
+    Grid(BoundingBox area, Vector3 tileDimensions)
+        : area_(area), tileDimensions_(tileDimensions)
+    {
+        tile_x_ = std::max((int)std::ceil(area_.Size().X / (double)tileDimensions_.X), 1);
+        tile_z_ = std::max((int)std::ceil(area_.Size().Z / (double)tileDimensions_.Z), 1);
 
-        for (int x = 0; x < tile_x_; x++)
+        // 셀이 자기 주소를 구독에 사용하므로 재할당 없이 제자리에 만든다.
+        cells_.reserve(tile_x_ * tile_z_);
+        for (int z = 0; z < tile_z_; z++)
         {
-            cells_.emplace_back(std::vector<std::vector<CellType>>());
-            for (int y = 0; y < tile_y_; y++)
+            for (int x = 0; x < tile_x_; x++)
             {
-                cells_[x].emplace_back(std::vector<CellType>());
-                for (int z = 0; z < tile_z_; z++)
-                {
-                    cells_[x][y].emplace_back(CellType(x, y, z));
-                }
+                cells_.emplace_back(x, z);
             }
         }
-	}
-	virtual ~Grid() {}
+    }
+    virtual ~Grid() {}
 
     const BoundingBox& Area() const { return area_; }
     const Vector3& TileDimensions() const { return tileDimensions_; }
     int TileX() const { return tile_x_; }
-    int TileY() const { return tile_y_; }
     int TileZ() const { return tile_z_; }
 
-	CellType* GetCell(int tile_x, int tile_y, int tile_z)
-	{
+    CellType* GetCell(int tile_x, int tile_z)
+    {
         if (tile_x >= 0 && tile_x < tile_x_ &&
-            tile_y >= 0 && tile_y < tile_y_ &&
             tile_z >= 0 && tile_z < tile_z_)
         {
-            return &(cells_[tile_x][tile_y][tile_z]);
+            return &cells_[tile_z * tile_x_ + tile_x];
         }
         else
         {
             return nullptr;
         }
-	}
-	
-	CellType* GetCell(const Vector3& position)
-	{
+    }
+
+    // 존 밖의 좌표는 nullptr.
+    CellType* GetCell(const Vector3& position)
+    {
         Vector3 p = position - area_.min;
         if (p.X >= 0 && p.X < area_.Size().X &&
-            p.Y >= 0 && p.Y < area_.Size().Y &&
             p.Z >= 0 && p.Z < area_.Size().Z)
         {
-            return GetCell((int)(p.X / tileDimensions_.X), (int)(p.Y / tileDimensions_.Y), (int)(p.Z / tileDimensions_.Z));
+            return GetCell((int)(p.X / tileDimensions_.X), (int)(p.Z / tileDimensions_.Z));
         }
         else
         {
             return nullptr;
         }
-	}
+    }
 
-	std::vector<CellType*> GetCells(const BoundingBox& area)
-	{
+    // 가장 가까운 셀. 존 밖의 좌표는 가장자리 셀이 된다.
+    CellType* GetNearestCell(const Vector3& position)
+    {
+        Vector3 p = position - area_.min;
+        int x = std::min(std::max((int)std::floor(p.X / tileDimensions_.X), 0), tile_x_ - 1);
+        int z = std::min(std::max((int)std::floor(p.Z / tileDimensions_.Z), 0), tile_z_ - 1);
+        return &cells_[z * tile_x_ + x];
+    }
+
+    // view_distance 의 스텐실. 같은 시야 거리는 같은 객체를 리턴한다.
+    const GridStencil& GetStencil(const Vector3& view_distance)
+    {
+        int radius_x = std::max((int)std::ceil(view_distance.X / tileDimensions_.X), 0);
+        int radius_z = std::max((int)std::ceil(view_distance.Z / tileDimensions_.Z), 0);
+        for (auto& stencil : stencils_)
+        {
+            if (stencil->RadiusX() == radius_x && stencil->RadiusZ() == radius_z)
+                return *stencil;
+        }
+        stencils_.emplace_back(std::make_unique<GridStencil>(radius_x, radius_z));
+        return *stencils_.back();
+    }
+
+    // center 주변의 stencil 셀마다 fn(CellType*) 을 그리드의 메모리 순서로 호출한다.
+    template <typename Fn>
+    void ForEachCell(const CellType* center, const GridStencil& stencil, Fn&& fn)
+    {
+        if (center == nullptr)
+            return;
+
+        for (const auto& offset : stencil.Offsets())
+        {
+            int x = center->X() + offset.dx;
+            int z = center->Z() + offset.dz;
+            if (x >= 0 && x < tile_x_ && z >= 0 && z < tile_z_)
+            {
+                fn(&cells_[z * tile_x_ + x]);
+            }
+        }
+    }
+
+    // area 와 겹치는 셀마다 fn(CellType*) 을 그리드의 메모리 순서로 호출한다.
+    template <typename Fn>
+    void ForEachCell(const BoundingBox& area, Fn&& fn)
+    {
         BoundingBox overlap = area_.IntersectWith(area);
         auto min = overlap.min - area_.min;
         auto max = overlap.max - area_.min;
-        
-        // Ÿ ǥ ȯ
+
+        // 타일 좌표로 변환
         int x0 = std::max((int)(min.X / tileDimensions_.X), 0);
         int x1 = std::min((int)std::ceil(max.X / tileDimensions_.X), tile_x_);
 
-        int y0 = std::max((int)(min.Y / tileDimensions_.Y), 0);
-        int y1 = std::min((int)std::ceil(max.Y / tileDimensions_.Y), tile_y_);
-
         int z0 = std::max((int)(min.Z / tileDimensions_.Z), 0);
         int z1 = std::min((int)std::ceil(max.Z / tileDimensions_.Z), tile_z_);
 
-        std::vector<CellType*> result;
-        for (int x = x0; x < x1; x++)
+        for (int z = z0; z < z1; z++)
         {
-            for (int y = y0; y < y1; y++)
+            CellType* row = &cells_[z * tile_x_];
+            for (int x = x0; x < x1; x++)
             {
-                for (int z = z0; z < z1; z++)
-                {
-                    result.push_back(&(cells_[x][y][z]));
-                }
+                fn(&row[x]);
             }
         }
-		return std::move(result);
-	}
+    }
 
 private:
-    std::vector<std::vector<std::vector<CellType>>> cells_;
+    std::vector<CellType> cells_;
+    std::vector<std::unique_ptr<GridStencil>> stencils_;
     BoundingBox area_;
     Vector3 tileDimensions_;
-	int tile_x_;
-	int tile_y_;
+    int tile_x_;
     int tile_z_;
 };
\ No newline at end of file
@@ -36,17 +36,18 @@ void Hero::ActionMove(const Vector3 & position, float rotation, const Vector3 &
         return;
 
     Vector3 pos(position);
-    pos.Y = 0.0f; // Y 0
+    pos.Y = 0.0f; // Y는 0
 
-    // ִ ӵ  ϼ . 
+    // 최대 속도보다 빠르게 움직일수 없다. 
     //if (distance(GetPosition(), position) > HERO_MOVE_SPEED * delta_time)
     //    return;
     if (GetZone() == nullptr) return;
-    //   üũ
+    // 맵 경계 체크
     pos = GetZone()->CheckBoader(position);
    
     SetRotation(rotation);
     SetPosition(pos);
+    SetVelocity(velocity);
     UpdateInterest();
 
     PCS::World::MoveActionInfoT move_info;
@@ -58,7 +59,7 @@ void Hero::ActionMove(const Vector3 & position, float rotation, const Vector3 &
     PCS::World::Notify_UpdateT update_msg;
     update_msg.entity_id = uuids::to_string(GetEntityID());
     update_msg.update_data.Set(std::move(move_info));
-    // 
+    // 통지
     PublishActorUpdate(&update_msg);
 }
 
@@ -67,16 +68,16 @@ void Hero::ActionSkill(int skill_id, float rotation, const std::vector<uuid>& ta
     if (IsDead())
         return;
 
-    // ų   ˻
+    // 스킬 사용 조건 검사
     auto* skill = SkillTable::GetInstance().Get(skill_id);
     if (!(skill && skill->class_type == HeroClassType() && skill->cost <= Mp()))
         return;
     
-    // mp Һ
+    // mp 소비
     Mp(Mp() - skill->cost);
     SetRotation(rotation);
 
-    //  ޽
+    // 통지 메시지
     PCS::World::SkillActionInfoT skill_info;
     skill_info.skill_id = skill_id;
     for (auto& e : targets)
@@ -88,12 +89,12 @@ void Hero::ActionSkill(int skill_id, float rotation, const std::vector<uuid>& ta
     PCS::World::Notify_UpdateT update_msg;
     update_msg.entity_id = uuids::to_string(GetEntityID());
     update_msg.update_data.Set(std::move(skill_info));
-    // 
+    // 통지
     PublishActorUpdate(&update_msg);
 
     Zone* zone = GetZone();
     if (zone == nullptr) return;
-    // target ãƼ  ش.
+    // target을 찾아서 데미지를 준다.
     for (auto& entity_id : targets)
     {
         auto actor = zone->FindActor(entity_id);
@@ -113,13 +114,13 @@ void Hero::TakeDamage(const uuid& attacker, int damage)
     if (IsDead())
         return;
 
-    //  ŭ  
+    // 방어도 만큼 데미지 감소
     damage = std::max(1, damage - Def());
     Hp(Hp() - damage);
 
     BOOST_LOG_TRIVIAL(info) << "Hero uid:" << Uid() << " Take damage. Amount:" << damage;
 
-    //  
+    // 데미지를 통지
     PCS::World::DamageInfoT data;
     //data.entity_id = uuids::to_string(GetEntityID());
     data.damage = damage;
@@ -194,7 +195,7 @@ inline void Hero::Update(double delta_time)
 {
     if (!IsDead())
     {
-        // Hp Mp 
+        // Hp Mp 재생
         if (clock_type::now() >= restor_time_)
         {
             int prev_hp = Hp();
@@ -205,7 +206,7 @@ inline void Hero::Update(double delta_time)
 
             if (prev_hp != Hp() || prev_mp != Mp())
             {
-                // ޽ 
+                // 메시지 통지
                 PCS::World::AttributeInfoT data;
                 //data.entity_id = uuids::to_string(GetEntityID());
                 data.max_hp = MaxHp();
@@ -252,7 +253,7 @@ void Hero::Die()
         
     BOOST_LOG_TRIVIAL(info) << "Hero uid:" << Uid() <<" Die";
 
-    //  
+    // 죽음을 통지
     PCS::World::StateInfoT data;
     //data.entity_id = uuids::to_string(GetEntityID());
     data.state = PCS::World::StateType::Dead;
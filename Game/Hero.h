@@ -10,7 +10,7 @@ namespace PCS = ProtocolCS;
 
 constexpr float HERO_MOVE_SPEED = 3.0f;
 
-// ÷̾  ĳ
+// 플레이어 게임 캐릭터
 class Hero : public Actor, public ILivingEntity
 {
 public:
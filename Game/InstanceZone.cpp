@@ -23,7 +23,7 @@ void InstanceZone::Enter(const Ptr<Actor>& actor, const Vector3 & position)
     {
         hero->instance_zone_ = std::make_tuple(EntityId(), MapId());
     }
-    // δ ÷̾   Ÿ̸ 
+    // 인던에 플레이어가 들어오면 삭제 타이머 취소
     if (heroes_.size() != 0 && destroy_timer_)
     {
         destroy_timer_->cancel();
@@ -34,7 +34,7 @@ void InstanceZone::Enter(const Ptr<Actor>& actor, const Vector3 & position)
 void InstanceZone::Exit(const Ptr<Actor>& actor)
 {
     Zone::Exit(actor);
-    // δ  ÷̾  10 
+    // 인던에 모든 플레이어가 나가면 10초후 삭제
     if (heroes_.size() == 0 && !destroy_timer_)
     {
         destroy_timer_ = GetWorld()->RunAfter(10s, [this](auto& timer) { 
@@ -1,9 +1,9 @@
 #pragma once
 #include "Zone.h"
 
-// νϽ .
-//  .
-//  ÷̾  ˾Ƽ ȴ.
+// 인스턴스 존.
+// 동적으로 생성됨.
+// 모든 플레이어가 나가면 알아서 삭제된다.
 class InstanceZone : public Zone
 {
 public:
@@ -1,84 +1,186 @@
 #include "stdafx.h"
 #include "InterestArea.h"
 #include "Zone.h"
+#include "Actor.h"
+
+namespace {
+
+// 정렬된 a 에만 있는 원소마다 fn 을 호출한다.
+template <typename T, typename Fn>
+void ForEachDifference(const std::vector<T*>& a, const std::vector<T*>& b, Fn&& fn)
+{
+    auto iter = b.begin();
+    for (T* value : a)
+    {
+        while (iter != b.end() && *iter < value)
+            ++iter;
+        if (iter == b.end() || *iter != value)
+            fn(value);
+    }
+}
+
+} // namespace
 
 InterestArea::InterestArea(GridType * grid)
     : grid_(grid)
 {
+    zone_update_observer_.Bind<InterestArea, &InterestArea::UpdateVisibility>(this);
+    grid_->interest_area_update_observers.Subscribe(zone_update_observer_);
 }
 
 InterestArea::~InterestArea()
 {
-    //  
-    for (auto& e : connections_)
-    {
-        e.second.disconnect();
-    }
+    // 노드가 없어질때 구독이 해제된다.
 }
 
 void InterestArea::UpdateInterest()
 {
-    //    ´.
-    BoundingBox focus(Position() - ViewDistance(), Position() + ViewDistance());
-    std::vector<CellType*> new_cells = grid_->GetCells(focus);
-    std::sort(new_cells.begin(), new_cells.end());
-    if (new_cells == cells_)
+    // 중심 셀이 같으면 관심 영역의 구역도 같다.
+    CellType* center = grid_->GetNearestCell(Position());
+    const GridStencil* stencil = &grid_->GetStencil(Vector3(LeaveRadius(), 0.0f, LeaveRadius()));
+    if (center == center_ && stencil == stencil_)
         return;
 
-    std::vector<CellType*> result;
-    // ο  ϱ
-    std::set_difference(new_cells.begin(), new_cells.end(), cells_.begin(), cells_.end(), std::back_inserter(result));
-        
-    for (CellType* cell : result)
+    center_ = center;
+    stencil_ = stencil;
+    changed_ = true;
+
+    // 관심 영역의 구역을 얻어온다. 스텐실 순서가 셀 주소 순서이므로 정렬되어 있다.
+    next_cells_.clear();
+    grid_->ForEachCell(center, *stencil, [this](CellType* cell) { next_cells_.push_back(cell); });
+
+    // 새로운 구역
+    ForEachDifference(next_cells_, cells_, [this](CellType* cell)
     {
-        //     
-        OnCellEnter(cell);
-        // interest area  cell   ˸.
-        cell->interest_area_enter_signal(this);
-    }
+        // 새 구역을 구독 및 등록
+        std::unique_ptr<CellObserver> observer;
+        if (free_cell_observers_.empty())
+        {
+            observer = std::make_unique<CellObserver>();
+            observer->actor_cell_change.Bind<InterestArea, &InterestArea::OnActorCellChange>(this);
+        }
+        else
+        {
+            observer = std::move(free_cell_observers_.back());
+            free_cell_observers_.pop_back();
+        }
+        observer->cell = cell;
+        OnCellEnter(*observer);
+        cell_observers_.emplace_back(std::move(observer));
+    });
 
-    result.clear();
-    //   ϱ
-    std::set_difference(cells_.begin(), cells_.end(), new_cells.begin(), new_cells.end(), std::back_inserter(result));
-    for (CellType* cell : result)
+    // 나간 구역
+    ForEachDifference(cells_, next_cells_, [this](CellType* cell)
     {
-        //      
-        OnCellExit(cell);
-        // interest area  cell   ˸.
-        cell->interest_area_exit_signal(this);
-    }
+        // 나간 구역 구독 해제 및 삭제
+        auto iter = std::find_if(cell_observers_.begin(), cell_observers_.end(),
+            [cell](const std::unique_ptr<CellObserver>& observer) { return observer->cell == cell; });
+        if (iter != cell_observers_.end())
+        {
+            CellObserver& observer = **iter;
+            OnCellExit(observer);
+            observer.actor_cell_change.Unsubscribe();
+            observer.actor_update.Unsubscribe();
+            observer.cell = nullptr;
+            free_cell_observers_.emplace_back(std::move(*iter));
+            *iter = std::move(cell_observers_.back());
+            cell_observers_.pop_back();
+        }
+        // 스텐실이 leave_radius 를 덮으므로 나간 구역의 Actor 는 모두 시야 밖이다.
+        for (Actor* actor : cell->Actors())
+        {
+            if (IsVisible(actor))
+                RemoveVisible(actor);
+        }
+    });
 
-    cells_.swap(new_cells);
+    cells_.swap(next_cells_);
 }
 
-void InterestArea::OnCellEnter(CellType * cell)
+void InterestArea::OnCellEnter(CellObserver & observer)
 {
-    //     
-    signals2::connection conn = cell->actor_cell_change_signal.connect(std::bind(&InterestArea::OnActorCellChange, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
-    connections_.emplace(cell, std::move(conn));
+    // 새 구역을 구독
+    observer.cell->actor_cell_change_observers.Subscribe(observer.actor_cell_change);
 }
 
-void InterestArea::OnCellExit(CellType * cell)
+void InterestArea::OnCellExit(CellObserver & /*observer*/)
 {
-    //      
-    auto iter = connections_.find(cell);
-    if (iter != connections_.end())
-    {
-        iter->second.disconnect();
-        connections_.erase(iter);
-    }
 }
 
-void InterestArea::OnActorCellChange(CellType * exit, CellType * enter, Actor * actor)
+bool InterestArea::IsVisible(const Actor * actor) const
+{
+    return std::binary_search(visible_.begin(), visible_.end(), actor, std::less<const Actor*>());
+}
+
+void InterestArea::UpdateVisibility()
 {
-    auto iter1 = std::find(cells_.begin(), cells_.end(), exit);
-    auto iter2 = std::find(cells_.begin(), cells_.end(), enter);
-    if (iter1 != cells_.end() && iter2 == cells_.end())
+    // 관심 지역도 관심 구역의 Actor 도 그대로면 보이는 목록도 같다.
+    uint64_t cells_version = 0;
+    for (CellType* cell : cells_)
     {
-        OnActorExit(actor);
+        cells_version += cell->Version();
     }
-    else if (iter1 == cells_.end() && iter2 != cells_.end())
+    if (!changed_ && cells_version == cells_version_)
+    {
+        OnVisibilityUpdated();
+        return;
+    }
+    changed_ = false;
+    cells_version_ = cells_version;
+
+    // 관심 구역의 Actor 중에서 보이는 Actor 를 고른다.
+    const float enter_radius_sq = EnterRadius() * EnterRadius();
+    const float leave_radius_sq = LeaveRadius() * LeaveRadius();
+
+    next_visible_.clear();
+    for (CellType* cell : cells_)
+    {
+        for (Actor* actor : cell->Actors())
+        {
+            float distance_sq = DistanceSquaredXZ(actor->GetPosition(), Position());
+            if (distance_sq <= enter_radius_sq ||
+                (distance_sq <= leave_radius_sq && IsVisible(actor)))
+            {
+                next_visible_.push_back(actor);
+            }
+        }
+    }
+    std::sort(next_visible_.begin(), next_visible_.end());
+
+    // 알리는 동안 IsVisible 이 새 목록을 보도록 먼저 교체한다.
+    visible_.swap(next_visible_);
+
+    // 나간 Actor
+    ForEachDifference(next_visible_, visible_, [this](Actor* actor)
+    {
+        OnActorExit(actor);
+    });
+
+    // 들어온 Actor
+    ForEachDifference(visible_, next_visible_, [this](Actor* actor)
     {
         OnActorEnter(actor);
+    });
+
+    OnVisibilityUpdated();
+}
+
+void InterestArea::OnActorCellChange(CellType * /*exit*/, CellType * enter, Actor * actor)
+{
+    // 구독중인 셀 안에서의 이동은 틱에서 처리한다.
+    bool in_enter = enter != nullptr && std::binary_search(cells_.begin(), cells_.end(), enter);
+    if (!in_enter && IsVisible(actor))
+    {
+        RemoveVisible(actor);
     }
 }
+
+void InterestArea::RemoveVisible(Actor * actor)
+{
+    auto iter = std::lower_bound(visible_.begin(), visible_.end(), actor);
+    if (iter == visible_.end() || *iter != actor)
+        return;
+
+    visible_.erase(iter);
+    OnActorExit(actor);
+}
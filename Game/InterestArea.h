@@ -1,15 +1,18 @@
 #pragma once
+#include <algorithm>
 #include <unordered_set>
-#include <boost/signals2.hpp>
 #include "Common.h"
-
-using namespace boost;
+#include "ZoneCell.h"
 
 class Actor;
 class Zone;
-class ZoneCell;
+class GridStencil;
 
-//  
+// 관심 지역
+// 보이는 Actor 를 Actor 단위로 관리한다. 그리드는 후보를 찾는데만 사용한다.
+// enter_radius 안에 들어온 Actor 가 보이기 시작하고 leave_radius 밖으로 나가야 안보이므로
+// 경계에 서 있어도 나타남/사라짐을 반복하지 않는다.
+// 보이는 목록은 존의 틱마다 한번 갱신하고 나간 Actor, 들어온 Actor 순서로 알린다.
 class InterestArea
 {
 public:
@@ -17,38 +20,90 @@ public:
     using CellType = ZoneCell;
 
     InterestArea(GridType* grid);
-    ~InterestArea();
+    virtual ~InterestArea();
 
-    //   ǥ
+    // 관심 지역의 좌표
     const Vector3& Position() const { return position_; }
-    void Position(const Vector3& value) { position_ = value; }
-    //   Ÿ
-    const Vector3& ViewDistance() const { return view_distance_; }
-    const void ViewDistance(const Vector3& value) { view_distance_ = value; }
+    void Position(const Vector3& value) { position_ = value; changed_ = true; }
+    // 시야 반경. X, Z 평면의 거리.
+    float EnterRadius() const { return enter_radius_; }
+    float LeaveRadius() const { return leave_radius_; }
+    void ViewRadius(float enter_radius, float leave_radius)
+    {
+        enter_radius_ = enter_radius;
+        leave_radius_ = std::max(enter_radius, leave_radius);
+        changed_ = true;
+    }
 
-    //   
+    // 위치나 시야 반경이 바뀌면 호출. 구독할 셀을 갱신한다.
     void UpdateInterest();
 
-    //   Actor ö
+    // 지금 보이는 Actor 인지
+    bool IsVisible(const Actor* actor) const;
+
+protected:
+    GridType* Grid() const { return grid_; }
+
+    // X, Z 평면의 거리의 제곱. 시야와 같은 기준으로 거리를 잰다.
+    static float DistanceSquaredXZ(const Vector3& a, const Vector3& b)
+    {
+        float dx = a.X - b.X;
+        float dz = a.Z - b.Z;
+        return dx * dx + dz * dz;
+    }
+
+    // 관심 지역에 Actor가 들어올때
     virtual void OnActorEnter(Actor*) {}
-    //   Actor 
+    // 관심 지역에 Actor가 나갈때
     virtual void OnActorExit(Actor*) {}
+    // 존의 틱마다 보이는 목록을 갱신하고 알린 뒤에
+    virtual void OnVisibilityUpdated() {}
 
-protected:
-    //   Cell ö
-    virtual void OnCellEnter(CellType* cell);
-    //   Cell 
-    virtual void OnCellExit(CellType* cell);
+    // 관심 지역의 Cell 마다 하나씩 있는 관찰자 노드. 셀의 관찰자 목록에 연결한다.
+    // 관심 지역에서 재사용하므로 셀을 구독하거나 해제할때 할당하지 않는다.
+    struct CellObserver
+    {
+        CellType* cell = nullptr;
+        CellType::ActorCellChangeList::Observer actor_cell_change;
+        CellType::ActorUpdateList::Observer actor_update;
+    };
+
+    // 관심 지역에 Cell이 들어올때
+    virtual void OnCellEnter(CellObserver& observer);
+    // 관심 지역에 Cell이 나갈때. 리턴하면 노드의 구독이 모두 해제된다.
+    virtual void OnCellExit(CellObserver& observer);
 
 private:
-    // Actor  Cell ų 
+    // 존의 틱마다 보이는 목록을 갱신한다.
+    void UpdateVisibility();
+    // Actor가 관심 Cell에 들어오거나 나갈때
     void OnActorCellChange(CellType* exit, CellType* enter, Actor* actor);
+    // 틱을 기다리지 않고 목록에서 뺀다. 구독하지 않는 셀로 간 Actor 는 없어져도 알수 없기 때문이다.
+    void RemoveVisible(Actor* actor);
 
     GridType* grid_;
-    // Cells in the area
+    ObserverList<>::Observer zone_update_observer_;
+    // 관심 지역의 중심 셀과 leave_radius 의 스텐실. 둘다 같으면 셀 목록도 같다.
+    CellType* center_ = nullptr;
+    const GridStencil* stencil_ = nullptr;
+    // Cells in the area. 주소 순서로 정렬되어 있다.
     std::vector<CellType*> cells_;
-    std::map<CellType*, signals2::connection> connections_;
+    // 새 셀 목록을 만들때 재사용하는 버퍼.
+    std::vector<CellType*> next_cells_;
+    // 구독중인 셀의 노드와 재사용할 노드. 노드의 주소는 바뀌지 않는다.
+    std::vector<std::unique_ptr<CellObserver>> cell_observers_;
+    std::vector<std::unique_ptr<CellObserver>> free_cell_observers_;
+    // 보이는 Actor. 주소 순서로 정렬되어 있다.
+    std::vector<Actor*> visible_;
+    // 새 목록을 만들때 재사용하는 버퍼.
+    std::vector<Actor*> next_visible_;
+
+    // 지난 갱신 이후 위치, 시야 반경, 셀 목록이 바뀌었는지와 그때 셀들의 Version 합.
+    // 셀의 Version 은 늘어나기만 하므로 합이 같으면 셀의 Actor 도 그대로다.
+    bool changed_ = true;
+    uint64_t cells_version_ = 0;
 
     Vector3 position_;
-    Vector3 view_distance_;
+    float enter_radius_ = 0.0f;
+    float leave_radius_ = 0.0f;
 };
\ No newline at end of file
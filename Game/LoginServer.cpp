@@ -13,6 +13,13 @@ namespace db = db_schema;
 namespace PSS = ProtocolSS;
 namespace PCS = ProtocolCS;
 
+namespace {
+
+// Hero 하나가 목록에 차지하는 크기. 이름을 뺀 테이블과 목록의 offset.
+constexpr size_t HERO_LIST_ENTRY_SIZE = 32;
+
+}
+
 LoginServer::LoginServer()
 {
 }
@@ -29,23 +36,37 @@ void LoginServer::Run()
 	SetName(settings.name);
 
 	// Create io_service loop
-	size_t thread_count = settings.thread_count;
-	ev_loop_ = std::make_shared<net::EventLoop>(thread_count);
+	net::EventLoopConfig ev_loop_config;
+	ev_loop_config.thread_count = settings.thread_count;
+	ev_loop_config.mode = settings.io_context_per_thread ? net::EventLoopMode::ContextPerThread : net::EventLoopMode::Shared;
+	ev_loop_config.spin_time = settings.spin_time;
+	ev_loop_config.cpu_affinity = settings.cpu_affinity;
+	ev_loop_config.thread_name = "login";
+	ev_loop_ = std::make_shared<net::EventLoop>(ev_loop_config);
 	// NetServer Config
 	net::ServerConfig server_config;
 	server_config.event_loop = ev_loop_;
 	server_config.max_session_count = settings.max_session_count;
+	server_config.accept_count = settings.accept_count;
+	server_config.reuse_port = settings.reuse_port;
 	server_config.max_receive_buffer_size = settings.max_receive_buffer_size;
+	server_config.max_send_buffer_size = settings.max_send_buffer_size;
+	server_config.compress_threshold = settings.compress_threshold;
+	server_config.idle_timeout = settings.idle_timeout;
+	server_config.max_frames_per_read = settings.max_frames_per_read;
+	server_config.message_rate_limit = { settings.message_rate, settings.message_burst > 0 ? settings.message_burst : settings.message_rate };
+	server_config.max_rate_violations = settings.max_rate_violations;
+	server_config.stats_log_interval = settings.stats_log_interval;
 	server_config.min_receive_size = settings.min_receive_size;
+	server_config.shared_receive_buffer = settings.shared_receive_buffer;
+	server_config.io_uring = settings.io_uring;
 	server_config.no_delay = settings.no_delay;
+	server_config.session_affinity = (settings.session_affinity == "least-load") ? net::SessionAffinity::LeastLoad : net::SessionAffinity::RoundRobin;
 	// Create NetServer
 	net_server_ = net::NetServer::Create(server_config);
 	net_server_->RegisterSessionOpenedHandler([this](auto& session) { HandleSessionOpened(session); });
 	net_server_->RegisterSessionClosedHandler([this](auto& session, auto reason) { HandleSessionClosed(session, reason); });
-	net_server_->RegisterMessageHandler([this](auto& session, auto* buf, auto bytes) { HandleMessage(session, buf, bytes); });
-
-	// ڵ鷯 
-	RegisterHandlers();
+	net_server_->RegisterMessageHandler([this](auto& session, auto message_type, auto* buf, auto bytes) { HandleMessage(session, message_type, buf, bytes); });
 
 	// Create DB connection Pool
 	db_conn_ = MySQLPool::Create(
@@ -55,29 +76,32 @@ void LoginServer::Run()
 		settings.db_schema,
 		settings.db_connection_pool);
 
-	// ʿ  ε.
+	// 필요한 데이터 로딩.
 	HeroAttributeTable::Load(db_conn_);
 
-	// Frame Update .
+	// Frame Update 시작.
 	strand_ = std::make_shared<strand>(ev_loop_->GetIoContext());
 	update_timer_ = std::make_shared<timer_type>(ev_loop_->GetIoContext());
 	ScheduleNextUpdate(clock_type::now(), TIME_STEP);
 
-	// NetServer  ۽Ų.
+	// NetServer 를 시작시킨다.
 	std::string bind_address = settings.bind_address;
 	uint16_t bind_port = settings.bind_port;
 	net_server_->Start(bind_address, bind_port);
 
-	// Manager   ϴ Ŭ̾Ʈ.
+	// Manager 서버에 연결 하는 클라이언트.
 	net::ClientConfig client_config;
 	client_config.event_loop = ev_loop_;
 	client_config.min_receive_size = settings.min_receive_size;
 	client_config.max_receive_buffer_size = settings.max_receive_buffer_size;
+	client_config.compress_threshold = settings.compress_threshold;
+	client_config.heartbeat_interval = settings.heartbeat_interval;
 	client_config.no_delay = settings.no_delay;
-	manager_client_ = std::make_shared<ManagerClient>(client_config, this, GetName(), ServerType::Login_Server);
-	// Ŭ̾Ʈ  ޽ ڵ鷯 .
+	auto request_timeout = std::chrono::milliseconds(settings.manager_request_timeout);
+	manager_client_ = std::make_shared<ManagerClient>(client_config, settings.manager_connections, request_timeout, this, GetName(), ServerType::Login_Server);
+	// 클라이언트 에 메시지 핸들러 등록.
 	RegisterManagerClientHandlers();
-	// Manager   .
+	// Manager 서버에 연결 시작.
 	manager_client_->Connect(settings.manager_address, settings.manager_port);
 
 	BOOST_LOG_TRIVIAL(info) << "Run " << GetName();
@@ -85,14 +109,14 @@ void LoginServer::Run()
 
 void LoginServer::Stop()
 {
-	//  ۾.
+	// 종료 작업.
 	net_server_->Stop();
 	ev_loop_->Stop();
 
 	BOOST_LOG_TRIVIAL(info) << "Stop " << GetName();
 }
 
-//    
+// 서버가 종료될 때가지 대기
 void LoginServer::Wait()
 {
 	if (ev_loop_)
@@ -146,19 +170,19 @@ void LoginServer::RemoveRemoteClient(const Ptr<RemoteLoginClient>& remote_client
 
 void LoginServer::ProcessRemoteClientDisconnected(const Ptr<RemoteLoginClient>& rc)
 {
-	// Ͽ 
+	// 목록에서 제거
 	RemoveRemoteClient(rc);
 	rc->OnDisconnected();
 
     if (rc->IsAuthenticated() && rc->GetAccount())
     {
-        // Manager  α׾ƿ ˸.
+        // Manager 서버로 로그아웃을 알린다.
         manager_client_->NotifyUserLogout(rc->GetAccount()->uid);
         BOOST_LOG_TRIVIAL(info) << "Logout. account_uid: " << rc->GetAccount()->uid << " user_name: " << rc->GetAccount()->user_name;
     }
 }
 
-//  Ʈ
+// 프레임 업데이트
 inline void LoginServer::DoUpdate(double delta_time)
 {
 }
@@ -180,38 +204,42 @@ void LoginServer::ScheduleNextUpdate(const time_point& now, const duration& time
 
 void LoginServer::NotifyUnauthedAccess(const Ptr<net::Session>& session)
 {
-	fb::FlatBufferBuilder fbb;
+	fb::FlatBufferBuilder fbb(BUILDER_INITIAL_SIZE, &PooledBuilderAllocator::Instance());
 	auto notify = PCS::CreateNotify_UnauthedAccess(fbb);
 	auto root = PCS::CreateMessageRoot(fbb, PCS::MessageType::Notify_UnauthedAccess, notify.Union());
 	FinishMessageRootBuffer(fbb, root);
 
-	session->Send(fbb.GetBufferPointer(), fbb.GetSize());
+	session->Send(MakeSendBuffer(fbb, static_cast<uint16_t>(PCS::MessageType::Notify_UnauthedAccess)));
 }
 
-void LoginServer::HandleMessage(const Ptr<net::Session>& session, const uint8_t* buf, size_t bytes)
+void LoginServer::HandleMessage(const Ptr<net::Session>& session, uint16_t message_type, const uint8_t* buf, size_t bytes)
 {
-	// flatbuffer ޽ ø
-	const auto* message_root = PCS::GetMessageRoot(buf);
-	if (message_root == nullptr)
+	// payload 를 보기 전에 헤더의 타입으로 핸들러를 찾는다. 타입이 없거나(0) 모르는 타입이면 버리고 위반으로 센다.
+	auto handler = message_handlers_.Find(message_type);
+	if (handler == nullptr)
 	{
-		BOOST_LOG_TRIVIAL(info) << "Invalid MessageRoot";
+		BOOST_LOG_TRIVIAL(info) << "Can not find the message handler. header_type : " << message_type;
+		session->RejectMessage(message_type);
 		return;
 	}
 
-	auto message_type = message_root->message_type();
-    //BOOST_LOG_TRIVIAL(info) << "On Recv message_type : " << PCS::EnumNameMessageType(message_type);
-
-	auto iter = message_handlers_.find(message_type);
-	if (iter == message_handlers_.end())
+	// flatbuffer 메시지로 디시리얼라이즈
+	const auto* message_root = PCS::GetMessageRoot(buf);
+	if (message_root == nullptr || message_root->message_type() != static_cast<PCS::MessageType>(message_type))
 	{
-		BOOST_LOG_TRIVIAL(info) << "Can not find the message handler. message_type : " << PCS::EnumNameMessageType(message_type);
+		BOOST_LOG_TRIVIAL(info) << "Invalid MessageRoot. header_type : " << message_type;
+		session->RejectMessage(message_type);
 		return;
 	}
+    //BOOST_LOG_TRIVIAL(info) << "On Recv message_type : " << PCS::EnumNameMessageType(message_root->message_type());
 
 	try
 	{
-		// ޽ ڵ鷯 
-		iter->second(session, message_root);
+		// 메시지 핸들러를 실행
+		if (!handler(*this, session, message_root))
+		{
+			BOOST_LOG_TRIVIAL(info) << "Can not cast message_type : " << PCS::EnumNameMessageType(message_root->message_type());
+		}
 	}
 	catch (sql::SQLException& e)
 	{
@@ -248,7 +276,7 @@ void LoginServer::OnJoin(const Ptr<net::Session>& session, const PCS::Login::Req
 	const char* user_name = message->user_name()->c_str();
 	const char* password = message->password()->c_str();
 
-	// ڿ ˻
+	// 문자열 검사
 	std::regex pattern(R"([^A-Za-z0-9_]+)");
 	std::cmatch m;
 	if (std::regex_search(user_name, m, pattern))
@@ -290,7 +318,7 @@ void LoginServer::OnLogin(const Ptr<net::Session>& session, const PCS::Login::Re
 	const std::string password = message->password()->str();
 
 	auto db_account = db::Account::Get(db_conn_, user_name);
-	//  .
+	// 계정이 없다.
 	if (!db_account)
 	{
 		PCS::Login::Reply_LoginFailedT reply;
@@ -298,7 +326,7 @@ void LoginServer::OnLogin(const Ptr<net::Session>& session, const PCS::Login::Re
 		PCS::Send(*session, reply);
 		return;
 	}
-	//  ٸ.
+	// 비번이 다르다.
 	if (db_account->password != password)
 	{
 		PCS::Login::Reply_LoginFailedT reply;
@@ -307,20 +335,20 @@ void LoginServer::OnLogin(const Ptr<net::Session>& session, const PCS::Login::Re
 		return;
 	}
 
-	// TO DO : л  ߺ α ó?
-	//// ߺ α ó.
+	// TO DO : 분산 서버에서 중복 로그인 처리가?
+	//// 중복 로그인 처리.
 	//if (auto rc = GetRemoteClientByAccountID(db_account->id))
 	//{
 	//	PCS::Login::Reply_LoginFailedT reply;
 	//	reply.error_code = PCS::ErrorCode::LOGIN_DUPLICATION;
 
-	//	// RemoteClient  ش.
+	//	// RemoteClient 접속을 끊어준다.
 	//	rc->Send(reply);
 	//	rc->Disconnect();
-	//	// ó ٷ ش.
+	//	// 종료처리를 바로 해준다.
 	//	ProcessRemoteClientDisconnected(rc);
 
-	//	//   ƴϾ ű ǵ  ش.
+	//	// 같은 세션이 아니었으면 신규 세션도 접속을 끊어준다.
 	//	if (rc->GetSession() != session)
 	//	{
 	//		PCS::Send(session, reply);
@@ -332,15 +360,18 @@ void LoginServer::OnLogin(const Ptr<net::Session>& session, const PCS::Login::Re
 	auto rc = GetRemoteClient(session->GetID());
 	if (!rc)
 	{
-		// RemoteLoginClient   ߰.
+		// RemoteLoginClient 생성 및 추가.
 		rc = std::make_shared<RemoteLoginClient>(session, db_account);
 		AddRemoteClient(session->GetID(), rc);
 	}
 
 	BOOST_LOG_TRIVIAL(info) << "Login. account_uid: " << rc->GetAccount()->uid << " user_name: " << rc->GetAccount()->user_name;
 
-	// Manager  Ű û.
-	manager_client_->RequestGenerateCredential(session->GetID(), db_account->uid);
+	// Manager 서버에 인증키 요청.
+	manager_client_->RequestGenerateCredential(session->GetID(), db_account->uid, [this, session_id = session->GetID()](const PSS::Reply_GenerateCredential* message)
+	{
+		OnReplyGenerateCredential(session_id, message);
+	});
 }
 
 // Create Hero ================================================================================================================
@@ -348,7 +379,7 @@ void LoginServer::OnCreateHero(const Ptr<net::Session>& session, const PCS::Logi
 {
 	if (message == nullptr) return;
 
-	// α üũ
+	// 로그인 체크
 	auto rc = GetAuthedRemoteClient(session->GetID());
 	if (!rc)
 	{
@@ -359,7 +390,7 @@ void LoginServer::OnCreateHero(const Ptr<net::Session>& session, const PCS::Logi
 	const char* name = message->name()->c_str();
 	const ClassType class_type = (ClassType)message->class_type();
 
-	// ڿ ˻
+	// 문자열 검사
 	std::regex pattern(R"([^A-Za-z0-9_]+)");
 	std::cmatch m;
 	if (std::regex_search(name, m, pattern))
@@ -372,19 +403,19 @@ void LoginServer::OnCreateHero(const Ptr<net::Session>& session, const PCS::Logi
 
 	if (db::Hero::Get(db_conn_, name))
 	{
-		// ̹ ִ ̸.
+		// 이미 있는 이름.
 		PCS::Login::Reply_CreateHeroFailedT reply;
 		reply.error_code = PCS::ErrorCode::CREATE_HERO_NAME_ALREADY;
 		PCS::Send(*session, reply);
 		return;
 	}
 
-    // 1¥ 
+    // 렙1짜리 생성
 	const int level = 1;
 	auto db_hero = db::Hero::Create(db_conn_, rc->GetAccount()->uid, name, class_type, level);
 	if (!db_hero)
 	{
-		//  Ȱ .
+		// 생성 된게 없다.
 		PCS::Login::Reply_CreateHeroFailedT reply;
 		reply.error_code = PCS::ErrorCode::CREATE_HERO_CANNOT_CREATE;
 		PCS::Send(*session, reply);
@@ -409,7 +440,7 @@ void LoginServer::OnHeroList(const Ptr<net::Session>& session, const PCS::Login:
 {
 	if (message == nullptr) return;
 
-	// α üũ
+	// 로그인 체크
 	auto rc = GetAuthedRemoteClient(session->GetID());
 	if (!rc)
 	{
@@ -420,8 +451,10 @@ void LoginServer::OnHeroList(const Ptr<net::Session>& session, const PCS::Login:
 	auto db_char_list = db::Hero::GetList(db_conn_, rc->GetAccount()->uid);
 
 	PCS::Login::Reply_HeroListT reply;
+	size_t reply_bytes = 0;
 	for (auto& var : db_char_list)
 	{
+		reply_bytes += HERO_LIST_ENTRY_SIZE + var->name.size();
 		auto hero = std::make_unique<PCS::Login::HeroT>();
 		hero->uid = var->uid;
 		hero->name = var->name;
@@ -430,7 +463,8 @@ void LoginServer::OnHeroList(const Ptr<net::Session>& session, const PCS::Login:
 		reply.list.emplace_back(std::move(hero));
 	}
 
-	PCS::Send(*session, reply);
+	// 목록이 길면 빌더가 여러번 커지므로 예상 크기로 시작한다.
+	PCS::Send(*session, reply, BuilderSize(reply_bytes));
 }
 
 // Delete Hero ==========================================================================================================
@@ -438,7 +472,7 @@ void LoginServer::OnDeleteHero(const Ptr<net::Session>& session, const PCS::Logi
 {
 	if (message == nullptr) return;
 
-	// α üũ
+	// 로그인 체크
 	auto rc = GetAuthedRemoteClient(session->GetID());
 	if (!rc)
 	{
@@ -457,7 +491,7 @@ void LoginServer::OnDeleteHero(const Ptr<net::Session>& session, const PCS::Logi
 		return;
 	}
 
-	// 
+	// 삭제
 	db_hero->Delete(GetDB());
 
 	BOOST_LOG_TRIVIAL(info) << "Delete Hero : " << db_hero->name;
@@ -467,14 +501,13 @@ void LoginServer::OnDeleteHero(const Ptr<net::Session>& session, const PCS::Logi
 	PCS::Send(*session, reply);
 }
 
-void LoginServer::RegisterHandlers()
-{
-	RegisterMessageHandler<PCS::Login::Request_Join>([this](auto& session, auto* msg) { OnJoin(session, msg); });
-	RegisterMessageHandler<PCS::Login::Request_Login>([this](auto& session, auto* msg) { OnLogin(session, msg); });
-	RegisterMessageHandler<PCS::Login::Request_CreateHero>([this](auto& session, auto* msg) { OnCreateHero(session, msg); });
-	RegisterMessageHandler<PCS::Login::Request_HeroList>([this](auto& session, auto* msg) { OnHeroList(session, msg); });
-	RegisterMessageHandler<PCS::Login::Request_DeleteHero>([this](auto& session, auto* msg) { OnDeleteHero(session, msg); });
-}
+// 메시지 핸들러 테이블. 상수 초기화라 실행 시간에 만드는 비용이 없다.
+const LoginServer::Dispatcher LoginServer::message_handlers_ = Dispatcher::Make<
+	Dispatcher::Bind<PCS::Login::Request_Join, &LoginServer::OnJoin>,
+	Dispatcher::Bind<PCS::Login::Request_Login, &LoginServer::OnLogin>,
+	Dispatcher::Bind<PCS::Login::Request_CreateHero, &LoginServer::OnCreateHero>,
+	Dispatcher::Bind<PCS::Login::Request_HeroList, &LoginServer::OnHeroList>,
+	Dispatcher::Bind<PCS::Login::Request_DeleteHero, &LoginServer::OnDeleteHero>>();
 
 void LoginServer::RegisterManagerClientHandlers()
 {
@@ -485,14 +518,14 @@ void LoginServer::RegisterManagerClientHandlers()
 		}
 		else
 		{
-			// Manager   ϸ Ѵ.
+			// Manager 서버와 연결이 실패하면 종료한다.
 			BOOST_LOG_TRIVIAL(info) << "Connection the Manager Server is failed!";
 			Stop();
 		}
 	};
 
 	manager_client_->OnDisconnected = [this]() {
-		//  Manager      Ѵ.
+		//  Manager 서버와 연결이 끊어 지면 종료 한다.
 		BOOST_LOG_TRIVIAL(info) << "Manager Server is disconnected.";
 		Stop();
 	};
@@ -506,26 +539,38 @@ void LoginServer::RegisterManagerClientHandlers()
         }*/
     };
 
-	manager_client_->OnReplyGenerateCredential = [this](const PSS::Reply_GenerateCredential* message)
+}
+
+void LoginServer::OnReplyGenerateCredential(int session_id, const PSS::Reply_GenerateCredential* message)
+{
+    auto rc = GetRemoteClient(session_id);
+    if (!rc)
     {
-        int session_id = message->session_id();
-        uuid credential = boost::uuids::string_generator()(message->credential()->c_str());
-		
-        auto rc = GetRemoteClient(session_id);
-        if (!rc)
-        {
-            return;
-        }
+        return;
+    }
 
-		rc->Dispatch([=]()
+    // Manager 서버의 응답을 받지 못함.
+    if (message == nullptr)
+    {
+        rc->Dispatch([=]()
         {
-			rc->Authenticate(credential);
+            PCS::Login::Reply_LoginFailedT reply_msg;
+            reply_msg.error_code = PCS::ErrorCode::UNEXPECTED;
+            PCS::Send(*rc, reply_msg);
+        });
+        return;
+    }
 
-			BOOST_LOG_TRIVIAL(info) << "Authenticate. account_uid: " << rc->GetAccount()->uid << " user_name: " << rc->GetAccount()->user_name;
+    uuid credential = boost::uuids::string_generator()(message->credential()->c_str());
 
-			PCS::Login::Reply_LoginSuccessT reply_msg;
-			reply_msg.credential = boost::uuids::to_string(credential);
-			PCS::Send(*rc, reply_msg);
-		});
-	};
+	rc->Dispatch([=]()
+    {
+		rc->Authenticate(credential);
+
+		BOOST_LOG_TRIVIAL(info) << "Authenticate. account_uid: " << rc->GetAccount()->uid << " user_name: " << rc->GetAccount()->user_name;
+
+		PCS::Login::Reply_LoginSuccessT reply_msg;
+		reply_msg.credential = boost::uuids::to_string(credential);
+		PCS::Send(*rc, reply_msg);
+	});
 }
@@ -4,14 +4,14 @@
 
 namespace PSS = ProtocolSS;
 
-ManagerClient::ManagerClient(const net::ClientConfig& config, IServer* owner, std::string client_name, ServerType type)
+ManagerClient::ManagerClient(const net::ClientConfig& config, size_t connection_count, const duration& request_timeout, IServer* owner, std::string client_name, ServerType type)
 	: owner_(owner)
 	, session_id_(0)
 	, name_(client_name)
     , type_(type)
 {
-	net_client_ = net::NetClient::Create(config);
-	ev_loop_ = net_client_->GetEventLoop();
+	link_ = std::make_shared<ServerLink>(config, connection_count, request_timeout);
+	ev_loop_ = link_->GetEventLoop();
 }
 
 ManagerClient::~ManagerClient()
@@ -21,42 +21,32 @@ ManagerClient::~ManagerClient()
 
 void ManagerClient::Connect(const std::string& address, uint16_t port)
 {
-	net_client_->RegisterNetEventHandler([this](const net::NetEventType& et) {
-		if (net::NetEventType::Opened == et)
-		{
-			HandleConnected(true);
-		}
-		else if (net::NetEventType::ConnectFailed == et)
-		{
-			HandleConnected(false);
-		}
-		else if (net::NetEventType::Closed == et)
-		{
-			HandleDisconnected();
-		}
+	address_ = address;
+	port_ = port;
+
+	link_->RegisterNetEventHandler([this](size_t index, const net::NetEventType& et)
+	{
+		HandleNetEvent(index, et);
 	});
-	net_client_->RegisterMessageHandler([this](auto* buf, auto bytes)
+	link_->RegisterMessageHandler([this](size_t index, const PSS::MessageRoot* message_root)
 	{
-		HandleMessage(buf, bytes);
+		HandleMessage(index, message_root);
 	});
 
-	// ޽ ڵ鷯 .
-	RegisterHandlers();
-
-	// Frame Update .
-	auto& strand = net_client_->GetStrand();
+	// Frame Update 시작.
+	strand_ = std::make_shared<strand>(ev_loop_->GetIoContext());
 	update_timer_ = std::make_shared<timer_type>(ev_loop_->GetIoContext());
 	ScheduleNextUpdate(clock_type::now(), TIME_STEP);
 
-	//  .
-	net_client_->Connect(address, std::to_string(port));
+	// 첫번째 연결부터 접속 시작. 나머지는 로그인이 끝나면 접속한다.
+	link_->Connect(0, address, port);
 	
 	BOOST_LOG_TRIVIAL(info) << "ManagerClient Start : " << GetName();
 }
 
 void ManagerClient::Disconnect()
 {
-	net_client_->Close();
+	link_->Close();
 }
 
 void ManagerClient::Wait()
@@ -64,26 +54,41 @@ void ManagerClient::Wait()
 	ev_loop_->Wait();
 }
 
-void ManagerClient::RequestGenerateCredential(int session_id, int account_uid)
+void ManagerClient::RequestGenerateCredential(int session_id, int account_uid, const GenerateCredentialHandler& handler)
 {
-    if (GetSessionId() == 0) return;
+    if (GetSessionId() == 0)
+    {
+        handler(nullptr);
+        return;
+    }
 
     PSS::Request_GenerateCredentialT req_msg;
 	req_msg.session_id = session_id;
 	req_msg.account_uid = account_uid;
 
-	PSS::Send(*net_client_, req_msg);
+	// 같은 계정의 인증키 생성과 로그아웃 통지는 순서가 바뀌지 않게 같은 연결로 보낸다.
+	link_->Request(link_->Affinity(account_uid), req_msg, [handler](const PSS::MessageRoot* message_root)
+	{
+		handler(message_root ? message_root->message_as<PSS::Reply_GenerateCredential>() : nullptr);
+	});
 }
 
-void ManagerClient::RequestVerifyCredential(int session_id, const uuid & credential)
+void ManagerClient::RequestVerifyCredential(int session_id, const uuid & credential, const VerifyCredentialHandler& handler)
 {
-    if (GetSessionId() == 0) return;
+    if (GetSessionId() == 0)
+    {
+        handler(nullptr);
+        return;
+    }
 
     PSS::Request_VerifyCredentialT req_msg;
 	req_msg.session_id = session_id;
 	req_msg.credential = boost::uuids::to_string(credential);
 
-	PSS::Send(*net_client_, req_msg);
+	link_->Request(ServerLink::ANY_CONNECTION, req_msg, [handler](const PSS::MessageRoot* message_root)
+	{
+		handler(message_root ? message_root->message_as<PSS::Reply_VerifyCredential>() : nullptr);
+	});
 }
 
 void ManagerClient::NotifyUserLogout(int account_uid)
@@ -93,70 +98,123 @@ void ManagerClient::NotifyUserLogout(int account_uid)
     PSS::Notify_UserLogoutT req_msg;
 	req_msg.account_uid = account_uid;
 
-	PSS::Send(*net_client_, req_msg);
+	auto client = link_->GetConnection(link_->Affinity(account_uid));
+	if (client)
+		PSS::Send(*client, req_msg);
+}
+
+void ManagerClient::HandleNetEvent(size_t index, const net::NetEventType& et)
+{
+	if (net::NetEventType::Opened == et)
+	{
+		HandleConnected(index, true);
+	}
+	else if (net::NetEventType::ConnectFailed == et)
+	{
+		HandleConnected(index, false);
+	}
+	else if (net::NetEventType::Closed == et)
+	{
+		HandleDisconnected(index);
+	}
 }
 
-void ManagerClient::HandleConnected(bool success)
+void ManagerClient::HandleConnected(size_t index, bool success)
 {
 	if (success)
 	{
-		// Manager  . α õ.
-        PSS::Request_LoginT msg;
-		msg.client_name = GetName();
-		msg.client_type = (int)type_;
-		
-		PSS::Send(*net_client_, msg);
+		// Manager 연결 성공. 로그인 시도.
+		RequestLogin(index, index == 0 ? 0 : GetSessionId());
 	}
-	else
+	else if (index == 0)
 	{
-		// Manager  .
+		// Manager 연결 실패.
         if (OnConnected)
     		OnConnected(PSS::ErrorCode::LOGIN_CONNECTION_FAILED);
 	}
+	else
+	{
+		// 추가 연결은 실패해도 남은 연결로 계속 한다.
+		BOOST_LOG_TRIVIAL(info) << "Failed to connect the additional link. index: " << index;
+	}
 }
 
-void ManagerClient::HandleDisconnected()
+void ManagerClient::HandleDisconnected(size_t index)
 {
-	// Manager  .
+	if (index != 0)
+	{
+		BOOST_LOG_TRIVIAL(info) << "Additional link is disconnected. index: " << index;
+		return;
+	}
+
+	// Manager 연결이 끊어짐.
     if (OnDisconnected)
     	OnDisconnected();
 }
 
-void ManagerClient::HandleMessage(const uint8_t * buf, size_t bytes)
+void ManagerClient::RequestLogin(size_t index, int link_session_id)
+{
+    PSS::Request_LoginT msg;
+	msg.client_name = GetName();
+	msg.client_type = (int)type_;
+	msg.link_session_id = link_session_id;
+
+	link_->Request(index, msg, [this, index](const PSS::MessageRoot* message_root)
+	{
+		HandleLogin(index, message_root ? message_root->message_as<PSS::Reply_Login>() : nullptr);
+	});
+}
+
+void ManagerClient::HandleLogin(size_t index, const PSS::Reply_Login* message)
 {
-	// flatbuffer ޽ ø
-	const auto* message_root = PSS::GetMessageRoot(buf);
-	if (message_root == nullptr)
+	auto error_code = message ? message->error_code() : PSS::ErrorCode::LOGIN_CONNECTION_FAILED;
+	if (error_code == PSS::ErrorCode::OK)
+		link_->SetReady(index, true);
+
+	if (index != 0)
 	{
-		BOOST_LOG_TRIVIAL(info) << "Invalid MessageRoot";
+		if (error_code != PSS::ErrorCode::OK)
+			BOOST_LOG_TRIVIAL(info) << "Failed to login the additional link. index: " << index << " error_code: " << static_cast<int>(error_code);
 		return;
 	}
 
+	if (error_code == PSS::ErrorCode::OK)
+	{
+		SetSessionId(message->session_id());
+
+		// 나머지 연결을 접속한다.
+		for (size_t i = 1; i < link_->GetConnectionCount(); i++)
+		{
+			link_->Connect(i, address_, port_);
+		}
+	}
+
+    if (OnConnected)
+        OnConnected(error_code);
+}
+
+void ManagerClient::HandleMessage(size_t index, const PSS::MessageRoot* message_root)
+{
 	auto message_type = message_root->message_type();
-	auto iter = message_handlers_.find(message_type);
-	if (iter == message_handlers_.end())
+	auto handler = message_handlers_.Find(message_type);
+	if (handler == nullptr)
 	{
 		BOOST_LOG_TRIVIAL(info) << "Can not find the message handler. message_type : " << PSS::EnumNameMessageType(message_type);
 		return;
 	}
 
-	try
-	{
-		// ޽ ڵ鷯 
-		iter->second(message_root);
-	}
-	catch (std::exception& e)
+	// 메시지 핸들러를 실행
+	if (!handler(*this, message_root))
 	{
-		BOOST_LOG_TRIVIAL(info) << "Exception: " << e.what();
+		BOOST_LOG_TRIVIAL(info) << "Can not cast message_type : " << PSS::EnumNameMessageType(message_type);
 	}
 }
 
 void ManagerClient::ScheduleNextUpdate(const time_point & now, const duration & timestep)
 {
-	auto& strand = net_client_->GetStrand();
 	auto update_time = now + timestep;
 	update_timer_->expires_at(update_time);
-	update_timer_->async_wait(strand.wrap([this, start_time = now, timestep](auto& error)
+	update_timer_->async_wait(strand_->wrap([this, start_time = now, timestep](auto& error)
 	{
 		if (error) return;
 
@@ -167,45 +225,37 @@ void ManagerClient::ScheduleNextUpdate(const time_point & now, const duration &
 	}));
 }
 
-void ManagerClient::RegisterHandlers()
+void ManagerClient::HandleRelayMessage(const PSS::RelayMessage* message)
 {
-    RegisterMessageHandler<PSS::RelayMessage>([this](const PSS::RelayMessage* message)
-    {
-        if (OnRelayMessage)
-            OnRelayMessage(message);
-    });
-    RegisterMessageHandler<PSS::Reply_Login>([this](const PSS::Reply_Login* message)
-    {
-        SetSessionId(message->session_id());
+    if (OnRelayMessage)
+        OnRelayMessage(message);
+}
 
-        if (OnConnected)
-            OnConnected(message->error_code());
-    });
-    RegisterMessageHandler<PSS::Reply_GenerateCredential>([this](const PSS::Reply_GenerateCredential* message)
-    {
-        if (OnReplyGenerateCredential)
-            OnReplyGenerateCredential(message);
-    });
-    RegisterMessageHandler<PSS::Reply_VerifyCredential>([this](const PSS::Reply_VerifyCredential* message)
-    {
-        if (OnReplyVerifyCredential)
-            OnReplyVerifyCredential(message);
-    });
-    RegisterMessageHandler<PSS::Notify_ServerList>([this](const PSS::Notify_ServerList* message)
+void ManagerClient::HandleUnauthedAccess(const PSS::Notify_UnauthedAccess* /*message*/)
+{
+    BOOST_LOG_TRIVIAL(info) << "Unauthed access to the Manager Server.";
+}
+
+void ManagerClient::HandleServerList(const PSS::Notify_ServerList* message)
+{
+    std::unordered_map<int, ServerInfo> server_list;
+    auto list = message->server_list();
+    for (size_t i = 0; i < list->Length(); i++)
     {
-        std::unordered_map<int, ServerInfo> server_list;
-        auto list = message->server_list();
-        for (size_t i = 0; i < list->Length(); i++)
-        {
-            auto* server_info = list->Get(i);
-            server_list.emplace(server_info->session_id(), ServerInfo{ server_info->session_id(), std::string(server_info->name()->c_str()), (ServerType)server_info->type() });
+        auto* server_info = list->Get(i);
+        server_list.emplace(server_info->session_id(), ServerInfo{ server_info->session_id(), std::string(server_info->name()->c_str()), (ServerType)server_info->type() });
 #ifdef _DEBUG
-            auto& value = server_list[server_info->session_id()];
-            BOOST_LOG_TRIVIAL(debug) << "Server info -> session id:" << std::get<0>(value) << " server name:" << std::get<1>(value) << " server type:" << std::get<2>(value) << "\n";
+        auto& value = server_list[server_info->session_id()];
+        BOOST_LOG_TRIVIAL(debug) << "Server info -> session id:" << std::get<0>(value) << " server name:" << std::get<1>(value) << " server type:" << std::get<2>(value) << "\n";
 #endif // _DEBUG
-        }
+    }
+
+    std::lock_guard<std::mutex> guard(mutex_);
+    server_list_.swap(server_list);
+}
 
-        std::lock_guard<std::mutex> guard(mutex_);
-        server_list_.swap(server_list);
-    });
-}
\ No newline at end of file
+// 메시지 핸들러 테이블. 상수 초기화라 실행 시간에 만드는 비용이 없다.
+const ManagerClient::Dispatcher ManagerClient::message_handlers_ = Dispatcher::Make<
+    Dispatcher::Bind<PSS::RelayMessage, &ManagerClient::HandleRelayMessage>,
+    Dispatcher::Bind<PSS::Notify_UnauthedAccess, &ManagerClient::HandleUnauthedAccess>,
+    Dispatcher::Bind<PSS::Notify_ServerList, &ManagerClient::HandleServerList>>();
\ No newline at end of file
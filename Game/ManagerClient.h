@@ -4,7 +4,9 @@
 #include <type_traits>
 #include <chrono>
 #include "Common.h"
+#include "MessageDispatcher.h"
 #include "protocol_ss_generated.h"
+#include "ServerLink.h"
 
 enum ServerType : int
 {
@@ -17,50 +19,56 @@ using ServerInfo = std::tuple<int, std::string, ServerType>;
 
 class IServer;
 
-// Ŵ  ϴ Ŭ̾Ʈ.
-//  û, Ȯ   ޴´.
+// 매니저 서버에 접속하는 클라이언트.
+// 인증 요청, 확인 및 응답을 받는다.
+// 첫번째 연결로 로그인한 뒤 나머지 연결은 같은 서버의 추가 연결로 로그인해서 요청을 나눠 보낸다.
 class ManagerClient
 {
 public:
-	ManagerClient(const net::ClientConfig& config, IServer* owner, std::string client_name, ServerType type);
+    // 응답을 받지 못하면 nullptr 로 호출된다.
+    using GenerateCredentialHandler = std::function<void(const ProtocolSS::Reply_GenerateCredential*)>;
+    using VerifyCredentialHandler = std::function<void(const ProtocolSS::Reply_VerifyCredential*)>;
+
+	ManagerClient(const net::ClientConfig& config, size_t connection_count, const duration& request_timeout, IServer* owner, std::string client_name, ServerType type);
 	virtual ~ManagerClient();
 
     int GetSessionId() { return session_id_; }
-    // Ŭ̾Ʈ ̸.
+    // 클라이언트 이름.
 	std::string GetName() { return name_; }
-	// .
+	// 접속.
 	void Connect(const std::string& address, uint16_t port);
-	// .
+	// 종료.
 	void Disconnect();
-	//    .
+	// 종료될 때 까지 대기.
 	void Wait();
-    //  Ŭ̾Ʈ ǰ ִ IoServiceLoop ü.
+    // 이 클라이언트가 실행되고 있는 IoServiceLoop 객체.
 	const Ptr<net::EventLoop>& GetEventLoop() { return ev_loop_; }
-    // Ű  û.
-	void RequestGenerateCredential(int session_id, int account_uid);
-    // Ű  û.
-	void RequestVerifyCredential(int session_id, const uuid& credential);
-    //  α׾ƿ .
+    // 인증키 생성을 요청.
+	void RequestGenerateCredential(int session_id, int account_uid, const GenerateCredentialHandler& handler);
+    // 인증키 검증을 요청.
+	void RequestVerifyCredential(int session_id, const uuid& credential, const VerifyCredentialHandler& handler);
+    // 유저의 로그아웃을 통지.
 	void NotifyUserLogout(int account_uid);
-    // Manager   ִ ٸ  .
+    // Manager 서버에 접속해 있는 다른 서버들 정보.
     const std::unordered_map<int, ServerInfo> GetServerList() { return  server_list_; }
     
-    //  ޽ 
+    // 릴레이 메시지를 전송
+    // 릴레이는 보낸 순서를 지키도록 첫번째 연결로만 보낸다.
     template<class T>
     void SendRelayMessage(int destination, const T& message)
     {
-        if (GetSessionId() == 0) return;
-
-        ProtocolSS::SendRelay(*net_client_, session_id_, std::vector<int>{ destination }, message);
+        SendRelayMessage(std::vector<int>{ destination }, message);
     }
     template<class T>
     void SendRelayMessage(const std::vector<int>& destinations, const T& message)
     {
         if (GetSessionId() == 0) return;
 
-        ProtocolSS::SendRelay(*net_client_, session_id_, destinations, message);
+        auto client = link_->GetConnection(0);
+        if (client)
+            ProtocolSS::SendRelay(*client, session_id_, destinations, message);
     }
-    //    ޽ 
+    // 모든 서버에게 릴레이 메시지 전송
     template<class T>
     void SendRelayMessage(const T& message)
     {
@@ -75,56 +83,48 @@ public:
                     destinations.emplace_back(std::get<0>(e.second));
             });
         }
-        ProtocolSS::SendRelay(*net_client_, session_id_, destinations, message);
+        SendRelayMessage(destinations, message);
     }
 
 	std::function<void(ProtocolSS::ErrorCode)> OnConnected;
 	std::function<void()> OnDisconnected;
-	std::function<void(const ProtocolSS::Reply_GenerateCredential*)> OnReplyGenerateCredential;
-	std::function<void(const ProtocolSS::Reply_VerifyCredential*)> OnReplyVerifyCredential;
     std::function<void(const ProtocolSS::RelayMessage*)> OnRelayMessage;
 
 private:
-    // Network message handler type.
-    using MessageHandler = std::function<void(const ProtocolSS::MessageRoot* message_root)>;
+    // 메시지 핸들러 테이블. 핸들러는 void (const T* message)
+    using Dispatcher = MessageDispatcher<ManagerClient, ProtocolSS::MessageRoot, ProtocolSS::MessageType, ProtocolSS::MessageTypeTraits>;
 
     void SetSessionId(int session_id) { session_id_ = session_id; }
 
-    //  Ʈ
+    // 프레임 업데이트
     void DoUpdate(double delta_time) {};
     void ScheduleNextUpdate(const time_point& now, const duration& timestep);
 
-    template <typename T, typename Handler>
-    void RegisterMessageHandler(Handler&& handler)
-    {
-        auto key = ProtocolSS::MessageTypeTraits<T>::enum_value;
-        auto func = [handler = std::forward<Handler>(handler)](const ProtocolSS::MessageRoot* message_root)
-        {
-            auto* message = message_root->message_as<T>();
-            if (message == nullptr)
-            {
-                BOOST_LOG_TRIVIAL(info) << "Can not cast message_type : " << ProtocolSS::EnumNameMessageType(ProtocolSS::MessageTypeTraits<T>::enum_value);
-            }
-            handler(message);
-        };
-
-        message_handlers_.insert(std::pair<decltype(key), decltype(func)>(key, func));
-    }
 
     // Handlers
-    void RegisterHandlers();
-
-    void HandleConnected(bool success);
-    void HandleDisconnected();
-	void HandleMessage(const uint8_t* buf, size_t bytes);
+    void HandleNetEvent(size_t index, const net::NetEventType& et);
+    void HandleConnected(size_t index, bool success);
+    void HandleDisconnected(size_t index);
+	void HandleMessage(size_t index, const ProtocolSS::MessageRoot* message_root);
+    // index 연결로 로그인. 첫번째 연결이 아니면 link_session_id 서버의 추가 연결이 된다.
+    void RequestLogin(size_t index, int link_session_id);
+    void HandleLogin(size_t index, const ProtocolSS::Reply_Login* message);
+    // Message Handlers
+    void HandleRelayMessage(const ProtocolSS::RelayMessage* message);
+    void HandleUnauthedAccess(const ProtocolSS::Notify_UnauthedAccess* message);
+    void HandleServerList(const ProtocolSS::Notify_ServerList* message);
 
 	std::mutex mutex_;
 
 	Ptr<net::EventLoop> ev_loop_;
-	Ptr<net::NetClient> net_client_;
+	Ptr<ServerLink> link_;
+	Ptr<strand> strand_;
 	Ptr<timer_type> update_timer_;
+
+    std::string address_;
+    uint16_t    port_ = 0;
 	
-	std::map<ProtocolSS::MessageType, MessageHandler> message_handlers_;
+	static const Dispatcher message_handlers_;
 
     IServer*	owner_;
 
@@ -24,24 +24,38 @@ void ManagerServer::Run()
 	SetName(settings.name);
 
 	// Create io_service loop
-	size_t thread_count = settings.thread_count;
-	ev_loop_ = std::make_shared<net::EventLoop>(thread_count);
+	net::EventLoopConfig ev_loop_config;
+	ev_loop_config.thread_count = settings.thread_count;
+	ev_loop_config.mode = settings.io_context_per_thread ? net::EventLoopMode::ContextPerThread : net::EventLoopMode::Shared;
+	ev_loop_config.spin_time = settings.spin_time;
+	ev_loop_config.cpu_affinity = settings.cpu_affinity;
+	ev_loop_config.thread_name = "manager";
+	ev_loop_ = std::make_shared<net::EventLoop>(ev_loop_config);
 	
 	// NetServer Config
 	net::ServerConfig net_config;
 	net_config.event_loop = ev_loop_;
 	net_config.max_session_count = settings.max_session_count;
+	net_config.accept_count = settings.accept_count;
+	net_config.reuse_port = settings.reuse_port;
 	net_config.max_receive_buffer_size = settings.max_receive_buffer_size;
+	net_config.max_send_buffer_size = settings.max_send_buffer_size;
+	net_config.compress_threshold = settings.compress_threshold;
+	net_config.idle_timeout = settings.idle_timeout;
+	net_config.max_frames_per_read = settings.max_frames_per_read;
+	net_config.message_rate_limit = { settings.message_rate, settings.message_burst > 0 ? settings.message_burst : settings.message_rate };
+	net_config.max_rate_violations = settings.max_rate_violations;
+	net_config.stats_log_interval = settings.stats_log_interval;
 	net_config.min_receive_size = settings.min_receive_size;
+	net_config.shared_receive_buffer = settings.shared_receive_buffer;
+	net_config.io_uring = settings.io_uring;
 	net_config.no_delay = settings.no_delay;
+	net_config.session_affinity = (settings.session_affinity == "least-load") ? net::SessionAffinity::LeastLoad : net::SessionAffinity::RoundRobin;
 	// Create NetServer
 	net_server_ = net::NetServer::Create(net_config);
 	net_server_->RegisterSessionOpenedHandler([this](auto& session) { HandleSessionOpened(session); });
 	net_server_->RegisterSessionClosedHandler([this](auto& session, auto reason) { HandleSessionClosed(session, reason); });
-	net_server_->RegisterMessageHandler([this](auto& session, auto buf, auto bytes) { HandleMessage(session, buf, bytes); });
-	
-	// ޽ ڵ鷯 
-	RegisterHandlers();
+	net_server_->RegisterMessageHandler([this](auto& session, auto message_type, auto buf, auto bytes) { HandleMessage(session, message_type, buf, bytes); });
 
 	// Create DB connection Pool
 	db_conn_ = MySQLPool::Create(
@@ -51,12 +65,12 @@ void ManagerServer::Run()
 		settings.db_schema,
 		settings.db_connection_pool);
 
-	// Frame Update .
+	// Frame Update 시작.
 	strand_ = std::make_shared<strand>(ev_loop_->GetIoContext());
     update_timer_ = std::make_shared<timer_type>(ev_loop_->GetIoContext());
 	ScheduleNextUpdate(clock_type::now(), TIME_STEP);
 
-	// NetServer  ۽Ų.
+	// NetServer 를 시작시킨다.
 	std::string bind_address = settings.bind_address;
 	uint16_t bind_port = settings.bind_port;
 	net_server_->Start(bind_address, bind_port);
@@ -66,14 +80,14 @@ void ManagerServer::Run()
 
 void ManagerServer::Stop()
 {
-	//  ۾.
+	// 종료 작업.
     if (ev_loop_)
         ev_loop_->Stop();
 
 	BOOST_LOG_TRIVIAL(info) << "Stop " << GetName();
 }
 
-//    
+// 서버가 종료될 때가지 대기
 void ManagerServer::Wait()
 {
 	if (ev_loop_)
@@ -83,7 +97,15 @@ void ManagerServer::Wait()
 const Ptr<RemoteManagerClient> ManagerServer::GetRemoteClient(int session_id)
 {
 	auto iter = remote_clients_.find(session_id);
+	if (iter != remote_clients_.end())
+		return iter->second;
+
+	// 추가 연결이면 그 서버가 처음 로그인한 연결의 RemoteClient.
+	auto link = link_sessions_.find(session_id);
+	if (link == link_sessions_.end())
+		return nullptr;
 
+	iter = remote_clients_.find(link->second);
 	return iter == remote_clients_.end() ? nullptr : iter->second;
 }
 
@@ -98,16 +120,16 @@ const Ptr<RemoteManagerClient> ManagerServer::GetRemoteClientByName(const std::s
 }
 
 
-//  Ʈ
+// 프레임 업데이트
 void ManagerServer::DoUpdate(double delta_time)
 {
-	//   ð.
+	// 삭제 유예 시간.
 	constexpr duration wait_time(60000ms);
 
 	std::lock_guard<std::mutex> lock_guard(mutex_);
 
-	// α׾ƿ ð  .
-	// TO DO : ϰ ü . ϴ  .
+	// 로그아웃후 시간이 지나면 지운다.
+	// TO DO : 무식하게 전체를 돌려버림. 정렬하는 방법이 있을듯.
 	auto iter = user_session_set_.begin();
 	for (; iter != user_session_set_.end(); )
 	{
@@ -140,13 +162,22 @@ void ManagerServer::RemoveRemoteClient(const Ptr<RemoteManagerClient>& remote_cl
 
 void ManagerServer::ProcessRemoteClientDisconnected(const Ptr<RemoteManagerClient>& rc)
 {
-	// Ͽ 
+	// 목록에서 제거
 	RemoveRemoteClient(rc);
 	rc->OnDisconnected();
 
+	// 이 서버의 추가 연결도 제거
+	for (auto iter = link_sessions_.begin(); iter != link_sessions_.end(); )
+	{
+		if (iter->second == rc->GetSessionID())
+			iter = link_sessions_.erase(iter);
+		else
+			++iter;
+	}
+
 	BOOST_LOG_TRIVIAL(info) << "Logout. Server name: " << rc->GetServerName();
     
-    //  Ŭ̾Ʈ  Ʈ 
+    // 모든 클라이언트에게 서버 리스트를 통지
     for (auto& e : remote_clients_)
     {
         NotifyServerList(e.second->GetSession());
@@ -168,19 +199,20 @@ void ManagerServer::ScheduleNextUpdate(const time_point& now, const duration& ti
 	}));
 }
 
-void ManagerServer::NotifyUnauthedAccess(const Ptr<net::Session>& session)
+void ManagerServer::NotifyUnauthedAccess(const Ptr<net::Session>& session, uint32_t correlation_id)
 {
-	fb::FlatBufferBuilder fbb;
+	fb::FlatBufferBuilder fbb(BUILDER_INITIAL_SIZE, &PooledBuilderAllocator::Instance());
 	auto notify = PSS::CreateNotify_UnauthedAccess(fbb);
-	auto msg_root = PSS::CreateMessageRoot(fbb, PSS::MessageType::Notify_UnauthedAccess, notify.Union());
+	// 요청에 대한 경고면 요청한 쪽이 제한 시간까지 기다리지 않도록 응답으로 보낸다.
+	auto msg_root = PSS::CreateMessageRoot(fbb, PSS::MessageType::Notify_UnauthedAccess, notify.Union(), correlation_id);
 	PSS::FinishMessageRootBuffer(fbb, msg_root);
 
-	session->Send(fbb.GetBufferPointer(), fbb.GetSize());
+	session->Send(MakeSendBuffer(fbb, static_cast<uint16_t>(PSS::MessageType::Notify_UnauthedAccess)));
 }
 
 void ManagerServer::NotifyServerList(const Ptr<net::Session>& session)
 {
-    fb::FlatBufferBuilder fbb;
+    fb::FlatBufferBuilder fbb(BUILDER_INITIAL_SIZE, &PooledBuilderAllocator::Instance());
     std::vector<fb::Offset<PSS::ServerInfo>> vec_server_info;
     for (auto& e : remote_clients_)
     {
@@ -193,30 +225,34 @@ void ManagerServer::NotifyServerList(const Ptr<net::Session>& session)
     PSS::Send(*session, fbb, notify);
 }
 
-void ManagerServer::HandleMessage(const Ptr<net::Session>& session, const uint8_t* buf, size_t bytes)
+void ManagerServer::HandleMessage(const Ptr<net::Session>& session, uint16_t message_type, const uint8_t* buf, size_t bytes)
 {
-	// flatbuffer ޽ ø
-	const auto* message_root = PSS::GetMessageRoot(buf);
-	if (message_root == nullptr)
+	// payload 를 보기 전에 헤더의 타입으로 핸들러를 찾는다. 타입이 없거나(0) 모르는 타입이면 버리고 위반으로 센다.
+	auto handler = message_handlers_.Find(message_type);
+	if (handler == nullptr)
 	{
-		BOOST_LOG_TRIVIAL(info) << "Invalid MessageRoot";
+		BOOST_LOG_TRIVIAL(info) << "Can not find the message handler. header_type : " << message_type;
+		session->RejectMessage(message_type);
 		return;
 	}
 
-	auto message_type = message_root->message_type();
-    //BOOST_LOG_TRIVIAL(debug) << "On Recv message_type : " << PSS::EnumNameMessageType(message_type);
-
-	auto iter = message_handlers_.find(message_type);
-	if (iter == message_handlers_.end())
+	// flatbuffer 메시지로 디시리얼라이즈
+	const auto* message_root = PSS::GetMessageRoot(buf);
+	if (message_root == nullptr || message_root->message_type() != static_cast<PSS::MessageType>(message_type))
 	{
-		BOOST_LOG_TRIVIAL(info) << "Can not find the message handler. message_type : " << PSS::EnumNameMessageType(message_type);
+		BOOST_LOG_TRIVIAL(info) << "Invalid MessageRoot. header_type : " << message_type;
+		session->RejectMessage(message_type);
 		return;
 	}
+    //BOOST_LOG_TRIVIAL(debug) << "On Recv message_type : " << PSS::EnumNameMessageType(message_root->message_type());
 
 	try
 	{
-		// ޽ ڵ鷯 
-		iter->second(session, message_root);
+		// 메시지 핸들러를 실행
+		if (!handler(*this, session, message_root->correlation_id(), message_root))
+		{
+			BOOST_LOG_TRIVIAL(info) << "Can not cast message_type : " << PSS::EnumNameMessageType(message_root->message_type());
+		}
 	}
 	catch (sql::SQLException& e)
 	{
@@ -238,6 +274,10 @@ void ManagerServer::HandleSessionOpened(const Ptr<net::Session>& session)
 void ManagerServer::HandleSessionClosed(const Ptr<net::Session>& session, net::CloseReason reason)
 {
 	std::lock_guard<std::mutex> lock_guard(mutex_);
+	// 추가 연결이 끊어지면 연결 정보만 지운다.
+	if (link_sessions_.erase(session->GetID()) > 0)
+		return;
+
 	auto remote_client = GetRemoteClient(session->GetID());
 	if (!remote_client)
 		return;
@@ -245,12 +285,14 @@ void ManagerServer::HandleSessionClosed(const Ptr<net::Session>& session, net::C
 	ProcessRemoteClientDisconnected(remote_client);
 }
 
-void ManagerServer::OnRelayMessage(const Ptr<net::Session>& session, const PSS::RelayMessage * message)
+void ManagerServer::OnRelayMessage(const Ptr<net::Session>& session, uint32_t /*correlation_id*/, const PSS::RelayMessage * message)
 {
-    fb::FlatBufferBuilder fbb;
+    fb::FlatBufferBuilder fbb(BUILDER_INITIAL_SIZE, &PooledBuilderAllocator::Instance());
     auto relay_offset = PSS::RelayMessage::Pack(fbb, message->UnPack());
     auto offset_root = PSS::CreateMessageRoot(fbb, PSS::MessageTypeTraits<PSS::RelayMessage>::enum_value, relay_offset.Union());
     FinishMessageRootBuffer(fbb, offset_root);
+    // 한번 만든 버퍼를 모든 대상이 공유한다.
+    auto send_buffer = MakeSendBuffer(fbb, static_cast<uint16_t>(PSS::MessageTypeTraits<PSS::RelayMessage>::enum_value));
 
     auto* destinations_id = message->destinations_id();
     for (size_t i = 0; i < destinations_id->Length(); i++)
@@ -259,13 +301,13 @@ void ManagerServer::OnRelayMessage(const Ptr<net::Session>& session, const PSS::
         auto dest_client = GetRemoteClient(id);
         if (dest_client)
         {
-            dest_client->Send(fbb.GetBufferPointer(), fbb.GetSize());
+            dest_client->Send(send_buffer);
         }
     }
 }
 
 // Login ================================================================================================================
-void ManagerServer::OnLogin(const Ptr<net::Session>& session, const PSS::Request_Login* message)
+void ManagerServer::OnLogin(const Ptr<net::Session>& session, uint32_t correlation_id, const PSS::Request_Login* message)
 {
 	if (message == nullptr) return;
 
@@ -273,16 +315,38 @@ void ManagerServer::OnLogin(const Ptr<net::Session>& session, const PSS::Request
 	const std::string name = message->client_name()->str();
 	const ServerType type = (ServerType)message->client_type();
 
-	// ̹ ưų  ̸  
+	// 이미 로그인한 서버의 추가 연결. 서버 목록에는 넣지 않는다.
+	const int link_session_id = message->link_session_id();
+	if (link_session_id != 0)
+	{
+		PSS::Reply_LoginT reply;
+		auto owner = GetRemoteClient(link_session_id);
+		if (!owner || owner->GetSessionID() != link_session_id || owner->GetServerName() != name || GetRemoteClient(session->GetID()))
+		{
+			reply.error_code = PSS::ErrorCode::INVALID_SESSION;
+		}
+		else
+		{
+			link_sessions_.emplace(session->GetID(), link_session_id);
+			reply.error_code = PSS::ErrorCode::OK;
+			reply.session_id = link_session_id;
+
+			BOOST_LOG_TRIVIAL(info) << "Link login. Server name: " << name << " session_id: " << session->GetID();
+		}
+		PSS::Send(*session, reply, correlation_id);
+		return;
+	}
+
+	// 이미 인증됐거나 같은 이름이 있으면 거절
 	if( GetRemoteClient(session->GetID()) || GetRemoteClientByName(name))
 	{
 		PSS::Reply_LoginT reply;
 		reply.error_code = PSS::ErrorCode::LOGIN_ALREADY_CONNECTED;
-		PSS::Send(*session, reply);
+		PSS::Send(*session, reply, correlation_id);
 		return;
 	}
 
-	// α . RemoteClient   ߰.
+	// 로그인 성공. RemoteClient 생성 및 추가.
 	auto new_rc = std::make_shared<RemoteManagerClient>(session, name, type);
 	AddRemoteClient(new_rc->GetSessionID(), new_rc);
 
@@ -291,45 +355,48 @@ void ManagerServer::OnLogin(const Ptr<net::Session>& session, const PSS::Request
 	PSS::Reply_LoginT reply;
 	reply.error_code = PSS::ErrorCode::OK;
     reply.session_id = session->GetID();
-	PSS::Send(*session, reply);
+	PSS::Send(*session, reply, correlation_id);
 
-    //  Ŭ̾Ʈ  Ʈ 
+    // 모든 클라이언트에게 서버 리스트를 통지
     for (auto& e : remote_clients_)
     {
         NotifyServerList(e.second->GetSession());
     }
 }
 
-void ManagerServer::OnGenerateCredential(const Ptr<net::Session>& session, const PSS::Request_GenerateCredential * message)
+void ManagerServer::OnGenerateCredential(const Ptr<net::Session>& session, uint32_t correlation_id, const PSS::Request_GenerateCredential * message)
 {
 	if (message == nullptr) return;
 
+	// 락을 잡기 전에 만든다. 생성기는 만들때 시드를 읽으므로 스레드마다 하나만 만든다.
+	static thread_local boost::uuids::random_generator credential_generator;
+	const uuid new_credential = credential_generator();
+
 	std::lock_guard<std::mutex> lock_guard(mutex_);
 	auto rc = GetRemoteClient(session->GetID());
 	if (!rc)
 	{
-		NotifyUnauthedAccess(session);
+		NotifyUnauthedAccess(session, correlation_id);
 		return;
 	}
 
 	const int account_uid = message->account_uid();
-	const uuid new_credential = boost::uuids::random_generator()();
 
 	auto& indexer = user_session_set_.get<tags::account_uid>();
 	auto iter = indexer.find(account_uid);
 	if (iter != indexer.end())
 	{
-		// credential   ߱ ϰ α · .
+		// credential 을 새로 발급 하고 로그인 상태로 돌린다.
 		indexer.modify(iter, [&new_credential, &rc](UserSession& var) { var.credential_ = new_credential; var.login_servers_[rc->GetServerName()] = true; });
 	}
 	else
 	{
-		//  
+		// 새 삽입
         UserSession user(account_uid, new_credential);
         user.login_servers_[rc->GetServerName()] = true;
 		user_session_set_.emplace(std::move(user));
 	}
-	// ٽ ã´.
+	// 다시 찾는다.
 	iter = indexer.find(account_uid);
 	if (iter == indexer.end())
 		return;
@@ -339,42 +406,40 @@ void ManagerServer::OnGenerateCredential(const Ptr<net::Session>& session, const
 	PSS::Reply_GenerateCredentialT reply;
 	reply.session_id = message->session_id();
 	reply.credential = boost::uuids::to_string(new_credential);
-	PSS::Send(*session, reply);
+	PSS::Send(*session, reply, correlation_id);
 }
 
-void ManagerServer::OnVerifyCredential(const Ptr<net::Session>& session, const PSS::Request_VerifyCredential * message)
+void ManagerServer::OnVerifyCredential(const Ptr<net::Session>& session, uint32_t correlation_id, const PSS::Request_VerifyCredential * message)
 {
 	if (message == nullptr) return;
 
+    std::string str_credential = message->credential()->c_str();
+	const uuid credential = boost::uuids::string_generator()(str_credential);
+
 	std::lock_guard<std::mutex> lock_guard(mutex_);
 	auto rc = GetRemoteClient(session->GetID());
 	if (!rc)
 	{
-		NotifyUnauthedAccess(session);
+		NotifyUnauthedAccess(session, correlation_id);
 		return;
 	}
 
-    std::string str_credential = message->credential()->c_str();
-	const uuid credential = boost::uuids::string_generator()(str_credential);
-	auto error_code = PSS::ErrorCode::OK;
-
 	auto& indexer = user_session_set_.get<tags::credential>();
 	auto iter = indexer.find(credential);
 	if (iter == indexer.end())
 	{
         BOOST_LOG_TRIVIAL(info) << "Failed to verify credential : " << credential;
 
-		//  
+		// 없으면 실패
 		PSS::Reply_VerifyCredentialT reply;
         reply.error_code = PSS::ErrorCode::VERIFY_CREDENTIAL_FAILED;
 		reply.session_id = message->session_id();
         reply.credential = str_credential;
-        reply.account_uid = iter->account_uid_;
-		PSS::Send(*session, reply);
+		PSS::Send(*session, reply, correlation_id);
 		return;
 	}
 
-	// ٽ α · .
+	// 다시 로그인 상태로 돌린다.
 	indexer.modify(iter, [&rc](UserSession& user) { user.login_servers_[rc->GetServerName()] = true; });
 
 	BOOST_LOG_TRIVIAL(info) << "Verify credential. account_uid: " << iter->account_uid_ << " credential: " << iter->credential_;
@@ -384,10 +449,10 @@ void ManagerServer::OnVerifyCredential(const Ptr<net::Session>& session, const P
 	reply.session_id = message->session_id();
 	reply.credential = str_credential;
 	reply.account_uid = iter->account_uid_;
-	PSS::Send(*session, reply);
+	PSS::Send(*session, reply, correlation_id);
 }
 
-void ManagerServer::OnUserLogout(const Ptr<net::Session>& session, const PSS::Notify_UserLogout * message)
+void ManagerServer::OnUserLogout(const Ptr<net::Session>& session, uint32_t /*correlation_id*/, const PSS::Notify_UserLogout * message)
 {
 	if (message == nullptr) return;
 
@@ -399,7 +464,7 @@ void ManagerServer::OnUserLogout(const Ptr<net::Session>& session, const PSS::No
 		return;
 	}
 
-	// ٷ  ʰ α׾ƿ · .
+	// 바로 지우지 않고 로그아웃 상태로 변경.
 	const int account_uid = message->account_uid();
 	auto& indexer = user_session_set_.get<tags::account_uid>();
 	auto iter = indexer.find(account_uid);
@@ -410,11 +475,10 @@ void ManagerServer::OnUserLogout(const Ptr<net::Session>& session, const PSS::No
 	}
 }
 
-void ManagerServer::RegisterHandlers()
-{
-    RegisterMessageHandler<PSS::RelayMessage>([this](auto& session, auto* msg) { OnRelayMessage(session, msg); });
-	RegisterMessageHandler<PSS::Request_Login>([this](auto& session, auto* msg) { OnLogin(session, msg); });
-	RegisterMessageHandler<PSS::Request_GenerateCredential>([this](auto& session, auto* msg) { OnGenerateCredential(session, msg); });
-	RegisterMessageHandler<PSS::Request_VerifyCredential>([this](auto& session, auto* msg) { OnVerifyCredential(session, msg); });
-	RegisterMessageHandler<PSS::Notify_UserLogout>([this](auto& session, auto* msg) { OnUserLogout(session, msg); });
-}
\ No newline at end of file
+// 메시지 핸들러 테이블. 상수 초기화라 실행 시간에 만드는 비용이 없다.
+const ManagerServer::Dispatcher ManagerServer::message_handlers_ = Dispatcher::Make<
+	Dispatcher::Bind<PSS::RelayMessage, &ManagerServer::OnRelayMessage>,
+	Dispatcher::Bind<PSS::Request_Login, &ManagerServer::OnLogin>,
+	Dispatcher::Bind<PSS::Request_GenerateCredential, &ManagerServer::OnGenerateCredential>,
+	Dispatcher::Bind<PSS::Request_VerifyCredential, &ManagerServer::OnVerifyCredential>,
+	Dispatcher::Bind<PSS::Notify_UserLogout, &ManagerServer::OnUserLogout>>();
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <type_traits>
 #include <chrono>
 #include "Common.h"
+#include "MessageDispatcher.h"
 #include "IServer.h"
 #include "RemoteClient.h"
 #include "ManagerClient.h"
@@ -16,7 +17,7 @@
 #include <boost\multi_index\member.hpp>
 
 
-// Manager   Ŭ̾Ʈ
+// Manager 서버에 접속한 클라이언트
 class RemoteManagerClient : public RemoteClient
 {
 public:
@@ -37,7 +38,7 @@ private:
 	ServerType server_type_;
 };
 
-//   
+// 유저 인증 정보
 struct UserSession
 {
 	UserSession(int account_uid, const uuid& credential)
@@ -45,7 +46,7 @@ struct UserSession
 
     bool IsLogin() const
     {
-        // ѱ  α ¸ α.
+        // 한군대 라도 로그인 상태면 로그인.
         for (auto pair : login_servers_)
         {
             if (pair.second == true)
@@ -64,66 +65,54 @@ struct UserSession
 
 using namespace boost::multi_index;
 
-// ±׼
+// 태그선언
 struct tags
 {
 	struct account_uid {};
 	struct credential {};
 };
-// ε Ÿ 
+// 인덱싱 타입을 선언
 using indices = indexed_by<
 	hashed_unique<tag<tags::account_uid>, member<UserSession, int, &UserSession::account_uid_>>,
 	hashed_unique<tag<tags::credential>, member<UserSession, uuid, &UserSession::credential_>, boost::hash<boost::uuids::uuid>>
 >;
-// ̳ Ÿ 
+// 컨테이너 타입 선언
 using UserSessionSet = boost::multi_index_container<UserSession, indices>;
 
 
-// Ŵ .
-// ٸ   .
-//  Ű ߱,   .
+// 매니저 서버.
+// 다른 서버들의 목록 관리.
+// 유저들의 인증키 발급, 검증 및 관리.
 class ManagerServer : public IServer
 {
 public:
 	ManagerServer();
 	virtual ~ManagerServer();
-    //  ̸
+    // 서버 이름
 	std::string GetName() override { return name_; }
 	void SetName(const std::string& name) override { name_ = name; }
-	//  
+	// 서버 시작
 	void Run() override;
-	//  
+	// 서버 종료
 	void Stop() override;
-	//    
+	// 서버가 종료될 때가지 대기
 	void Wait();
-    //   ǰ ִ IoServiceLoop ü.
+    // 이 서버가 실행되고 있는 IoServiceLoop 객체.
 	const Ptr<net::EventLoop>& GetEventLoop() { return ev_loop_; }
-    // DB Ŀؼ Ǯ.
+    // DB 커넥션 풀.
 	const Ptr<MySQLPool>& GetDB() { return db_conn_; }
-	// Ʈ Ŭ̾Ʈ ü ´.
+	// 리모트 클라이언트 객체를 얻는다.
 	const Ptr<RemoteManagerClient> GetRemoteClient(int session_id);
 	const Ptr<RemoteManagerClient> GetRemoteClientByName(const std::string& name);
 
-	void NotifyUnauthedAccess(const Ptr<net::Session>& session);
+	void NotifyUnauthedAccess(const Ptr<net::Session>& session, uint32_t correlation_id = 0);
     void NotifyServerList(const Ptr<net::Session>& session);
 private:
-	// Network message handler type.
-	using MessageHandler = std::function<void(const Ptr<net::Session>&, const ProtocolSS::MessageRoot* message_root)>;
-
-	template <typename T, typename Handler>
-	void RegisterMessageHandler(Handler&& handler)
-	{
-		auto key = ProtocolSS::MessageTypeTraits<T>::enum_value;
-		auto func = [handler = std::forward<Handler>(handler)](const Ptr<net::Session>& session, const ProtocolSS::MessageRoot* message_root)
-		{
-			auto* message = message_root->message_as<T>();
-			handler(session, message);
-		};
-
-		message_handlers_.insert(std::pair<decltype(key), decltype(func)>(key, func));
-	}
-
-	//  Ʈ
+	// 메시지 핸들러 테이블. 핸들러는 void (const Ptr<net::Session>&, uint32_t correlation_id, const T* message)
+	// 응답은 요청의 correlation_id 를 그대로 돌려준다.
+	using Dispatcher = MessageDispatcher<ManagerServer, ProtocolSS::MessageRoot, ProtocolSS::MessageType, ProtocolSS::MessageTypeTraits, const Ptr<net::Session>&, uint32_t>;
+
+	// 프레임 업데이트
 	void DoUpdate(double delta_time);
 
 	void AddRemoteClient(int session_id, Ptr<RemoteManagerClient> remote_client);
@@ -135,19 +124,17 @@ private:
 	void ScheduleNextUpdate(const time_point& now, const duration& timestep);
 
 	// Handlers===================================================================================================
-	void RegisterHandlers();
-
-	void HandleMessage(const Ptr<net::Session>& session, const uint8_t* buf, size_t bytes);
+	void HandleMessage(const Ptr<net::Session>& session, uint16_t message_type, const uint8_t* buf, size_t bytes);
 	void HandleSessionOpened(const Ptr<net::Session>& session);
 	void HandleSessionClosed(const Ptr<net::Session>& session, net::CloseReason reason);
 
-    void OnRelayMessage(const Ptr<net::Session>& session, const ProtocolSS::RelayMessage* message);
+    void OnRelayMessage(const Ptr<net::Session>& session, uint32_t correlation_id, const ProtocolSS::RelayMessage* message);
 
     // Message Handlers
-	void OnLogin(const Ptr<net::Session>& session, const ProtocolSS::Request_Login* message);
-	void OnGenerateCredential(const Ptr<net::Session>& session, const ProtocolSS::Request_GenerateCredential* message);
-	void OnVerifyCredential(const Ptr<net::Session>& session, const ProtocolSS::Request_VerifyCredential* message);
-	void OnUserLogout(const Ptr<net::Session>& session, const ProtocolSS::Notify_UserLogout* message);
+	void OnLogin(const Ptr<net::Session>& session, uint32_t correlation_id, const ProtocolSS::Request_Login* message);
+	void OnGenerateCredential(const Ptr<net::Session>& session, uint32_t correlation_id, const ProtocolSS::Request_GenerateCredential* message);
+	void OnVerifyCredential(const Ptr<net::Session>& session, uint32_t correlation_id, const ProtocolSS::Request_VerifyCredential* message);
+	void OnUserLogout(const Ptr<net::Session>& session, uint32_t correlation_id, const ProtocolSS::Notify_UserLogout* message);
 
 	std::mutex mutex_;
 	
@@ -161,8 +148,10 @@ private:
 
 	std::string name_;
 
-	std::unordered_map<ProtocolSS::MessageType, MessageHandler> message_handlers_;
+	static const Dispatcher message_handlers_;
 	std::unordered_map<int, Ptr<RemoteManagerClient>> remote_clients_;
+	// 서버의 추가 연결. 추가 연결의 session id -> 처음 로그인한 연결의 session id.
+	std::unordered_map<int, int> link_sessions_;
 
 	UserSessionSet user_session_set_;
 };
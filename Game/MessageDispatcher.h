@@ -0,0 +1,63 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// 메시지 타입으로 핸들러를 찾는 테이블.
+// 메시지 타입은 flatbuffers union 의 enum 이라 NONE(0) 부터 MAX 까지 빈틈없이 이어지므로
+// 맵을 검색하지 않고 배열 인덱스로 바로 찾는다.
+// 테이블은 Make 로 컴파일 타임에 만들고 핸들러는 멤버 함수를 std::function 없이 직접 호출한다.
+//
+//   Owner      : 핸들러 멤버 함수를 가진 클래스.
+//   Root       : MessageRoot. message_as<T>() 로 메시지를 꺼낸다.
+//   Traits     : MessageTypeTraits. 메시지 클래스의 타입 값.
+//   Args...    : 메시지 앞에 넘기는 인자. 핸들러는 void (Owner::*)(Args..., const T*)
+template <typename Owner, typename Root, typename MessageType, template <typename> class Traits, typename... Args>
+class MessageDispatcher
+{
+public:
+    static constexpr size_t SIZE = static_cast<size_t>(MessageType::MAX) + 1;
+
+    // 메시지가 비어 있으면 핸들러를 부르지 않고 false.
+    using Handler = bool (*)(Owner&, Args..., const Root*);
+
+    // 메시지 클래스 T 를 멤버 함수 Method 에 연결한다.
+    template <typename T, void (Owner::*Method)(Args..., const T*)>
+    struct Bind
+    {
+        static constexpr MessageType type = Traits<T>::enum_value;
+
+        static bool Invoke(Owner& owner, Args... args, const Root* message_root)
+        {
+            auto* message = message_root->template message_as<T>();
+            if (message == nullptr)
+                return false;
+
+            (owner.*Method)(args..., message);
+            return true;
+        }
+    };
+
+    template <typename... Binds>
+    static constexpr MessageDispatcher Make()
+    {
+        MessageDispatcher dispatcher;
+        int expand[] = { 0, (dispatcher.handlers_[static_cast<size_t>(Binds::type)] = &Binds::Invoke, 0)... };
+        (void)expand;
+        return dispatcher;
+    }
+
+    // 프레임 헤더의 타입으로 찾는다. payload 를 보기 전에 부를수 있다.
+    // 타입을 알리지 않은 프레임(0)이나 등록되지 않은 타입이면 nullptr.
+    constexpr Handler Find(uint16_t type) const
+    {
+        return type < SIZE ? handlers_[type] : nullptr;
+    }
+
+    constexpr Handler Find(MessageType type) const
+    {
+        return Find(static_cast<uint16_t>(type));
+    }
+
+private:
+    Handler handlers_[SIZE] = {};
+};
\ No newline at end of file
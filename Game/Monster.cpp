@@ -93,7 +93,7 @@ void Monster::Die()
     ai_->process_event(EvDie());
     BOOST_LOG_TRIVIAL(info) << "Monster " << this->Uid() << " Die.";
 
-    //  
+    // 죽음을 통지
     PCS::World::StateInfoT data;
     //data.entity_id = uuids::to_string(GetEntityID());
     data.state = PCS::World::StateType::Dead;
@@ -133,13 +133,13 @@ void Monster::TakeDamage(const uuid& attacker, int damage)
 
     ai_->process_event(EvCombat(attacker));
 
-    //  ŭ  
+    // 방어도 만큼 데미지 감소
     damage = std::max(1, damage - Def());
     Hp(Hp() - damage);
 
     BOOST_LOG_TRIVIAL(info) << "Monster " << this->Uid() << " Take damage. Amount : " << damage;
 
-    //  
+    // 데미지를 통지
     PCS::World::DamageInfoT data;
     //data.entity_id = uuids::to_string(GetEntityID());
     data.damage = damage;
@@ -180,13 +180,14 @@ void Monster::ActionMove(const Vector3 & position, float delta_time)
         return;
 
     Vector3 target_pos(position);
-    target_pos.Y = 0.0f; // Y 0
+    target_pos.Y = 0.0f; // Y는 0
     if (GetZone() == nullptr) return;
 
     Vector3 delta = target_pos - GetPosition();
     Vector3 velocity = delta_time != 0.0f ? (delta / delta_time) : Vector3::Zero;
     
     SetPosition(target_pos);
+    SetVelocity(velocity);
     UpdateInterest();
 
     PCS::World::MoveActionInfoT move_info;
@@ -198,7 +199,7 @@ void Monster::ActionMove(const Vector3 & position, float delta_time)
     PCS::World::Notify_UpdateT update_msg;
     update_msg.entity_id = uuids::to_string(GetEntityID());
     update_msg.update_data.Set(std::move(move_info));
-    // 
+    // 통지
     PublishActorUpdate(&update_msg);
 }
 
@@ -210,12 +211,12 @@ void Monster::ActionAttack(const uuid & target)
     Zone* zone = GetZone();
     if (zone == nullptr) return;
 
-    // target ã´.
+    // target을 찾는다.
     auto actor = zone->FindActor(target);
     if (actor == nullptr)
         return;
     
-    //  ޽
+    // 통지 메시지
     PCS::World::SkillActionInfoT skill_info;
     skill_info.skill_id = 0;
     skill_info.targets.emplace_back(uuids::to_string(target));
@@ -224,10 +225,10 @@ void Monster::ActionAttack(const uuid & target)
     PCS::World::Notify_UpdateT update_msg;
     update_msg.entity_id = uuids::to_string(GetEntityID());
     update_msg.update_data.Set(std::move(skill_info));
-    // 
+    // 통지
     PublishActorUpdate(&update_msg);
  
-    //  ش.
+    // 데미지를 준다.
     ILivingEntity* entity = dynamic_cast<ILivingEntity*>(actor);
     if (entity)
     {
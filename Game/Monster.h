@@ -13,7 +13,7 @@ constexpr duration MON_ATTACK_COOL = 3s;
 
 struct MonsterAI;
 
-//   ĳ.
+// 몬스터 게임 캐릭터.
 class Monster : public Actor, public ILivingEntity
 {
 public:
@@ -39,24 +39,24 @@ sc::result Patrol::react(const EvUpdate & update)
 {
     Monster* monster = context<MonsterAI>().GetMonster();
     Zone* zone = monster->GetZone();
-    // ̵ ǥ 
+    // 이동 좌표 계산
     Vector3 orgin_position = monster->GetPosition();
     Vector3 direction = target_position_ - orgin_position;
     toNormalized(direction);
     Vector3 dest_position = monster->GetPosition() + (direction * MON_MOVE_SPEED * update.DeltaTime());
 
-    //   üũ
+    // 맵 경계 체크
     if (!zone->Contained(dest_position))
     {
         return transit<Idle>();
     }
-    // ̵  ȸ
+    // 이동 방향으로 회전
     float rotation = atan2f(dest_position.X - orgin_position.X, dest_position.Z - orgin_position.Z) * (float)(rad2deg);
     monster->SetRotation(rotation);
-    //̵
+    //이동
     monster->ActionMove(dest_position, update.DeltaTime());
 
-    // ̵ ǥ ϸ Idle ȯ
+    // 이동 목표지점에 도달하면 Idle로 전환
     if (distanceSquared(dest_position, target_position_) <= 0.1f)
     {
         return transit<Idle>();
@@ -70,12 +70,12 @@ sc::result Patrol::react(const EvNextPosition & update)
     Monster* monster = context<MonsterAI>().GetMonster();
     auto& mapData = monster->GetZone()->MapData();
 
-    //  ̵ ǥ
+    // 랜덤 이동 좌표
     std::uniform_real_distribution<float> dist{ -5.0f, 5.0f };
     std::random_device rd;
     std::default_random_engine rng{ rd() };
     Vector3 position = monster->GetPosition() + Vector3(dist(rng), 0.0f, dist(rng));
-    //   üũ
+    // 맵 경계 체크
     if (!((mapData.height > position.Z && 0 < position.Z) && (mapData.width > position.X && 0 < position.X)))
     {
         return transit<Idle>();
@@ -135,7 +135,7 @@ sc::result Chase::react(const EvUpdate & update)
     auto monster = context<MonsterAI>().GetMonster();
     auto zone = monster->GetZone();
 
-    // Ÿ ü 
+    // 타겟 객체 얻어옴
     auto target_id = context<MonsterAI>().TargetId();
     auto target_actor = zone->FindActor(target_id);
     if (target_actor == nullptr)
@@ -150,27 +150,27 @@ sc::result Chase::react(const EvUpdate & update)
     }
 
     auto target_position = target_actor->GetPosition();
-    //   Ÿ
+    // 공격 가능 거리
     float attack_range = MON_ATTACK_RANGE;
     if (distance(monster->GetPosition(), target_position) <= attack_range)
     {
         return transit<Attack>();
     }
-    // ̵ ǥ 
+    // 이동 좌표 계산
     Vector3 orgin_position = monster->GetPosition();
     Vector3 direction = target_position - orgin_position;
     toNormalized(direction);
     Vector3 dest_position = monster->GetPosition() + (direction * MON_MOVE_SPEED * update.DeltaTime());
 
-    //   üũ
+    // 맵 경계 체크
     if (!zone->Contained(dest_position))
     {
         return transit<NonCombat>();
     }
-    // ̵  ȸ
+    // 이동 방향으로 회전
     float rotation = atan2f(dest_position.X - orgin_position.X, dest_position.Z - orgin_position.Z) * (float)(rad2deg);
     monster->SetRotation(rotation);
-    //̵
+    //이동
     monster->ActionMove(dest_position, update.DeltaTime());
 
     return discard_event();
@@ -192,7 +192,7 @@ sc::result Attack::react(const EvUpdate & update)
     auto monster = context<MonsterAI>().GetMonster();
     auto zone = monster->GetZone();
 
-    // Ÿ ü 
+    // 타겟 객체 얻어옴
     auto target_id = context<MonsterAI>().TargetId();
     auto target_actor = zone->FindActor(target_id);
     if (target_actor == nullptr)
@@ -207,7 +207,7 @@ sc::result Attack::react(const EvUpdate & update)
     }
 
     auto target_position = target_actor->GetPosition();
-    //   Ÿ
+    // 공격 가능 거리
     float attack_range = MON_ATTACK_RANGE;
     if (distance(monster->GetPosition(), target_position) > attack_range)
     {
@@ -215,12 +215,12 @@ sc::result Attack::react(const EvUpdate & update)
     }
 
     Vector3 orgin_position = monster->GetPosition();
-    //   ȸ
+    // 공격 방향으로 회전
     float rotation = atan2f(target_position.X - orgin_position.X, target_position.Z - orgin_position.Z) * (float)(rad2deg);
     float prev_rot = monster->GetRotation();
     monster->SetRotation(rotation);
 
-    //  Ÿ üũ
+    // 공격 쿨타임 체크
     if (clock_type::now() < next_attack_time_)
     {
         if (prev_rot != rotation)
@@ -230,7 +230,7 @@ sc::result Attack::react(const EvUpdate & update)
         return discard_event();
     }
 
-    // 
+    // 공격
     monster->ActionAttack(target_id);
     next_attack_time_ = clock_type::now() + MON_ATTACK_COOL;
 
@@ -60,7 +60,7 @@ private:
     uuid target_id_;
 };
 
-//  
+// 비전투 상태
 struct NonCombat : sc::simple_state<NonCombat, MonsterAI, Idle>
 {
 public:
@@ -80,7 +80,7 @@ public:
     sc::result react(const EvCombat & evt);
 };
 
-// 
+// 쉼
 struct Idle : sc::simple_state<Idle, NonCombat>
 {
 public:
@@ -108,7 +108,7 @@ private:
     time_point patrol_time_;
 };
 
-// 
+// 순찰
 struct Patrol : sc::simple_state<Patrol, NonCombat>
 {
 public:
@@ -128,7 +128,7 @@ private:
     Vector3 target_position_;
 };
 
-//  
+// 전투 상태
 struct Combat : sc::simple_state<Combat, MonsterAI, Chase>
 {
 public:
@@ -144,7 +144,7 @@ public:
     }
 };
 
-// 
+// 추적
 struct Chase : sc::simple_state<Chase, Combat>
 {
 public:
@@ -155,7 +155,7 @@ public:
     sc::result react(const EvUpdate & update);
 };
 
-// 
+// 공격
 struct Attack : sc::simple_state<Attack, Combat>
 {
 public:
@@ -169,7 +169,7 @@ private:
     time_point next_attack_time_;
 };
 
-// 
+// 죽음
 struct Dead : sc::simple_state<Dead, MonsterAI>
 {
 public:
@@ -5,15 +5,15 @@ class World;
 class Zone;
 class Monster;
 
-//  
+// 몬스터 스포너
 class MonsterSpawner
 {
 public:
     MonsterSpawner(Zone* zone);
     ~MonsterSpawner();
-    //   
+    // 몬스터 생성을 시작
     void Start();
-    //  Ʈ
+    // 프레임 업데이트
     void Update(double delta_time);
 
 private:
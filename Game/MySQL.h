@@ -34,7 +34,7 @@ public:
 		return std::make_shared<MySQLPool>(url, user, password, database, connection_count, connection_charset);
 	}
 
-	// Ǯ Ŀؼ ´.
+	// 풀에서 커넥션을 가져온다.
 	ConnectionPtr GetConnection()
 	{
 		std::lock_guard<std::mutex> guard(mutex_);
@@ -52,7 +52,7 @@ public:
 		return ConnectionPtr(conn, [this, self](sql::Connection* ptr) { ReleaseConnection(ptr); });
 	}
 
-	// 񵿱  
+	// 비동기로 쿼리를 실행
 	std::future<ResultSetPtr> ExcuteAsync(const std::string& query)
 	{
 		auto self = shared_from_this();
@@ -68,7 +68,7 @@ public:
 			});
 	}
 
-	//   
+	// 동기로 쿼리를 실행
 	ResultSetPtr Excute(const std::string& query)
 	{
 		ConnectionPtr conn = GetConnection();
@@ -129,7 +129,7 @@ private:
 		return conn;
 	}
 
-	// Ŀؼ Ǯ ǵ.
+	// 커넥션을 풀로 되돌린다.
 	void ReleaseConnection(sql::Connection* conn)
 	{
 		std::lock_guard<std::mutex> guard(mutex_);
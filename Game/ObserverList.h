@@ -0,0 +1,144 @@
+#pragma once
+#include <cassert>
+
+// 단일 스레드용 침습형 관찰자 목록.
+// 관찰자 노드는 구독하는 쪽이 가지고 있으므로 구독과 해제는 O(1) 이고 할당하지 않는다.
+// 락을 사용하지 않으므로 목록과 관찰자는 같은 스레드(strand) 에서만 사용해야 한다.
+//
+// Notify 중에 관찰자를 구독하거나 해제해도 된다.
+// - 해제된 관찰자는 그 뒤로 호출되지 않는다.
+// - 새로 구독한 관찰자는 진행중인 Notify 에서는 호출되지 않는다.
+template <typename... Args>
+class ObserverList
+{
+public:
+    class Observer
+    {
+    public:
+        Observer() {}
+        ~Observer() { Unsubscribe(); }
+
+        Observer(const Observer&) = delete;
+        Observer& operator=(const Observer&) = delete;
+
+        // owner 의 Method 를 호출하도록 설정한다.
+        template <typename T, void (T::*Method)(Args...)>
+        void Bind(T* owner)
+        {
+            owner_ = owner;
+            invoke_ = &Invoke<T, Method>;
+        }
+
+        bool IsSubscribed() const { return list_ != nullptr; }
+
+        void Unsubscribe()
+        {
+            if (list_ != nullptr)
+                list_->Unlink(this);
+        }
+
+    private:
+        friend class ObserverList;
+
+        template <typename T, void (T::*Method)(Args...)>
+        static void Invoke(void* owner, Args... args)
+        {
+            (static_cast<T*>(owner)->*Method)(args...);
+        }
+
+        void* owner_ = nullptr;
+        void (*invoke_)(void*, Args...) = nullptr;
+        ObserverList* list_ = nullptr;
+        Observer* prev_ = nullptr;
+        Observer* next_ = nullptr;
+    };
+
+    ObserverList() {}
+
+    ~ObserverList()
+    {
+        assert(iterations_ == nullptr);
+        while (head_ != nullptr)
+            Unlink(head_);
+    }
+
+    // 셀처럼 vector 에 들어가는 소유자를 위해 이동만 허용한다. Notify 중에는 이동하면 안된다.
+    ObserverList(ObserverList&& other)
+        : head_(other.head_)
+    {
+        assert(other.iterations_ == nullptr);
+        other.head_ = nullptr;
+        for (Observer* observer = head_; observer != nullptr; observer = observer->next_)
+            observer->list_ = this;
+    }
+
+    ObserverList(const ObserverList&) = delete;
+    ObserverList& operator=(const ObserverList&) = delete;
+    ObserverList& operator=(ObserverList&&) = delete;
+
+    bool Empty() const { return head_ == nullptr; }
+
+    // 다른 목록을 구독중이면 먼저 해제한다.
+    void Subscribe(Observer& observer)
+    {
+        assert(observer.invoke_ != nullptr);
+        observer.Unsubscribe();
+
+        // 앞에 넣으므로 진행중인 Notify 의 커서 뒤에 오지 않는다.
+        observer.list_ = this;
+        observer.prev_ = nullptr;
+        observer.next_ = head_;
+        if (head_ != nullptr)
+            head_->prev_ = &observer;
+        head_ = &observer;
+    }
+
+    void Notify(Args... args)
+    {
+        // 다음에 호출할 관찰자를 커서에 두고 호출한다. 그 관찰자가 해제되면 Unlink 가 커서를 옮긴다.
+        Iteration iteration;
+        iteration.next = head_;
+        iteration.outer = iterations_;
+        iterations_ = &iteration;
+
+        while (iteration.next != nullptr)
+        {
+            Observer* observer = iteration.next;
+            iteration.next = observer->next_;
+            observer->invoke_(observer->owner_, args...);
+        }
+
+        iterations_ = iteration.outer;
+    }
+
+private:
+    // 진행중인 Notify 의 커서. Notify 안에서 다시 Notify 할수 있으므로 스택으로 연결한다.
+    struct Iteration
+    {
+        Observer* next;
+        Iteration* outer;
+    };
+
+    void Unlink(Observer* observer)
+    {
+        for (Iteration* iteration = iterations_; iteration != nullptr; iteration = iteration->outer)
+        {
+            if (iteration->next == observer)
+                iteration->next = observer->next_;
+        }
+
+        if (observer->prev_ != nullptr)
+            observer->prev_->next_ = observer->next_;
+        else
+            head_ = observer->next_;
+        if (observer->next_ != nullptr)
+            observer->next_->prev_ = observer->prev_;
+
+        observer->list_ = nullptr;
+        observer->prev_ = nullptr;
+        observer->next_ = nullptr;
+    }
+
+    Observer* head_ = nullptr;
+    Iteration* iterations_ = nullptr;
+};
\ No newline at end of file
@@ -1,7 +1,7 @@
 #pragma once
 #include "Common.h"
 
-//  ӵ Ʈ Ŭ̾Ʈ
+// 서버에 접속된 리모트 클라이언트
 class RemoteClient : public std::enable_shared_from_this<RemoteClient>
 {
 public:
@@ -16,26 +16,26 @@ public:
     }
     virtual ~RemoteClient() {}
     
-    // Ʈũ  ID
+    // 네트워크 세션 ID
     int GetSessionID() const
     {
         return net_session_->GetID();
     }
     
-    // Ʈũ  ü
+    // 네트워크 세션 객체
     const Ptr<net::Session>& GetSession() const
     {
         return net_session_;
     }
 
-    // ۾ ȭ 
+    // 작업을 직렬화 실행
     template <typename Handler>
     void Dispatch(Handler&& handler)
     {
-        net_session_->GetStrand().dispatch(std::forward<Handler>(handler));
+        net_session_->Dispatch(std::forward<Handler>(handler));
     }
 
-    // Ʈũ ͸ 
+    // 네트워크로 데이터를 보낸다
     void Send(const uint8_t * data, size_t size)
     {
         net_session_->Send(data, size);
@@ -47,7 +47,31 @@ public:
         net_session_->Send(std::forward<BufferT>(data));
     }
 
-    //  Ѵ.
+    // 같은 key 로 보내지 못한 메시지가 있으면 교체한다.
+    void SendLatest(uint64_t key, const Ptr<net::SendBuffer>& data)
+    {
+        net_session_->SendLatest(key, data);
+    }
+
+    // channel 을 골라서 보낸다. Unreliable 은 UDP 가 바인드되지 않았으면 SendLatest 로 보낸다.
+    void Send(net::Channel channel, uint64_t key, const Ptr<net::SendBuffer>& data)
+    {
+        net_session_->Send(channel, key, data);
+    }
+
+    // Send 한 메시지를 모아 두었다가 Flush 할때 한번에 보낸다.
+    void SetCorked(bool corked)
+    {
+        net_session_->SetCorked(corked);
+    }
+
+    // 모아둔 메시지를 바로 보낸다.
+    void Flush()
+    {
+        net_session_->Flush();
+    }
+
+    // 연결을 종료한다.
     void Disconnect()
     {
         net_session_->Close();
@@ -58,7 +82,7 @@ public:
         return !net_session_->IsOpen();
     }
 
-    // Ŭ̾Ʈ   callback.  Ŭ  Ѵ.
+    // 클라이언트에서 연결을 끊었을때 callback. 하위 클래스에서 재정의 한다.
     virtual void OnDisconnected() {};
 
 private:
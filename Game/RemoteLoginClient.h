@@ -7,7 +7,7 @@ namespace fb = flatbuffers;
 namespace db = db_schema;
 
 
-// α   Ʈ Ŭ̾Ʈ.
+// 로그인 서버에 접속한 리모트 클라이언트.
 class RemoteLoginClient : public RemoteClient
 {
 public:
@@ -29,7 +29,7 @@ public:
 		Dispose();
 	}
 
-    //  ó.  DB Update   Ѵ.
+    // 종료 처리. 상태 DB Update 등 을 한다.
     void Dispose()
     {
         bool exp = false;
@@ -41,29 +41,29 @@ public:
 		return disposed_;
 	}
 
-    //  
+    // 계정 정보
 	const Ptr<db::Account>& GetAccount() const
 	{
 		return db_account_;
 	}
 
-    //  
+    // 인증서 저장
     void Authenticate(uuid credential)
     {
         credential_ = credential;
     }
-    //  Ȯ
+    // 인증 확인
 	bool IsAuthenticated() const
 	{
 		return !credential_.is_nil();
 	}
-    // 
+    // 인증서
 	const uuid& GetCredential() const
 	{
 		return credential_;
 	}
 
-    // Ŭ̾Ʈ   callback
+    // 클라이언트에서 연결을 끊었을때 callback
 	virtual void OnDisconnected() override
 	{
 		Dispose();
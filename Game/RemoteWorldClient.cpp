@@ -5,6 +5,7 @@
 #include "Hero.h"
 #include "Monster.h"
 #include "CachedResources.h"
+#include "Settings.h"
 #include "protocol_cs_helper.h"
 
 RemoteWorldClient::RemoteWorldClient(const Ptr<net::Session>& net_session, WorldServer * owner)
@@ -25,12 +26,12 @@ World * RemoteWorldClient::GetWorld() { return owner_->GetWorld(); }
 
 void RemoteWorldClient::UpdateToDB()
 {
-    // ɸ  DB Update.
+    // 케릭터 상태 DB Update.
     if (hero_)
         hero_->UpdateToDB(GetDB());
 }
 
-//  ó.  DB Update   Ѵ.
+// 종료 처리. 상태 DB Update 등 을 한다.
 void RemoteWorldClient::Dispose()
 {
     bool exp = false;
@@ -42,7 +43,7 @@ void RemoteWorldClient::Dispose()
 
 void RemoteWorldClient::EnterWorld()
 {
-    //  ° ƴ
+    // 입장전 상태가 아님
     if (GetState() != RemoteWorldClient::State::Connected)
     {
         PCS::World::Notify_EnterFailedT reply_msg;
@@ -59,10 +60,10 @@ void RemoteWorldClient::EnterWorld()
         PCS::Send(*this, reply);
         return;
     }
-    // ĳ͸ ϰ ó ϴ 
+    // 캐릭터를 생성하고 처음 입장하는 경우
     if (db_hero->map_id == 0)
     {
-        //   ã´.
+        // 시작 지점을 찾는다.
         auto spawn_table = HeroSpawnTable::GetInstance().GetAll();
         auto iter = std::find_if(spawn_table.begin(), spawn_table.end(), [](auto& value) {
             return (value.second.map_id == 1001);
@@ -74,38 +75,41 @@ void RemoteWorldClient::EnterWorld()
             PCS::Send(*this, reply);
             return;
         }
-        // , ǥ 
+        // 맵, 좌표 셋
         db_hero->map_id = iter->second.map_id;
         db_hero->pos = iter->second.pos;
     }
 
-    // ̹ ĳͰ ִ°
+    // 이미 캐릭터가 생성되있는경우
     if (hero_ != nullptr)
     {
-        //ʿ ѹ ǹǷ ߸ 
+        //최초에 한번 생성되므로 잘못된 접근
         PCS::World::Notify_EnterFailedT reply;
         reply.error_code = PCS::ErrorCode::WORLD_CANNOT_ENTER_ZONE;
         PCS::Send(*this, reply);
         return;
     }
 
-    // ĳ νϽ 
+    // 캐릭터 인스턴스 생성
     auto hero = std::make_shared<Hero>(random_generator()(), this);
     hero->Init(*db_hero);
     hero_ = hero;
-    // ڵ鷯 
+    // 핸들러 등록
     hero->enter_zone_signal.connect([this](Zone* zone)
     {
         BOOST_LOG_TRIVIAL(info) << "On Hero " << hero_->GetName() << "Enter Zone.";
 
-        //   
+        // 관심 지역을 만든다
         interest_area_ = std::make_shared<ClientInterestArea>(this, zone);
-        interest_area_->ViewDistance(Vector3(20.0f, 1.0f, 20.0f));
+        // 경계에서 나타남/사라짐이 반복되지 않도록 나가는 반경을 반 셀 더 크게 한다.
+        interest_area_->ViewRadius(20.0f, 20.0f + CELL_SIZE * 0.5f);
+        interest_area_->ReplicationTiers(Settings::GetInstance().ReplicationLod(zone->MapType()));
+        interest_area_->SnapshotReplication(Settings::GetInstance().snapshot_replication);
 
     });
     hero->poistion_update_signal.connect([this](const Vector3& position)
     {
-        //   Ʈ
+        // 관심 지역을 업데이트
         if (interest_area_)
         {
             interest_area_->Position(position);
@@ -116,7 +120,7 @@ void RemoteWorldClient::EnterWorld()
     {
         BOOST_LOG_TRIVIAL(info) << "On Hero " << hero_->GetName() << "Exit Zone .";
 
-        //  
+        // 관심지역 해제
         interest_area_ = nullptr;
     });
     hero->ConnectDeathSignal(std::bind(&RemoteWorldClient::OnHeroDeath, this));
@@ -125,7 +129,7 @@ void RemoteWorldClient::EnterWorld()
 
     BOOST_LOG_TRIVIAL(info) << "World Entring . account_uid : " << GetAccount()->uid << " hero_name: " << hero->GetName();
     
-    //  
+    // 월드 입장
     EnterZone(hero, hero->MapId(), hero->GetPosition(), [this](bool success)
     {
         if (success)
@@ -139,7 +143,7 @@ void RemoteWorldClient::EnterWorld()
     });
 }
 
-// ޽ ó
+// 메시지 처리
 void RemoteWorldClient::ActionMove(const PCS::World::Request_ActionMove * message)
 {
     assert(message);
@@ -190,13 +194,13 @@ void RemoteWorldClient::ActionSkill(const PCS::World::Request_ActionSkill * mess
 
 void RemoteWorldClient::RespawnImmediately()
 {
-    //  ˻
+    // 조건 검사
     if (!(hero_ && hero_->IsDead()))
         return;
 
     if (respawn_timer_)
     {
-        //  Ÿ̸ 
+        // 리스폰 타이머 취소
         respawn_timer_->cancel();
         respawn_timer_.reset();
     }
@@ -246,7 +250,7 @@ void RemoteWorldClient::EnterGate(const PCS::World::Request_EnterGate * message)
 
     int dest_map_id = dest_gate->map_id;
 
-    //  ̵ ǥ
+    // 랜덤 이동 좌표
     std::vector<float> b{ -3.0f, -2.0f, 2.0f, 3.0f };
     std::vector<float> w{ 10, 0, 10 };
     std::piecewise_constant_distribution<float> dist{ b.begin(), b.end(), w.begin() };
@@ -268,7 +272,7 @@ void RemoteWorldClient::ExitWorld()
     {
         ExitZone(hero_);
     }
-    // DB Ʈ
+    // DB 업데이트
     UpdateToDB();
 }
 
@@ -279,7 +283,7 @@ void RemoteWorldClient::EnterZone(const Ptr<Hero>& hero, int map_id, const Vecto
         auto map_data = MapTable::GetInstance().Get(map_id);
         if (!map_data)
         {
-            //  ޽
+            // 실패 메시지
             PCS::World::Notify_EnterFailedT reply;
             reply.error_code = PCS::ErrorCode::WORLD_CANNOT_FIND_ZONE;
             PCS::Send(*this, reply);
@@ -295,25 +299,25 @@ void RemoteWorldClient::EnterZone(const Ptr<Hero>& hero, int map_id, const Vecto
         bool result = false;
         Zone* zone = nullptr;
         Vector3 pos = position;
-        // νϽ 
+        // 인스턴스 던전
         if (map_data->type == MapType::Dungeon)
         {
             InstanceZone* ins_zone = nullptr;
-            // ĳͰ ־ δ ã´.
+            // 캐릭터가 있었던 인던을 찾는다.
             if (!std::get<0>(hero->instance_zone_).is_nil() && std::get<1>(hero->instance_zone_) == map_id)
             {
                 ins_zone = GetWorld()->FindInstanceZone(std::get<0>(hero->instance_zone_));
             }
-            //   .
+            // 없으면 새로 만든다.
             if (ins_zone == nullptr)
             {
                 ins_zone = GetWorld()->CreateInstanceZone(map_id);
 
-                // ⱸ ã´.
+                // 출구를 찾는다.
                 auto iter = ins_zone->GetGates().begin();
                 if (iter != ins_zone->GetGates().end())
                 {
-                    //   ǥ
+                    // 랜덤 시작 좌표
                     std::vector<float> b{ -3.0f, -2.0f, 2.0f, 3.0f };
                     std::vector<float> w{ 10, 0, 10 };
                     std::piecewise_constant_distribution<float> dist{ b.begin(), b.end(), w.begin() };
@@ -325,29 +329,29 @@ void RemoteWorldClient::EnterZone(const Ptr<Hero>& hero, int map_id, const Vecto
 
             zone = ins_zone;
         }
-        // ʵ 
+        // 필드 존
         else if (map_data->type == MapType::Field)
         {
-            // ʵ ã´.
+            // 필드존을 찾는다.
             zone = GetWorld()->FindFieldZone(map_id);
         }
 
         if (zone)
         {
-            //   ޽ 
-            fb::FlatBufferBuilder fbb;
+            // 입장 성공 메시지를 보낸다
+            fb::FlatBufferBuilder fbb(BUILDER_INITIAL_SIZE, &PooledBuilderAllocator::Instance());
             auto offset_msg = PCS::World::CreateNotify_EnterSuccess(fbb,
                 hero->SerializeAsHero(fbb),
                 zone->Serialize(fbb));
             PCS::Send(*this, fbb, offset_msg);
             result = true;
             
-            // 
+            // 입장
             zone->Enter(hero, pos);
         }
         else
         {
-            //  ޽
+            // 실패 메시지
             PCS::World::Notify_EnterFailedT reply;
             reply.error_code = PCS::ErrorCode::WORLD_CANNOT_FIND_ZONE;
             PCS::Send(*this, reply);
@@ -364,7 +368,7 @@ void RemoteWorldClient::EnterZone(const Ptr<Hero>& hero, int map_id, const Vecto
 
 void RemoteWorldClient::ExitZone(const Ptr<Hero>& hero, std::function<void()> handler)
 {
-    // .
+    // 나간다.
     GetWorld()->Dispatch([this, hero = hero, handler = std::move(handler)]
     {
         Zone* zone = hero->GetZone();
@@ -389,7 +393,7 @@ void RemoteWorldClient::Respawn(const Ptr<Hero> hero)
     Zone* zone = hero->GetZone();
     if (zone->MapType() == MapType::Field)
     {
-        //   ã´.
+        // 시작 지점을 찾는다.
         auto spawn_table = HeroSpawnTable::GetInstance().GetAll();
         auto iter = std::find_if(spawn_table.begin(), spawn_table.end(), [&](auto& value) {
             return (value.second.map_id == hero->MapId());
@@ -402,12 +406,12 @@ void RemoteWorldClient::Respawn(const Ptr<Hero> hero)
     }
     else if (zone->MapType() == MapType::Dungeon)
     {
-        // ⱸ ã´.
+        // 출구를 찾는다.
         auto iter = zone->GetGates().begin();
         if (iter == zone->GetGates().end())
             return;
 
-        //   ǥ
+        // 랜덤 시작 좌표
         std::vector<float> b{ -3.0f, -2.0f, 2.0f, 3.0f };
         std::vector<float> w{ 10, 0, 10 };
         std::piecewise_constant_distribution<float> dist{ b.begin(), b.end(), w.begin() };
@@ -416,12 +420,12 @@ void RemoteWorldClient::Respawn(const Ptr<Hero> hero)
         pos = iter->second->pos + Vector3(dist(rng), 0.0f, dist(rng));
     }
 
-    hero->Hp(hero->MaxHp()); // HP ȸ
+    hero->Hp(hero->MaxHp()); // HP 회복
     hero->Spawn(pos);
 
     BOOST_LOG_TRIVIAL(info) << "Spawn Hero : " << hero->GetName();
 
-    // ֺ 
+    // 주변에 통지
     PCS::World::ActorT actor_data;
     hero->SerializeT(actor_data);
     PCS::World::Notify_UpdateT update_msg;
@@ -444,7 +448,7 @@ void RemoteWorldClient::OnHeroDeath()
 
     BOOST_LOG_TRIVIAL(info) << "On DeathSignal. " << hero_->GetName();
 
-    // 10 
+    // 10초후 리스폰
     respawn_timer_ = GetWorld()->RunAfter(10s, [this, hero = hero_](auto& timer) {
         Respawn(hero);
     });
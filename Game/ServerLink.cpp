@@ -0,0 +1,302 @@
+#include "stdafx.h"
+#include "ServerLink.h"
+
+namespace PSS = ProtocolSS;
+
+ServerLink::ServerLink(const net::ClientConfig& config, size_t connection_count, const duration& request_timeout)
+    : ev_loop_(config.event_loop ? config.event_loop : std::make_shared<net::EventLoop>(1))
+    , timeout_timer_(ev_loop_->GetIoContext())
+{
+    // 모든 연결이 같은 EventLoop 를 사용한다.
+    net::ClientConfig link_config = config;
+    link_config.event_loop = ev_loop_;
+
+    connections_.resize(std::max<size_t>(connection_count, 1));
+    for (size_t i = 0; i < connections_.size(); i++)
+    {
+        auto client = net::NetClient::Create(link_config);
+        client->RegisterNetEventHandler([this, i](const net::NetEventType& et) { HandleNetEvent(i, et); });
+        client->RegisterMessageHandler([this, i](uint16_t /*message_type*/, const uint8_t* buf, size_t bytes) { HandleMessage(i, buf, bytes); });
+        connections_[i].client = client;
+    }
+
+    auto timeout = std::chrono::duration_cast<std::chrono::milliseconds>(request_timeout);
+    timeout_ticks_ = std::max<uint64_t>((timeout + TIMEOUT_TICK - 1ms) / TIMEOUT_TICK, 1);
+}
+
+ServerLink::~ServerLink()
+{
+    Close();
+}
+
+void ServerLink::Connect(size_t index, const std::string& address, uint16_t port)
+{
+    if (index >= connections_.size())
+        return;
+
+    // 타이머 핸들러가 weak_ptr 을 잡아야 하므로 생성자에서 시작하지 않는다.
+    if (!timeout_started_.exchange(true))
+    {
+        timeout_start_time_ = std::chrono::steady_clock::now();
+        ScheduleTimeout();
+    }
+
+    connections_[index].client->Connect(address, std::to_string(port));
+}
+
+void ServerLink::Close()
+{
+    if (closed_.exchange(true))
+        return;
+
+    boost::system::error_code ec;
+    timeout_timer_.cancel(ec);
+
+    for (auto& connection : connections_)
+    {
+        connection.client->Close();
+    }
+
+    // 닫은 뒤에 도착하는 Closed 이벤트를 기다리지 않고 바로 실패시킨다.
+    for (size_t i = 0; i < connections_.size(); i++)
+    {
+        FailRequests(i);
+    }
+}
+
+void ServerLink::SetReady(size_t index, bool ready)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (index < connections_.size())
+        connections_[index].ready = ready;
+}
+
+bool ServerLink::IsReady(size_t index)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return index < connections_.size() && connections_[index].ready;
+}
+
+size_t ServerLink::Affinity(uint64_t key)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t index = static_cast<size_t>(key % connections_.size());
+    auto& connection = connections_[index];
+    if (connection.ready && connection.client->IsConnected())
+        return index;
+
+    // 다른 연결로 보내면 같은 key 의 메시지 순서가 바뀔수 있다.
+    BOOST_LOG_TRIVIAL(info) << "Affinity connection is not ready. key: " << key << " connection: " << index;
+    return ANY_CONNECTION;
+}
+
+Ptr<net::NetClient> ServerLink::GetConnection(size_t index)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (index == ANY_CONNECTION)
+        index = SelectConnection();
+
+    if (index >= connections_.size() || !connections_[index].client->IsConnected())
+        return nullptr;
+
+    return connections_[index].client;
+}
+
+size_t ServerLink::GetPendingCount()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_requests_.size();
+}
+
+Ptr<net::NetClient> ServerLink::AddRequest(size_t index, const ReplyHandler& handler, uint32_t& correlation_id)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closed_.load())
+        return nullptr;
+
+    if (index == ANY_CONNECTION)
+        index = SelectConnection();
+
+    if (index >= connections_.size() || !connections_[index].client->IsConnected())
+        return nullptr;
+
+    // 0 은 응답이 필요없는 메시지에 쓴다.
+    if (++next_correlation_id_ == 0)
+        ++next_correlation_id_;
+    correlation_id = next_correlation_id_;
+
+    auto request = std::make_unique<PendingRequest>();
+    request->correlation_id = correlation_id;
+    request->index = index;
+    request->handler = handler;
+    timeout_wheel_.Schedule(request.get(), timeout_ticks_);
+    pending_requests_.emplace(correlation_id, std::move(request));
+
+    auto& connection = connections_[index];
+    connection.in_flight++;
+    return connection.client;
+}
+
+void ServerLink::FailRequests(size_t index)
+{
+    std::vector<std::unique_ptr<PendingRequest>> failed;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto iter = pending_requests_.begin(); iter != pending_requests_.end(); )
+        {
+            if (iter->second->index == index)
+            {
+                timeout_wheel_.Cancel(iter->second.get());
+                failed.emplace_back(std::move(iter->second));
+                iter = pending_requests_.erase(iter);
+            }
+            else
+            {
+                ++iter;
+            }
+        }
+        connections_[index].in_flight = 0;
+    }
+
+    for (auto& request : failed)
+    {
+        request->handler(nullptr);
+    }
+}
+
+// 락을 잡은 상태에서 호출한다.
+size_t ServerLink::SelectConnection()
+{
+    // 응답을 기다리는 요청이 가장 적은 연결. 같으면 돌아가면서 고른다.
+    size_t selected = ANY_CONNECTION;
+    size_t count = connections_.size();
+    size_t start = next_correlation_id_ % count;
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t index = (start + i) % count;
+        auto& connection = connections_[index];
+        if (!connection.ready || !connection.client->IsConnected())
+            continue;
+
+        if (selected == ANY_CONNECTION || connection.in_flight < connections_[selected].in_flight)
+            selected = index;
+    }
+
+    return selected;
+}
+
+void ServerLink::HandleNetEvent(size_t index, const net::NetEventType& et)
+{
+    if (net::NetEventType::Opened != et)
+    {
+        SetReady(index, false);
+        FailRequests(index);
+    }
+
+    if (net_event_handler_)
+        net_event_handler_(index, et);
+}
+
+void ServerLink::HandleMessage(size_t index, const uint8_t* buf, size_t bytes)
+{
+    // flatbuffer 메시지로 디시리얼라이즈
+    flatbuffers::Verifier verifier(buf, bytes);
+    if (!PSS::VerifyMessageRootBuffer(verifier))
+    {
+        BOOST_LOG_TRIVIAL(info) << "Invalid MessageRoot. connection: " << index << " bytes: " << bytes;
+        return;
+    }
+    const auto* message_root = PSS::GetMessageRoot(buf);
+
+    try
+    {
+        uint32_t correlation_id = message_root->correlation_id();
+        if (correlation_id == 0)
+        {
+            if (message_handler_)
+                message_handler_(index, message_root);
+            return;
+        }
+
+        std::unique_ptr<PendingRequest> request;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto iter = pending_requests_.find(correlation_id);
+            if (iter != pending_requests_.end())
+            {
+                request = std::move(iter->second);
+                pending_requests_.erase(iter);
+                timeout_wheel_.Cancel(request.get());
+                connections_[request->index].in_flight--;
+            }
+        }
+
+        // 이미 제한 시간이 지나서 실패 처리된 요청의 응답.
+        if (!request)
+        {
+            BOOST_LOG_TRIVIAL(info) << "Late reply. correlation_id: " << correlation_id << " message_type: " << PSS::EnumNameMessageType(message_root->message_type());
+            return;
+        }
+
+        request->handler(message_root);
+    }
+    catch (std::exception& e)
+    {
+        BOOST_LOG_TRIVIAL(info) << "Exception: " << e.what();
+    }
+}
+
+void ServerLink::ScheduleTimeout()
+{
+    timeout_timer_.expires_at(timeout_start_time_ + TIMEOUT_TICK * (timeout_wheel_.Now() + 1));
+    // 타이머가 완료된 뒤 핸들러가 실행되기 전에 ServerLink 가 해제될수 있다.
+    std::weak_ptr<ServerLink> weak_self = shared_from_this();
+    timeout_timer_.async_wait([weak_self](const boost::system::error_code& error)
+    {
+        auto self = weak_self.lock();
+        if (error || !self || self->closed_.load())
+            return;
+
+        self->HandleTimeout();
+        self->ScheduleTimeout();
+    });
+}
+
+void ServerLink::HandleTimeout()
+{
+    std::vector<std::unique_ptr<PendingRequest>> expired;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        std::vector<PendingRequest*> entries;
+        auto on_expire = [&entries](net::TimerWheel::Entry* entry) -> uint64_t
+        {
+            entries.emplace_back(static_cast<PendingRequest*>(entry));
+            return 0;
+        };
+
+        // 타이머가 늦게 불렸으면 밀린 틱을 모두 처리한다.
+        uint64_t target = (std::chrono::steady_clock::now() - timeout_start_time_) / TIMEOUT_TICK;
+        while (timeout_wheel_.Now() < target)
+        {
+            timeout_wheel_.Tick(on_expire);
+        }
+
+        for (auto* entry : entries)
+        {
+            auto iter = pending_requests_.find(entry->correlation_id);
+            if (iter == pending_requests_.end())
+                continue;
+
+            connections_[entry->index].in_flight--;
+            expired.emplace_back(std::move(iter->second));
+            pending_requests_.erase(iter);
+        }
+    }
+
+    for (auto& request : expired)
+    {
+        BOOST_LOG_TRIVIAL(info) << "Request timeout. correlation_id: " << request->correlation_id << " connection: " << request->index;
+        request->handler(nullptr);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,124 @@
+#pragma once
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+#include "Common.h"
+#include "protocol_ss_generated.h"
+#include "protocol_ss_helper.h"
+
+// 다른 서버와의 연결 묶음.
+// 같은 서버로 여러 연결을 유지하고 요청을 나눠 보낸다.
+// 요청마다 correlation_id 를 붙여서 응답을 찾으므로 한 연결로 응답을 기다리지 않고 계속 보낼수 있다.
+// 제한 시간 타이머가 weak_ptr 로 참조하므로 shared_ptr 로 만든다.
+class ServerLink : public std::enable_shared_from_this<ServerLink>
+{
+public:
+    // 연결을 지정하지 않는다. 응답을 기다리는 요청이 가장 적은 연결을 고른다.
+    static constexpr size_t ANY_CONNECTION = static_cast<size_t>(-1);
+
+    // 요청의 응답. 제한 시간안에 응답이 없거나, 연결이 끊어졌거나, 보낼 연결이 없으면 nullptr.
+    using ReplyHandler = std::function<void(const ProtocolSS::MessageRoot*)>;
+    // 연결 이벤트. index 는 연결 번호.
+    using NetEventHandler = std::function<void(size_t index, const net::NetEventType&)>;
+    // 요청의 응답이 아닌 메시지.
+    using MessageHandler = std::function<void(size_t index, const ProtocolSS::MessageRoot*)>;
+
+    ServerLink(const ServerLink&) = delete;
+    ServerLink& operator=(const ServerLink&) = delete;
+
+    ServerLink(const net::ClientConfig& config, size_t connection_count, const duration& request_timeout);
+    ~ServerLink();
+
+    // 핸들러는 각 연결의 strand 에서 호출된다. Connect 전에 등록한다.
+    void RegisterNetEventHandler(const NetEventHandler& handler) { net_event_handler_ = handler; }
+    void RegisterMessageHandler(const MessageHandler& handler) { message_handler_ = handler; }
+
+    size_t GetConnectionCount() const { return connections_.size(); }
+    const Ptr<net::EventLoop>& GetEventLoop() { return ev_loop_; }
+
+    // index 연결의 접속을 시작한다. 처음 호출할때 요청 제한 시간 검사를 시작한다.
+    void Connect(size_t index, const std::string& address, uint16_t port);
+    // 모든 연결을 닫는다. 응답을 기다리던 요청은 실패한다.
+    void Close();
+
+    // 연결이 요청을 받을 준비가 됐는지 설정한다. 준비된 연결만 ANY_CONNECTION 과 Affinity 로 선택된다.
+    void SetReady(size_t index, bool ready);
+    bool IsReady(size_t index);
+
+    // 같은 key 의 메시지를 항상 같은 연결로 보내서 순서를 지킬때 사용하는 연결 번호.
+    // 그 연결이 준비되지 않았으면 로그를 남기고 ANY_CONNECTION.
+    size_t Affinity(uint64_t key);
+
+    // 보낼 연결. index 를 지정하면 연결만 되어 있으면 되고, ANY_CONNECTION 이면 준비된 연결중에서 고른다.
+    Ptr<net::NetClient> GetConnection(size_t index = ANY_CONNECTION);
+
+    // 응답을 받는 요청을 보낸다. handler 는 성공, 실패와 상관없이 꼭 한번 호출된다.
+    template <typename T>
+    bool Request(size_t index, const T& message, ReplyHandler handler)
+    {
+        uint32_t correlation_id = 0;
+        auto client = AddRequest(index, handler, correlation_id);
+        if (!client)
+        {
+            handler(nullptr);
+            return false;
+        }
+
+        ProtocolSS::Send(*client, message, correlation_id);
+        return true;
+    }
+
+    // 응답을 기다리고 있는 요청 수.
+    size_t GetPendingCount();
+
+private:
+    // 제한 시간을 검사하는 간격.
+    static constexpr std::chrono::milliseconds TIMEOUT_TICK{ 10 };
+
+    struct Connection
+    {
+        Ptr<net::NetClient> client;
+        bool ready = false;
+        // 응답을 기다리는 요청 수.
+        size_t in_flight = 0;
+    };
+
+    // 응답을 기다리는 요청. 제한 시간은 TimerWheel 로 관리한다.
+    struct PendingRequest : public net::TimerWheel::Entry
+    {
+        uint32_t correlation_id = 0;
+        size_t index = 0;
+        ReplyHandler handler;
+    };
+
+    // 요청을 등록하고 보낼 연결을 고른다. 보낼 연결이 없으면 nullptr.
+    Ptr<net::NetClient> AddRequest(size_t index, const ReplyHandler& handler, uint32_t& correlation_id);
+    // 연결이 끊어지면 그 연결로 보낸 요청을 모두 실패시킨다.
+    void FailRequests(size_t index);
+    size_t SelectConnection();
+
+    void HandleNetEvent(size_t index, const net::NetEventType& et);
+    void HandleMessage(size_t index, const uint8_t* buf, size_t bytes);
+
+    void ScheduleTimeout();
+    void HandleTimeout();
+
+    std::mutex mutex_;
+
+    Ptr<net::EventLoop> ev_loop_;
+    std::vector<Connection> connections_;
+    std::atomic<bool> closed_{ false };
+
+    NetEventHandler net_event_handler_;
+    MessageHandler message_handler_;
+
+    uint32_t next_correlation_id_ = 0;
+    std::unordered_map<uint32_t, std::unique_ptr<PendingRequest>> pending_requests_;
+
+    uint64_t timeout_ticks_;
+    net::TimerWheel timeout_wheel_;
+    boost::asio::steady_timer timeout_timer_;
+    std::atomic<bool> timeout_started_{ false };
+    std::chrono::steady_clock::time_point timeout_start_time_;
+};
\ No newline at end of file
@@ -1,47 +1,102 @@
 #pragma once
 #include <iostream>
 #include <fstream>
+#include <sstream>
+#include <vector>
 #include <locale>
 #include <codecvt>
 #include <boost\program_options.hpp>
 #include "Singleton.h"
+#include "TypeDef.h"
 
 namespace po = boost::program_options;
 
-//   
+// 전역 서버 설정
 class Settings : public Singleton<Settings>
 {
 public:
-	std::string   name; //  ̸
+	std::string   name; // 서버 이름
 	std::string   bind_address;
 	uint16_t      bind_port;
 	size_t        thread_count;
+	bool          io_context_per_thread; // 스레드마다 io_context 를 따로 실행
+	std::string   session_affinity; // io_context_per_thread 일때 세션 배정 방법 (round-robin, least-load)
+	size_t        spin_time; // 처리할 것이 없어도 블록하지 않고 poll 하는 시간(us) (0 이면 바로 블록)
+	std::vector<int> cpu_affinity; // 네트워크 스레드를 차례대로 고정할 코어 목록 (비어 있으면 고정 안함)
 	size_t        max_session_count;
+	size_t        accept_count; // 동시에 대기하는 accept 수
+	bool          reuse_port; // 스레드마다 SO_REUSEPORT acceptor 사용
 	size_t	      min_receive_size;
 	size_t	      max_receive_buffer_size;
+	bool	      shared_receive_buffer; // 스레드 공용 수신 버퍼 사용
+	bool	      io_uring; // io_context_per_thread 일때 io_uring 으로 읽고 씀 (Linux)
 	bool	      no_delay; // tcp nodelay option
-	std::string   db_host; // DB  ּ
+	bool	      cork; // 월드 서버에서 틱 동안 보낼 메시지를 모아서 보냄
+	size_t	      cork_threshold; // 모인 크기가 이 값을 넘으면 틱을 기다리지 않고 보냄
+	size_t	      max_send_buffer_size; // 보내지 못하고 쌓인 데이터의 최대 크기
+	size_t	      compress_threshold; // payload 가 이 크기 이상이면 압축해서 보냄 (0 이면 압축 안함)
+	size_t	      idle_timeout; // 이 시간(ms) 동안 받은 데이터가 없으면 연결을 끊음 (0 이면 검사 안함)
+	size_t	      max_frames_per_read; // 한번 받은 데이터에서 처리하는 최대 메시지 수. 넘으면 다른 세션에 양보 (0 이면 제한 안함)
+	double	      message_rate; // 세션이 보낼수 있는 초당 메시지 수 (0 이면 제한 안함)
+	double	      message_burst; // 한번에 몰아서 보낼수 있는 메시지 수 (0 이면 message_rate 와 같음)
+	double	      action_rate; // 월드 서버에서 세션이 보낼수 있는 초당 이동, 스킬 요청 수 (0 이면 제한 안함)
+	size_t	      max_rate_violations; // 비율 제한을 넘은 메시지가 이 수에 이르면 연결을 끊음 (0 이면 끊지 않음)
+	size_t	      heartbeat_interval; // Manager 서버 연결에 heartbeat 를 보내는 간격(ms) (0 이면 보내지 않음)
+	size_t	      stats_log_interval; // 네트워크 통계와 송신 큐가 밀린 세션을 로그로 남기는 간격(ms) (0 이면 남기지 않음)
+	bool	      udp_channel; // 월드 서버에서 이동 갱신을 UDP 로 보냄
+	size_t	      max_datagram_size; // UDP 데이터그램 최대 크기. 넘는 메시지는 TCP 로 보냄
+	std::vector<ReplicationTier> replication_lod_field; // 필드 맵에서 거리별 이동 갱신 주기 (비어 있으면 매 틱)
+	std::vector<ReplicationTier> replication_lod_dungeon; // 던전 맵에서 거리별 이동 갱신 주기 (비어 있으면 매 틱)
+	bool	      snapshot_replication; // 월드 서버에서 이동을 바뀐 필드만 양자화한 MoveSnapshot 으로 모아서 보냄
+	std::string   db_host; // DB 접속 주소
 	std::string   db_user;
 	std::string   db_password;
 	std::string   db_schema;
 	size_t        db_connection_pool;
-	std::string	  manager_address; // Ŵ   ּ
-	uint16_t      manager_port; // Ŵ   Ʈ
+	std::string	  manager_address; // 매니저 서버 접속 주소
+	uint16_t      manager_port; // 매니저 서버 접속 포트
+	size_t	      manager_connections; // 매니저 서버와 유지하는 연결 수
+	size_t	      manager_request_timeout; // 매니저 서버 요청의 응답을 기다리는 시간(ms)
 
 	template <typename CharT>
 	bool Load(CharT* filepath)
 	{
-		// step 1 : ɼ  
+		// step 1 : 옵션 설명 정의
 		po::options_description desc("Allowed options");
 		desc.add_options()
 			("Server.name", po::value<std::string>(&name)->default_value(""))
 			("Server.bind-address", po::value<std::string>(&bind_address)->default_value("0.0.0.0"))
 			("Server.bind-port", po::value<uint16_t>())
 			("Server.thread", po::value<size_t>(&thread_count)->default_value(std::thread::hardware_concurrency()))
+			("Server.io-context-per-thread", po::value<bool>(&io_context_per_thread)->default_value(false))
+			("Server.session-affinity", po::value<std::string>(&session_affinity)->default_value("round-robin"))
+			("Server.spin-time", po::value<size_t>(&spin_time)->default_value(0))
+			("Server.cpu-affinity", po::value<std::string>()->default_value(""))
+			("Server.accept-count", po::value<size_t>(&accept_count)->default_value(1))
+			("Server.reuse-port", po::value<bool>(&reuse_port)->default_value(false))
 			("Server.max-session", po::value<size_t>(&max_session_count)->default_value(10000))
 			("Server.min-receive-size", po::value<size_t>(&min_receive_size)->default_value(1024 * 4))
 			("Server.max-buffer-size", po::value<size_t>(&max_receive_buffer_size)->default_value(std::numeric_limits<size_t>::max()))
+			("Server.shared-receive-buffer", po::value<bool>(&shared_receive_buffer)->default_value(false))
+			("Server.io-uring", po::value<bool>(&io_uring)->default_value(false))
 			("Server.no-delay", po::value<bool>(&no_delay)->default_value(false))
+			("Server.cork", po::value<bool>(&cork)->default_value(false))
+			("Server.max-send-buffer-size", po::value<size_t>(&max_send_buffer_size)->default_value(std::numeric_limits<size_t>::max()))
+			("Server.cork-threshold", po::value<size_t>(&cork_threshold)->default_value(1024 * 16))
+			("Server.compress-threshold", po::value<size_t>(&compress_threshold)->default_value(0))
+			("Server.idle-timeout", po::value<size_t>(&idle_timeout)->default_value(0))
+			("Server.max-frames-per-read", po::value<size_t>(&max_frames_per_read)->default_value(0))
+			("Server.message-rate", po::value<double>(&message_rate)->default_value(0))
+			("Server.message-burst", po::value<double>(&message_burst)->default_value(0))
+			("Server.action-rate", po::value<double>(&action_rate)->default_value(0))
+			("Server.max-rate-violations", po::value<size_t>(&max_rate_violations)->default_value(0))
+			("Server.heartbeat-interval", po::value<size_t>(&heartbeat_interval)->default_value(0))
+			("Server.stats-log-interval", po::value<size_t>(&stats_log_interval)->default_value(0))
+			("Server.udp-channel", po::value<bool>(&udp_channel)->default_value(false))
+			("Server.max-datagram-size", po::value<size_t>(&max_datagram_size)->default_value(1200))
+			("Server.replication-lod-field", po::value<std::string>()->default_value("10:1,20:2,25:4"))
+			("Server.replication-lod-dungeon", po::value<std::string>()->default_value(""))
+			("Server.snapshot-replication", po::value<bool>(&snapshot_replication)->default_value(false))
 			("DB.host", po::value<std::string>())
 			("DB.user", po::value<std::string>())
 			("DB.password", po::value<std::string>())
@@ -49,9 +104,11 @@ public:
 			("DB.conn-pool", po::value<size_t>(&db_connection_pool)->default_value(1))
 			("Manager.address", po::value<std::string>(&manager_address)->default_value("0.0.0.0"))
 			("Manager.port", po::value<uint16_t>(&manager_port)->default_value(0))
+			("Manager.connections", po::value<size_t>(&manager_connections)->default_value(4))
+			("Manager.request-timeout", po::value<size_t>(&manager_request_timeout)->default_value(5000))
 			;
 
-		// step 2 : ɼ м
+		// step 2 :명령행 옵션 분석
 		po::variables_map vm;
 		try
 		{
@@ -67,25 +124,25 @@ public:
 		}
 		catch (po::unknown_option & e)
 		{
-			//  1:  ɼ  
+			// 예외 1: 없는 옵션을 사용한 경우
 			std::cerr << e.what() << "\n";
 			return false;
 		}
 		catch (po::invalid_option_value & e)
 		{
-			//  2: ɼ   ߻ 
+			// 예외 2: 옵션 값의 오류가 발생한 경우
 			std::cerr << e.what() << std::endl;
 			return false;
 		}
 		catch (po::invalid_command_line_syntax & e)
 		{
-			//  3: ɼ   
+			// 예외 3: 옵션 값이 없을 경우
 			std::cerr << e.what() << "\n";
 			return false;
 		}
         catch (po::reading_file & e)
         {
-            //  4:  open 
+            // 예외 4: 파일 open 실패
             std::cerr << e.what() << "\n";
             return false;
         }
@@ -97,7 +154,7 @@ public:
 
 		po::notify(vm);
 
-		// step 3 : ɼ ó
+		// step 3 : 옵션 처리
 		if (vm.count("Server.bind-port"))
 		{
 			bind_port = vm["Server.bind-port"].as<uint16_t>();
@@ -108,6 +165,42 @@ public:
 			return false;
 		}
 
+		if (session_affinity != "round-robin" && session_affinity != "least-load")
+		{
+			std::cerr << "Server.session-affinity must be round-robin or least-load" << "\n";
+			return false;
+		}
+
+		// 쉼표로 구분한 코어 번호. 예) 0,2,4,6
+		cpu_affinity.clear();
+		std::stringstream cpus(vm["Server.cpu-affinity"].as<std::string>());
+		std::string cpu;
+		while (std::getline(cpus, cpu, ','))
+		{
+			if (cpu.empty())
+				continue;
+			try
+			{
+				cpu_affinity.push_back(std::stoi(cpu));
+			}
+			catch (std::exception&)
+			{
+				std::cerr << "Server.cpu-affinity must be a comma separated list of cpu numbers" << "\n";
+				return false;
+			}
+		}
+
+		if (!ParseReplicationLod(vm["Server.replication-lod-field"].as<std::string>(), replication_lod_field))
+		{
+			std::cerr << "Server.replication-lod-field must be a comma separated list of radius:interval" << "\n";
+			return false;
+		}
+		if (!ParseReplicationLod(vm["Server.replication-lod-dungeon"].as<std::string>(), replication_lod_dungeon))
+		{
+			std::cerr << "Server.replication-lod-dungeon must be a comma separated list of radius:interval" << "\n";
+			return false;
+		}
+
 		if (vm.count("DB.host"))
 		{
 			db_host = vm["DB.host"].as<std::string>();
@@ -149,4 +242,41 @@ public:
 		}
 		return true;
 	}
+
+	// 맵 타입의 거리별 이동 갱신 주기
+	const std::vector<ReplicationTier>& ReplicationLod(MapType type) const
+	{
+		return type == MapType::Dungeon ? replication_lod_dungeon : replication_lod_field;
+	}
+
+private:
+	// 쉼표로 구분한 반경:틱 간격. 반경 순서로 적는다. 마지막 단계는 그 반경 밖에도 적용된다.
+	// 예) 10:1,20:2,25:4 => 10 이내는 매 틱, 20 이내는 2 틱, 그 밖은 4 틱마다
+	static bool ParseReplicationLod(const std::string& value, std::vector<ReplicationTier>& tiers)
+	{
+		tiers.clear();
+		std::stringstream stream(value);
+		std::string tier;
+		while (std::getline(stream, tier, ','))
+		{
+			if (tier.empty())
+				continue;
+			try
+			{
+				size_t colon = tier.find(':');
+				if (colon == std::string::npos)
+					return false;
+				float radius = std::stof(tier.substr(0, colon));
+				int interval = std::stoi(tier.substr(colon + 1));
+				if (interval < 1 || (!tiers.empty() && radius < tiers.back().radius))
+					return false;
+				tiers.push_back({ radius, static_cast<unsigned int>(interval) });
+			}
+			catch (std::exception&)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
 };
@@ -26,7 +26,7 @@ std::once_flag Singleton<T>::once_flag_;
 template<class T>
 inline T& Singleton<T>::GetInstance()
 {
-	// ѹ ȣǴ°  ش.
+	// 한번만 호출되는것을 보장해 준다.
 	std::call_once(once_flag_,
 		[]{
 			instance_.reset(new T());
@@ -1,6 +1,6 @@
 #pragma once
 
-//  Ŭ Ÿ
+// 영웅 클래스 타입
 enum class ClassType : int
 {
 	NONE = 0,
@@ -9,7 +9,7 @@ enum class ClassType : int
 	Mage = 3,
 };
 
-//  Ÿ
+// 맵 타입
 enum class MapType : int
 {
 	NONE = 0,
@@ -17,11 +17,19 @@ enum class MapType : int
 	Dungeon = 2,
 };
 
-// Ÿ Ÿ
+// 타겟팅 타입
 enum class TargetingType : int
 {
     NONE = 0,
     Self,
     One,
     Around,
+};
+
+// 이동 갱신의 거리별 단계.
+// 관찰자와의 거리가 radius 이하이면 interval 틱마다 한번 보낸다.
+struct ReplicationTier
+{
+	float radius;
+	unsigned int interval;
 };
\ No newline at end of file
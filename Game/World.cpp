@@ -52,7 +52,7 @@ void World::DoUpdate(float delta_time)
 
 void World::CreateFieldZones()
 {
-	// ʵ 
+	// 필드존 생성
 	auto& map_table = MapTable::GetInstance().GetAll();
 	for (auto& map_data : map_table)
 	{
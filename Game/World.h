@@ -10,13 +10,13 @@
 
 using namespace boost::multi_index;
 
-// ±׼
+// 태그선언
 struct zone_tags
 {
 	struct entity_id {};
 	struct map_id {};
 };
-// ε Ÿ 
+// 인덱싱 타입을 선언
 using indices = indexed_by<
 	hashed_unique<
 		tag<zone_tags::entity_id>, const_mem_fun<Zone, const uuid&, &Zone::EntityId>, boost::hash<boost::uuids::uuid>
@@ -25,12 +25,12 @@ using indices = indexed_by<
 		tag<zone_tags::map_id>, const_mem_fun<Zone, int, &Zone::MapId>
 	>
 >;
-//  ̳ Ÿ 
+// 존 컨테이너 타입 선언
 using ZoneSet = boost::multi_index_container<Ptr<Zone>, indices>;
 
-//  ùķ̼.
-//  ü .
-// ĳ, ,    .
+// 게임의 시뮬레이션.
+// 게임 객체를 관리.
+// 캐릭터, 몬스터, 지역 생성 및 삭제.
 class World : public std::enable_shared_from_this<World>
 {
 public:
@@ -40,27 +40,27 @@ public:
 	World(Ptr<EventLoop>& loop);
 	~World();
 
-    //   .
+    // 게임 월드 시작.
 	void Start();
-    //   .
+    // 게임 월드 종료.
 	void Stop();
 
-    // ȭ ü.
+    // 직렬화 객체.
 	strand& GetStrand() { return strand_; }
 	
-    // ʵ  ü ´.
+    // 필드 존 객체를 얻는다.
     Zone* FindFieldZone(int map_id);
-    // νϽ  ü ´.
+    // 인스턴스 존 객체를 얻는다.
     InstanceZone* FindInstanceZone(const uuid& entity_id);
 	
-	// ȭ ۾ .
+	// 직렬화 작업 실행.
 	template <typename Handler>
 	void Dispatch(Handler&& handler)
 	{
 		strand_.dispatch(std::forward<Handler>(handler));
 	}
 
-    // Ÿ̸ .
+    // 타이머 예약.
     template <typename Handler>
     Ptr<timer_type> RunAt(time_point time, Handler&& handler)
     {
@@ -79,7 +79,7 @@ public:
         return timer;
     }
 
-    // Ÿ̸ .
+    // 타이머 예약.
     template <typename Handler>
     Ptr<timer_type> RunAfter(duration duration, Handler&& handler)
     {
@@ -98,9 +98,9 @@ public:
         return timer;
     }
 
-    // νϽ   .
+    // 인스턴스 존 을 만든다.
     InstanceZone* CreateInstanceZone(int map_id);
-    //  Ѵ.
+    // 존을 삭제한다.
     bool DeleteZone(const uuid& entity_id)
     {
         auto& indexer = zone_set_.get<zone_tags::entity_id>();
@@ -112,7 +112,7 @@ public:
         return true;
     }
 
-    //  Ʈ.
+    // 프레임 업데이트.
 	void DoUpdate(float delta_time);
 
 private:
@@ -31,23 +31,49 @@ void WorldServer::Run()
     SetName(settings.name);
 
     // Create io_service loop
-    size_t thread_count = settings.thread_count;
-    ev_loop_ = std::make_shared<net::EventLoop>(thread_count);
+    net::EventLoopConfig ev_loop_config;
+    ev_loop_config.thread_count = settings.thread_count;
+    ev_loop_config.mode = settings.io_context_per_thread ? net::EventLoopMode::ContextPerThread : net::EventLoopMode::Shared;
+    ev_loop_config.spin_time = settings.spin_time;
+    ev_loop_config.cpu_affinity = settings.cpu_affinity;
+    ev_loop_config.thread_name = "world";
+    ev_loop_ = std::make_shared<net::EventLoop>(ev_loop_config);
     // NetServer Config
     net::ServerConfig server_config;
     server_config.event_loop = ev_loop_;
     server_config.max_session_count = settings.max_session_count;
+    server_config.accept_count = settings.accept_count;
+    server_config.reuse_port = settings.reuse_port;
     server_config.max_receive_buffer_size = settings.max_receive_buffer_size;
+    server_config.max_send_buffer_size = settings.max_send_buffer_size;
+    server_config.compress_threshold = settings.compress_threshold;
+    server_config.idle_timeout = settings.idle_timeout;
+    server_config.max_frames_per_read = settings.max_frames_per_read;
+    server_config.message_rate_limit = { settings.message_rate, settings.message_burst > 0 ? settings.message_burst : settings.message_rate };
+    // 이동, 스킬 요청은 틱마다 처리하므로 틱 보다 자주 보내는 클라이언트를 막는다.
+    if (settings.action_rate > 0)
+    {
+        net::RateLimit action_limit = { settings.action_rate, settings.action_rate };
+        server_config.message_type_rate_limits.emplace_back(static_cast<uint16_t>(PCS::MessageType::World_Request_ActionMove), action_limit);
+        server_config.message_type_rate_limits.emplace_back(static_cast<uint16_t>(PCS::MessageType::World_Request_ActionSkill), action_limit);
+    }
+    server_config.max_rate_violations = settings.max_rate_violations;
+    server_config.stats_log_interval = settings.stats_log_interval;
+    server_config.udp_channel = settings.udp_channel;
+    // 클라이언트는 이동 요청만 UDP 로 보낼수 있다.
+    server_config.udp_message_types = { static_cast<uint16_t>(PCS::MessageType::World_Request_ActionMove) };
+    server_config.max_datagram_size = settings.max_datagram_size;
     server_config.min_receive_size = settings.min_receive_size;
+    server_config.shared_receive_buffer = settings.shared_receive_buffer;
+    server_config.io_uring = settings.io_uring;
     server_config.no_delay = settings.no_delay;
+    server_config.cork_threshold = settings.cork_threshold;
+    server_config.session_affinity = (settings.session_affinity == "least-load") ? net::SessionAffinity::LeastLoad : net::SessionAffinity::RoundRobin;
     // Create NetServer
     net_server_ = net::NetServer::Create(server_config);
     net_server_->RegisterSessionOpenedHandler([this](auto& session) { HandleSessionOpened(session); });
     net_server_->RegisterSessionClosedHandler([this](auto& session, auto reason) { HandleSessionClosed(session, reason); });
-    net_server_->RegisterMessageHandler([this](auto& session, auto* buf, auto bytes) { HandleMessage(session, buf, bytes); });
-
-    // ޽ ڵ鷯 
-    RegisterHandlers();
+    net_server_->RegisterMessageHandler([this](auto& session, auto message_type, auto* buf, auto bytes) { HandleMessage(session, message_type, buf, bytes); });
 
     // Create DB connection Pool
     db_conn_ = MySQLPool::Create(
@@ -57,33 +83,36 @@ void WorldServer::Run()
         settings.db_schema,
         settings.db_connection_pool);
 
-    // ʿ  ε.
+    // 필요한 데이터 로드.
     LoadResources();
 
-    //   óϴ World .
+    // 게임 로직을 처리하는 World 시작.
     world_ = std::make_shared<World>(ev_loop_);
     world_->Start();
 
-    // Frame Update .
+    // Frame Update 시작.
     strand_ = std::make_shared<strand>(ev_loop_->GetIoContext());
     update_timer_ = std::make_shared<timer_type>(ev_loop_->GetIoContext());
     ScheduleNextUpdate(clock_type::now(), TIME_STEP);
 
-    // NetServer  ۽Ų.
+    // NetServer 를 시작시킨다.
     std::string bind_address = settings.bind_address;
     uint16_t bind_port = settings.bind_port;
     net_server_->Start(bind_address, bind_port);
 
-    // Manager   ϴ Ŭ̾Ʈ.
+    // Manager 서버에 연결 하는 클라이언트.
     net::ClientConfig client_config;
     client_config.event_loop = ev_loop_;
     client_config.min_receive_size = settings.min_receive_size;
     client_config.max_receive_buffer_size = settings.max_receive_buffer_size;
+    client_config.compress_threshold = settings.compress_threshold;
+    client_config.heartbeat_interval = settings.heartbeat_interval;
     client_config.no_delay = settings.no_delay;
-    manager_client_ = std::make_shared<ManagerClient>(client_config, this,GetName(), ServerType::World_Server);
-    // Ŭ̾Ʈ  ޽ ڵ鷯 .
+    auto request_timeout = std::chrono::milliseconds(settings.manager_request_timeout);
+    manager_client_ = std::make_shared<ManagerClient>(client_config, settings.manager_connections, request_timeout, this, GetName(), ServerType::World_Server);
+    // 클라이언트 에 메시지 핸들러 등록.
     RegisterManagerClientHandlers();
-    // Manager   .
+    // Manager 서버에 연결 시작.
     manager_client_->Connect(settings.manager_address, settings.manager_port);
 
     BOOST_LOG_TRIVIAL(info) << "Run " << GetName();
@@ -91,14 +120,14 @@ void WorldServer::Run()
 
 void WorldServer::Stop()
 {
-    //  ۾.
+    // 종료 작업.
     net_server_->Stop();
     ev_loop_->Stop();
 
     BOOST_LOG_TRIVIAL(info) << "Stop " << GetName();
 }
 
-//    
+// 서버가 종료될 때가지 대기
 void WorldServer::Wait()
 {
     if (ev_loop_)
@@ -152,13 +181,13 @@ void WorldServer::RemoveRemoteClient(const Ptr<RemoteWorldClient>& remote_client
 
 void WorldServer::ProcessRemoteClientDisconnected(const Ptr<RemoteWorldClient>& rc)
 {
-    // Ͽ 
+    // 목록에서 제거
     RemoveRemoteClient(rc);
     rc->OnDisconnected();
 
     if (rc->IsAuthenticated() && rc->GetAccount())
     {
-        // Manager  α׾ƿ ˸.
+        // Manager 서버로 로그아웃을 알린다.
         manager_client_->NotifyUserLogout(rc->GetAccount()->uid);
         BOOST_LOG_TRIVIAL(info) << "Logout. account_uid: " << rc->GetAccount()->uid << " user_name: " << rc->GetAccount()->user_name;
     }
@@ -181,12 +210,12 @@ void WorldServer::ScheduleNextUpdate(const time_point& now, const duration& time
 
 void WorldServer::NotifyUnauthedAccess(const Ptr<net::Session>& session)
 {
-    fb::FlatBufferBuilder fbb;
+    fb::FlatBufferBuilder fbb(BUILDER_INITIAL_SIZE, &PooledBuilderAllocator::Instance());
     auto notify = PCS::CreateNotify_UnauthedAccess(fbb);
     auto root = PCS::CreateMessageRoot(fbb, PCS::MessageType::Notify_UnauthedAccess, notify.Union());
     FinishMessageRootBuffer(fbb, root);
 
-    session->Send(fbb.GetBufferPointer(), fbb.GetSize());
+    session->Send(MakeSendBuffer(fbb, static_cast<uint16_t>(PCS::MessageType::Notify_UnauthedAccess)));
 }
 
 void WorldServer::LoadResources()
@@ -200,36 +229,55 @@ void WorldServer::LoadResources()
     HeroSpawnTable::Load(db_conn_);
 }
 
-//  Ʈ
+// 프레임 업데이트
 void WorldServer::DoUpdate(double delta_time)
 {
-    GetWorld()->Dispatch([this, delta_time]() { GetWorld()->DoUpdate(delta_time); });
+    GetWorld()->Dispatch([this, delta_time]()
+    {
+        GetWorld()->DoUpdate(delta_time);
+        // 이번 프레임에 모인 메시지를 보낸다.
+        FlushRemoteClients();
+    });
 }
 
-void WorldServer::HandleMessage(const Ptr<net::Session>& session, const uint8_t* buf, size_t bytes)
+void WorldServer::FlushRemoteClients()
 {
-    // flatbuffer ޽ ø
-    const auto* message_root = PCS::GetMessageRoot(buf);
-    if (message_root == nullptr)
+    std::lock_guard<std::mutex> lock_guard(mutex_);
+    // 이번 프레임에 Send 하지 않은 클라이언트는 Flush 에서 바로 돌아온다.
+    for (auto& e : remote_clients_)
     {
-        BOOST_LOG_TRIVIAL(info) << "Invalid MessageRoot";
-        return;
+        e.second->Flush();
     }
+}
 
-    auto message_type = message_root->message_type();
-    //BOOST_LOG_TRIVIAL(debug) << "On Recv message_type : " << PCS::EnumNameMessageType(message_type);
+void WorldServer::HandleMessage(const Ptr<net::Session>& session, uint16_t message_type, const uint8_t* buf, size_t bytes)
+{
+    // payload 를 보기 전에 헤더의 타입으로 핸들러를 찾는다. 타입이 없거나(0) 모르는 타입이면 버리고 위반으로 센다.
+    auto handler = message_handlers_.Find(message_type);
+    if (handler == nullptr)
+    {
+        BOOST_LOG_TRIVIAL(info) << "Can not find the message handler. header_type : " << message_type;
+        session->RejectMessage(message_type);
+        return;
+    }
 
-    auto iter = message_handlers_.find(message_type);
-    if (iter == message_handlers_.end())
+    // flatbuffer 메시지로 디시리얼라이즈
+    const auto* message_root = PCS::GetMessageRoot(buf);
+    if (message_root == nullptr || message_root->message_type() != static_cast<PCS::MessageType>(message_type))
     {
-        BOOST_LOG_TRIVIAL(info) << "Can not find the message handler. message_type : " << PCS::EnumNameMessageType(message_type);
+        BOOST_LOG_TRIVIAL(info) << "Invalid MessageRoot. header_type : " << message_type;
+        session->RejectMessage(message_type);
         return;
     }
+    //BOOST_LOG_TRIVIAL(debug) << "On Recv message_type : " << PCS::EnumNameMessageType(message_root->message_type());
 
     try
     {
-        // ޽ ڵ鷯 
-        iter->second(session, message_root);
+        // 메시지 핸들러를 실행
+        if (!handler(*this, session, message_root))
+        {
+            BOOST_LOG_TRIVIAL(info) << "Can not cast message_type : " << PCS::EnumNameMessageType(message_root->message_type());
+        }
     }
     catch (sql::SQLException& e)
     {
@@ -266,19 +314,25 @@ void WorldServer::OnLogin(const Ptr<net::Session>& session, const PCS::World::Re
     auto rc = GetRemoteClient(session->GetID());
     if (!rc)
     {
-        // RemoteWorldClient   ߰.
+        // RemoteWorldClient 생성 및 추가.
         rc = std::make_shared<RemoteWorldClient>(session, this);
+        // 보낼 메시지는 프레임 업데이트가 끝날때 한번에 보낸다.
+        if (Settings::GetInstance().cork)
+            rc->SetCorked(true);
         AddRemoteClient(session->GetID(), rc);
     }
 
-    //  ° ƴϸ 
+    // 입장전 상태가 아니면 리턴
     if (rc->GetState() != RemoteWorldClient::State::Connected) return;
 
-    // Ϸ ɸ uid ӽ .
+    // 입장하려는 케릭터 uid 임시 저장.
     rc->selected_hero_uid_ = message->hero_uid();
 
-    // Manager  Ű  û.
-    manager_client_->RequestVerifyCredential(session->GetID(), boost::uuids::string_generator()(message->credential()->c_str()));
+    // Manager 서버에 인증키 검증 요청.
+    manager_client_->RequestVerifyCredential(session->GetID(), boost::uuids::string_generator()(message->credential()->c_str()), [this, session_id = session->GetID()](const PSS::Reply_VerifyCredential* message)
+    {
+        OnReplyVerifyCredential(session_id, message);
+    });
 }
 
 void WorldServer::OnLoadFinish(const Ptr<net::Session>& session, const PCS::World::Notify_LoadFinish * message)
@@ -305,7 +359,7 @@ void WorldServer::OnActionMove(const Ptr<net::Session>& session, const PCS::Worl
         NotifyUnauthedAccess(session);
         return;
     }
-    //  ° ƴϸ 
+    // 입장 상태가 아니면 리턴
     if (rc->GetState() != RemoteWorldClient::State::WorldEntered)
     {
         return;
@@ -324,7 +378,7 @@ void WorldServer::OnActionSkill(const Ptr<net::Session>& session, const PCS::Wor
         NotifyUnauthedAccess(session);
         return;
     }
-    //  ° ƴϸ 
+    // 입장 상태가 아니면 리턴
     if (rc->GetState() != RemoteWorldClient::State::WorldEntered)
     {
         return;
@@ -343,7 +397,7 @@ void WorldServer::OnRespawn(const Ptr<net::Session>& session, const PCS::World::
         NotifyUnauthedAccess(session);
         return;
     }
-    //  ° ƴϸ 
+    // 입장 상태가 아니면 리턴
     if (rc->GetState() != RemoteWorldClient::State::WorldEntered)
     {
         return;
@@ -362,7 +416,7 @@ void WorldServer::OnEnterGate(const Ptr<net::Session>& session, const PCS::World
         NotifyUnauthedAccess(session);
         return;
     }
-    //  ° ƴϸ 
+    // 입장 상태가 아니면 리턴
     if (rc->GetState() != RemoteWorldClient::State::WorldEntered)
     {
         return;
@@ -371,15 +425,14 @@ void WorldServer::OnEnterGate(const Ptr<net::Session>& session, const PCS::World
     rc->EnterGate(message);
 }
 
-void WorldServer::RegisterHandlers()
-{
-    RegisterMessageHandler<PCS::World::Request_Login>([this](auto& session, auto* msg) { OnLogin(session, msg); });
-    RegisterMessageHandler<PCS::World::Notify_LoadFinish>([this](auto& session, auto* msg) { OnLoadFinish(session, msg); });
-    RegisterMessageHandler<PCS::World::Request_ActionMove>([this](auto& session, auto* msg) { OnActionMove(session, msg); });
-    RegisterMessageHandler<PCS::World::Request_ActionSkill>([this](auto& session, auto* msg) { OnActionSkill(session, msg); });
-    RegisterMessageHandler<PCS::World::Request_Respawn>([this](auto& session, auto* msg) { OnRespawn(session, msg); });
-    RegisterMessageHandler<PCS::World::Request_EnterGate>([this](auto& session, auto* msg) { OnEnterGate(session, msg); });
-}
+// 메시지 핸들러 테이블. 상수 초기화라 실행 시간에 만드는 비용이 없다.
+const WorldServer::Dispatcher WorldServer::message_handlers_ = Dispatcher::Make<
+    Dispatcher::Bind<PCS::World::Request_Login, &WorldServer::OnLogin>,
+    Dispatcher::Bind<PCS::World::Notify_LoadFinish, &WorldServer::OnLoadFinish>,
+    Dispatcher::Bind<PCS::World::Request_ActionMove, &WorldServer::OnActionMove>,
+    Dispatcher::Bind<PCS::World::Request_ActionSkill, &WorldServer::OnActionSkill>,
+    Dispatcher::Bind<PCS::World::Request_Respawn, &WorldServer::OnRespawn>,
+    Dispatcher::Bind<PCS::World::Request_EnterGate, &WorldServer::OnEnterGate>>();
 
 void WorldServer::RegisterManagerClientHandlers()
 {
@@ -390,14 +443,14 @@ void WorldServer::RegisterManagerClientHandlers()
         }
         else
         {
-            // Manager   ϸ Ѵ.
+            // Manager 서버와 연결이 실패하면 종료한다.
             BOOST_LOG_TRIVIAL(info) << "Connection the Manager Server is failed!";
             Stop();
         }
     };
 
     manager_client_->OnDisconnected = [this]() {
-        //  Manager      Ѵ.
+        //  Manager 서버와 연결이 끊어 지면 종료 한다.
         BOOST_LOG_TRIVIAL(info) << "Manager Server is disconnected.";
         Stop();
     };
@@ -410,69 +463,79 @@ void WorldServer::RegisterManagerClientHandlers()
             std::cout << msg->str_msg()->c_str() << std::endl;
         }*/
     };
+}
 
-    manager_client_->OnReplyVerifyCredential = [this](const PSS::Reply_VerifyCredential* message)
-    {    
-        auto error_code = message->error_code();
-        int session_id = message->session_id();
-        int account_uid = message->account_uid();
-        uuid credential = boost::uuids::string_generator()(message->credential()->c_str());
-
-        auto rc = GetRemoteClient(session_id);
-        if (!rc) return;
+void WorldServer::OnReplyVerifyCredential(int session_id, const PSS::Reply_VerifyCredential* message)
+{
+    auto rc = GetRemoteClient(session_id);
+    if (!rc) return;
 
+    // Manager 서버의 응답을 받지 못함.
+    if (message == nullptr)
+    {
         rc->Dispatch([=]() {
-            // 
-            if (error_code != PSS::ErrorCode::OK || credential.is_nil())
-            {
-                PCS::World::Reply_LoginFailedT reply_msg;
-                reply_msg.error_code = PCS::ErrorCode::WORLD_LOGIN_INVALID_CREDENTIAL;
-                PCS::Send(*rc, reply_msg);
-                return;
-            }
-
-            rc->Authenticate(credential);
-
-            //  ° ƴ
-            if (rc->GetState() != RemoteWorldClient::State::Connected)
-            {
-                PCS::World::Reply_LoginFailedT reply_msg;
-                reply_msg.error_code = PCS::ErrorCode::WORLD_LOGIN_INVALID_STATE;
-                PCS::Send(*rc, reply_msg);
-                return;
-            }
-
-            //   ҷ´.
-            auto db_account = db::Account::Get(db_conn_, account_uid);
-            //  .
-            if (!db_account)
-            {
-                PCS::Login::Reply_LoginFailedT reply;
-                reply.error_code = PCS::ErrorCode::WORLD_LOGIN_INVALID_ACCOUNT;
-                PCS::Send(*rc, reply);
-                return;
-            }
-            rc->SetAccount(db_account);
-
-            // ĳ  ҷ´.
-            auto db_hero = db::Hero::Get(GetDB(), rc->selected_hero_uid_, rc->GetAccount()->uid);
-            // ĳ ε 
-            if (!db_hero)
-            {
-                PCS::Login::Reply_LoginFailedT reply;
-                reply.error_code = PCS::ErrorCode::WORLD_CANNOT_LOAD_HERO;
-                PCS::Send(*rc, reply);
-                return;
-            }
-            rc->SetDBHero(db_hero);
-            
-            BOOST_LOG_TRIVIAL(info) << "World Login Success. user_name: " << rc->GetAccount()->user_name;
-
-            // ɸ  Ѵ.
-            fb::FlatBufferBuilder fbb;
-            auto hero_offset = db_hero->Serialize(fbb);
-            auto reply_offset = PCS::World::CreateReply_LoginSuccess(fbb, hero_offset);
-            PCS::Send(*rc, fbb, reply_offset);
+            PCS::World::Reply_LoginFailedT reply_msg;
+            reply_msg.error_code = PCS::ErrorCode::UNEXPECTED;
+            PCS::Send(*rc, reply_msg);
         });
-    };
+        return;
+    }
+
+    auto error_code = message->error_code();
+    int account_uid = message->account_uid();
+    uuid credential = boost::uuids::string_generator()(message->credential()->c_str());
+
+    rc->Dispatch([=]() {
+        // 실패
+        if (error_code != PSS::ErrorCode::OK || credential.is_nil())
+        {
+            PCS::World::Reply_LoginFailedT reply_msg;
+            reply_msg.error_code = PCS::ErrorCode::WORLD_LOGIN_INVALID_CREDENTIAL;
+            PCS::Send(*rc, reply_msg);
+            return;
+        }
+
+        rc->Authenticate(credential);
+
+        // 입장전 상태가 아님
+        if (rc->GetState() != RemoteWorldClient::State::Connected)
+        {
+            PCS::World::Reply_LoginFailedT reply_msg;
+            reply_msg.error_code = PCS::ErrorCode::WORLD_LOGIN_INVALID_STATE;
+            PCS::Send(*rc, reply_msg);
+            return;
+        }
+
+        // 계정 정보를 불러온다.
+        auto db_account = db::Account::Get(db_conn_, account_uid);
+        // 계정이 없다.
+        if (!db_account)
+        {
+            PCS::Login::Reply_LoginFailedT reply;
+            reply.error_code = PCS::ErrorCode::WORLD_LOGIN_INVALID_ACCOUNT;
+            PCS::Send(*rc, reply);
+            return;
+        }
+        rc->SetAccount(db_account);
+
+        // 캐릭터 정보를 불러온다.
+        auto db_hero = db::Hero::Get(GetDB(), rc->selected_hero_uid_, rc->GetAccount()->uid);
+        // 캐릭터 로드 실패
+        if (!db_hero)
+        {
+            PCS::Login::Reply_LoginFailedT reply;
+            reply.error_code = PCS::ErrorCode::WORLD_CANNOT_LOAD_HERO;
+            PCS::Send(*rc, reply);
+            return;
+        }
+        rc->SetDBHero(db_hero);
+        
+        BOOST_LOG_TRIVIAL(info) << "World Login Success. user_name: " << rc->GetAccount()->user_name;
+
+        // 케릭터 정보를 전송한다.
+        fb::FlatBufferBuilder fbb(BUILDER_INITIAL_SIZE, &PooledBuilderAllocator::Instance());
+        auto hero_offset = db_hero->Serialize(fbb);
+        auto reply_offset = PCS::World::CreateReply_LoginSuccess(fbb, hero_offset);
+        PCS::Send(*rc, fbb, reply_offset);
+    });
 }
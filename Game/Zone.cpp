@@ -83,6 +83,8 @@ void Zone::Update(float delta_time)
     }
 
     mon_spawner_->Update(delta_time);
+
+    interest_area_update_observers.Notify();
 }
 
 const MapGate * Zone::GetGate(int uid)
@@ -142,5 +144,7 @@ fb::Offset<PCS::World::MapData> Zone::Serialize(fb::FlatBufferBuilder & fbb) con
         boost::uuids::to_string(EntityId()).c_str(),
         MapId(),
         (PCS::MapType)map_data_.type,
-        &map_gates);
+        &map_gates,
+        &PCS::Vec3(Area().min.X, Area().min.Y, Area().min.Z),
+        &PCS::Vec3(Area().max.X, Area().max.Y, Area().max.Z));
 }
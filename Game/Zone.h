@@ -15,8 +15,8 @@ class MonsterSpawner;
 
 constexpr float CELL_SIZE = 10.0f;
 
-//  .
-// ĳͰ ȣ ۿ Ͼ .
+// 게임 존.
+// 캐릭터간의 상호 작용이 일어나는 지역.
 class Zone : public Grid<ZoneCell>, std::enable_shared_from_this<Zone>
 {
 public:
@@ -28,36 +28,36 @@ public:
 	Zone(const uuid& entity_id, const Map& map_data, World* owner);
 	virtual ~Zone();
 
-    //  ƼƼ id.
+    // 고유 엔티티 id.
 	const uuid& EntityId() const { return entity_id_; }
-    //  id.
+    // 맵 id.
 	int MapId() const { return map_data_.id; }
-    //  .
+    // 맵 데이터.
 	const Map& MapData() const { return map_data_; }
-    //  Ÿ.
+    // 맵 타입.
     MapType MapType() const { return map_data_.type; }
-    //   ü.
+    // 게임 월드 객체.
     World* GetWorld() { return owner_; }
 
-    //  .
+    // 존 입장.
 	virtual void Enter(const Ptr<Actor>& actor, const Vector3& position);
-    //  .
+    // 존 퇴장.
     virtual void Exit(const Ptr<Actor>& actor);
     void Exit(const uuid& entity_id);
-    //   ĳ͸ .
+    // 존의 모든 캐릭터를 퇴장.
     virtual void ExitAllActors();
 
-    //  Ʈ.
+    // 프레임 업데이트.
 	virtual void Update(float delta_time);
 
-    //  Ա  ´
+    // 존의 출입구 정보를 얻는다
     const MapGate* GetGate(int uid);
     const std::unordered_map<int, const MapGate*>& GetGates()
     {
         return map_gates_;
     }
 
-    //  ĳ͸ ã´.
+    // 존의 캐릭터를 찾는다.
     Actor* FindActor(const uuid& entity_id)
     {
         auto iter = actors_.find(entity_id);
@@ -72,6 +72,9 @@ public:
 
     fb::Offset<PCS::World::MapData> Serialize(fb::FlatBufferBuilder& fbb) const;
 
+    // 틱마다 Actor 를 갱신한 뒤에 관심 지역의 보이는 목록을 갱신한다.
+    ObserverList<> interest_area_update_observers;
+
 protected:
 	World* owner_;
 	
@@ -79,7 +82,7 @@ protected:
 	Map map_data_;
     std::unordered_map<int, const MapGate*> map_gates_;
 	
-	//   Actor
+	// 지역에 속한 Actor
 	std::unordered_map<uuid, Ptr<Actor>, std::hash<boost::uuids::uuid>> actors_;
     std::unordered_map<uuid, Hero*, std::hash<boost::uuids::uuid>> heroes_;
     Ptr<MonsterSpawner> mon_spawner_;
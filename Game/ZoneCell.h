@@ -1,33 +1,29 @@
 #pragma once
 #include <unordered_set>
-#include <boost\signals2.hpp>
 #include "Common.h"
 #include "Grid.h"
+#include "ObserverList.h"
 
 using namespace boost;
 namespace PCS = ProtocolCS;
 
 class Actor;
-class InterestArea;
 
 class ZoneCell : public BasicCell
 {
 public:
-    ZoneCell(int x, int y, int z)
-        : BasicCell(x, y, z)
+    using ActorCellChangeList = ObserverList<ZoneCell*, ZoneCell*, Actor*>;
+    using ActorUpdateList = ObserverList<const Ptr<net::SendBuffer>&, const Actor*, bool>;
+
+    ZoneCell(int x, int z)
+        : BasicCell(x, z)
     {
-        actor_cell_change_signal.connect(std::bind(&ZoneCell::OnActorCellChange, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
     };
 
-    signals2::signal<void(ZoneCell*, ZoneCell*, Actor*)> actor_cell_change_signal;
-    signals2::signal<void(PCS::World::Notify_UpdateT*)> actor_update_signal;
-
-    signals2::signal<void(InterestArea*)> interest_area_enter_signal;
-    signals2::signal<void(InterestArea*)> interest_area_exit_signal;
-
-private:
-    void OnActorCellChange(ZoneCell* exit, ZoneCell* enter, Actor* actor)
+    // Actor 가 셀을 옮길때 나간 셀과 들어간 셀에서 각각 호출한다.
+    void NotifyActorCellChange(ZoneCell* exit, ZoneCell* enter, Actor* actor)
     {
+        version_++;
         if (exit == this)
         {
             actors_.erase(actor);
@@ -36,7 +32,27 @@ private:
         {
             actors_.insert(actor);
         }
+        actor_cell_change_observers.Notify(exit, enter, actor);
+    }
+
+    // Actor 가 셀 안에서 움직였을때 호출한다.
+    void NotifyActorMove()
+    {
+        version_++;
     }
 
+    // 셀에 있는 Actor
+    const std::unordered_set<Actor*>& Actors() const { return actors_; }
+    // Actor 가 들어오거나 나가거나 움직일때마다 늘어난다.
+    uint64_t Version() const { return version_; }
+
+    // 관찰자 목록은 월드 strand 에서만 사용하므로 락이 없다.
+    ActorCellChangeList actor_cell_change_observers;
+    // 인코딩이 끝난 Notify_Update 메시지. 구독자 모두가 같은 버퍼를 공유한다.
+    // latest_only 이면 같은 Actor 의 이전 메시지를 교체하거나 잃어버려도 된다. (이동 갱신)
+    ActorUpdateList actor_update_observers;
+
+private:
     std::unordered_set<Actor*> actors_;
+    uint64_t version_ = 0;
 };
\ No newline at end of file
@@ -1,21 +1,50 @@
 #pragma once
 #include <protocol_cs_generated.h>
+#include "protocol_helper.h"
 
 namespace ProtocolCS {
 
-	template <typename Peer, typename T>
-	void Send(Peer& peer, flatbuffers::FlatBufferBuilder& fbb, const flatbuffers::Offset<T>& offset_message)
+	// 메시지를 프레임 단위로 인코딩한다.
+	// 결과 버퍼는 바뀌지 않으므로 여러 세션에 그대로 보낼수 있다.
+	template <typename T>
+	Ptr<net::SendBuffer> Encode(flatbuffers::FlatBufferBuilder& fbb, const flatbuffers::Offset<T>& offset_message)
 	{
         auto offset_root = CreateMessageRoot(fbb, MessageTypeTraits<T>::enum_value, offset_message.Union());
         FinishMessageRootBuffer(fbb, offset_root);
-		peer.Send(fbb.GetBufferPointer(), fbb.GetSize());
+		return MakeSendBuffer(fbb, static_cast<uint16_t>(MessageTypeTraits<T>::enum_value));
 	}
 
-	template <typename Peer, typename T>
-	void Send(Peer& peer, const T& message)
+	// 큰 메시지는 initial_size 를 BuilderSize 로 잡아서 빌더가 커지며 복사하지 않게 한다.
+	template <typename T>
+	Ptr<net::SendBuffer> Encode(const T& message, flatbuffers::uoffset_t initial_size = BUILDER_INITIAL_SIZE)
 	{
-		flatbuffers::FlatBufferBuilder fbb;
+		flatbuffers::FlatBufferBuilder fbb(initial_size, &PooledBuilderAllocator::Instance());
         auto offset_message = T::TableType::Pack(fbb, &message);
-        Send(peer, fbb, offset_message);
+        return Encode(fbb, offset_message);
+	}
+
+	template <typename Peer, typename T>
+	void Send(Peer& peer, flatbuffers::FlatBufferBuilder& fbb, const flatbuffers::Offset<T>& offset_message)
+	{
+		peer.Send(Encode(fbb, offset_message));
+	}
+
+	template <typename Peer, typename T>
+	void Send(Peer& peer, const T& message, flatbuffers::uoffset_t initial_size = BUILDER_INITIAL_SIZE)
+	{
+		peer.Send(Encode(message, initial_size));
+	}
+
+	// channel 을 골라서 보낸다. 이동 갱신처럼 마지막 값만 의미있는 메시지는 key 와 함께 Unreliable 로 보낸다.
+	template <typename Peer, typename T>
+	void Send(Peer& peer, net::Channel channel, uint64_t key, flatbuffers::FlatBufferBuilder& fbb, const flatbuffers::Offset<T>& offset_message)
+	{
+		peer.Send(channel, key, Encode(fbb, offset_message));
+	}
+
+	template <typename Peer, typename T>
+	void Send(Peer& peer, net::Channel channel, uint64_t key, const T& message)
+	{
+		peer.Send(channel, key, Encode(message));
 	}
 }
@@ -0,0 +1,70 @@
+#pragma once
+#include <flatbuffers/flatbuffers.h>
+#include <network.h>
+
+// FlatBufferBuilder 가 사용하는 할당자.
+// net::BufferPool 의 블록을 재사용해서 메시지마다 힙 할당을 하지 않는다.
+class PooledBuilderAllocator : public flatbuffers::Allocator
+{
+public:
+    uint8_t* allocate(size_t size) override
+    {
+        return net::BufferPool::Allocate(size);
+    }
+
+    void deallocate(uint8_t* p, size_t size) override
+    {
+        net::BufferPool::Deallocate(p, size);
+    }
+
+    static PooledBuilderAllocator& Instance()
+    {
+        static PooledBuilderAllocator instance;
+        return instance;
+    }
+};
+
+// 빌더의 초기 버퍼 크기.
+constexpr flatbuffers::uoffset_t BUILDER_INITIAL_SIZE = 1024;
+
+// 목록 같은 큰 데이터가 들어갈때 그 뒤에 붙는 테이블, 헤더를 위한 여유 공간.
+constexpr size_t BUILDER_HEADROOM = 256;
+
+// payload_bytes 만큼의 데이터가 들어가는 빌더의 초기 버퍼 크기.
+// 빌더는 버퍼가 모자랄때마다 2배로 새로 할당하고 복사하므로 큰 메시지는 처음부터 크게 잡는다.
+// BufferPool 블록 크기로 올려서 블록을 남김없이 사용한다.
+inline flatbuffers::uoffset_t BuilderSize(size_t payload_bytes)
+{
+    size_t size = std::max<size_t>(BUILDER_INITIAL_SIZE, payload_bytes + BUILDER_HEADROOM);
+    return static_cast<flatbuffers::uoffset_t>(net::BufferPool::BlockSize(size));
+}
+
+// FlatBufferBuilder 에서 떼어낸 메모리를 그대로 전송하는 버퍼.
+class FlatBufferSendBuffer : public net::SendBuffer
+{
+public:
+    explicit FlatBufferSendBuffer(flatbuffers::DetachedBuffer&& buf)
+        : buf_(std::move(buf))
+    {
+    }
+
+    const uint8_t* Data() const override { return buf_.data(); }
+    size_t Size() const override { return buf_.size(); }
+
+private:
+    flatbuffers::DetachedBuffer buf_;
+};
+
+// Finish 된 빌더 앞에 프레임 헤더를 붙이고 버퍼를 떼어낸다.
+// flatbuffers 는 뒤에서 앞으로 쓰기 때문에 복사 없이 헤더를 붙일수 있다.
+// message_type 은 MessageRoot 의 타입. 받는 쪽이 payload 를 보기 전에 메시지를 구분할수 있다.
+// 호출 후에는 빌더를 다시 사용할수 없다.
+inline Ptr<net::SendBuffer> MakeSendBuffer(flatbuffers::FlatBufferBuilder& fbb, uint16_t message_type = 0)
+{
+    net::FrameHeader header{};
+    header.payload_len = (int32_t)fbb.GetSize();
+    header.message_type = message_type;
+    fbb.PushBytes(reinterpret_cast<const uint8_t*>(&header), sizeof(header));
+
+    return std::make_shared<FlatBufferSendBuffer>(fbb.Release());
+}
\ No newline at end of file
@@ -1,22 +1,24 @@
 #pragma once
 #include <protocol_ss_generated.h>
+#include "protocol_helper.h"
 
 namespace ProtocolSS {
 
+    // correlation_id 는 요청이면 응답을 찾을 id, 응답이면 받은 요청의 id. 0 이면 응답이 필요없는 메시지.
     template <typename Peer, typename T>
-    void Send(Peer& peer, flatbuffers::FlatBufferBuilder& fbb, const flatbuffers::Offset<T>& offset_message)
+    void Send(Peer& peer, flatbuffers::FlatBufferBuilder& fbb, const flatbuffers::Offset<T>& offset_message, uint32_t correlation_id = 0)
     {
-        auto offset_root = CreateMessageRoot(fbb, MessageTypeTraits<T>::enum_value, offset_message.Union());
+        auto offset_root = CreateMessageRoot(fbb, MessageTypeTraits<T>::enum_value, offset_message.Union(), correlation_id);
         FinishMessageRootBuffer(fbb, offset_root);
-        peer.Send(fbb.GetBufferPointer(), fbb.GetSize());
+        peer.Send(MakeSendBuffer(fbb, static_cast<uint16_t>(MessageTypeTraits<T>::enum_value)));
     }
 
     template <typename Peer, typename T>
-    void Send(Peer& peer, const T& message)
+    void Send(Peer& peer, const T& message, uint32_t correlation_id = 0)
     {
-        flatbuffers::FlatBufferBuilder fbb;
+        flatbuffers::FlatBufferBuilder fbb(BUILDER_INITIAL_SIZE, &PooledBuilderAllocator::Instance());
         auto offset_message = T::TableType::Pack(fbb, &message);
-        Send(peer, fbb, offset_message);
+        Send(peer, fbb, offset_message, correlation_id);
     }
 
     template <typename Peer, typename T>
@@ -29,7 +31,7 @@ namespace ProtocolSS {
     template <typename Peer, typename T>
     void SendRelay(Peer& peer, int source, const std::vector<int>& destinations, const T& message)
     {
-        flatbuffers::FlatBufferBuilder fbb;
+        flatbuffers::FlatBufferBuilder fbb(BUILDER_INITIAL_SIZE, &PooledBuilderAllocator::Instance());
         auto offset_message = T::TableType::Pack(fbb, &message);
         SendRelay(peer, fbb, source, destinations, offset_message);
     }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <type_traits>
+#include <atomic>
 #include <future>
 #include <boost/asio/use_future.hpp>
 #include <boost/asio.hpp>
@@ -53,4 +54,192 @@ namespace net {
 		return future;
 	}
 
+	// 비동기 작업 하나가 반복해서 사용하는 핸들러 메모리.
+	// 작업이 끝나면 asio 가 핸들러를 호출하기 전에 메모리를 돌려주므로 다음 작업이 그대로 재사용한다.
+	// 처음 요청한 크기로 할당해서 보관하고, 사용중이거나 더 큰 요청만 힙을 사용한다.
+	// 이벤트 루프가 멈춘 뒤 객체가 먼저 소멸해도 남은 작업이 메모리를 돌려줄수 있도록
+	// 실제 메모리(Block)는 핸들러들과 공유한다.
+	class HandlerMemory
+	{
+	public:
+		class Block
+		{
+		public:
+			Block() = default;
+			Block(const Block&) = delete;
+			Block& operator=(const Block&) = delete;
+
+			~Block()
+			{
+				::operator delete(storage_);
+			}
+
+			void* Allocate(size_t size)
+			{
+				if (!in_use_)
+				{
+					if (size > capacity_)
+					{
+						::operator delete(storage_);
+						storage_ = nullptr;
+						capacity_ = 0;
+						storage_ = ::operator new(size);
+						capacity_ = size;
+						HeapAllocations().fetch_add(1, std::memory_order_relaxed);
+					}
+					in_use_ = true;
+					return storage_;
+				}
+
+				HeapAllocations().fetch_add(1, std::memory_order_relaxed);
+				return ::operator new(size);
+			}
+
+			void Deallocate(void* p)
+			{
+				if (p == storage_)
+				{
+					in_use_ = false;
+					return;
+				}
+				::operator delete(p);
+			}
+
+		private:
+			void* storage_ = nullptr;
+			size_t capacity_ = 0;
+			bool in_use_ = false;
+		};
+
+		HandlerMemory()
+			: block_(std::make_shared<Block>())
+		{
+		}
+
+		HandlerMemory(const HandlerMemory&) = delete;
+		HandlerMemory& operator=(const HandlerMemory&) = delete;
+
+		const Ptr<Block>& GetBlock() const
+		{
+			return block_;
+		}
+
+		// 재사용하지 못하고 힙에서 할당한 횟수. 프로세스 전체의 합계.
+		static uint64_t GetHeapAllocationCount()
+		{
+			return HeapAllocations().load(std::memory_order_relaxed);
+		}
+
+	private:
+		Ptr<Block> block_;
+
+		static std::atomic<uint64_t>& HeapAllocations()
+		{
+			static std::atomic<uint64_t> count{ 0 };
+			return count;
+		}
+	};
+
+	// HandlerMemory 를 사용하는 asio associated allocator.
+	// 핸들러가 살아있는 동안만 사용되므로 Block 을 소유하지 않는다.
+	template <typename T>
+	class HandlerAllocator
+	{
+	public:
+		using value_type = T;
+
+		explicit HandlerAllocator(HandlerMemory::Block* block)
+			: block_(block)
+		{
+		}
+
+		template <typename U>
+		HandlerAllocator(const HandlerAllocator<U>& other) noexcept
+			: block_(other.block_)
+		{
+		}
+
+		T* allocate(size_t n) const
+		{
+			return static_cast<T*>(block_->Allocate(sizeof(T) * n));
+		}
+
+		void deallocate(T* p, size_t) const
+		{
+			block_->Deallocate(p);
+		}
+
+		bool operator==(const HandlerAllocator& other) const noexcept
+		{
+			return block_ == other.block_;
+		}
+
+		bool operator!=(const HandlerAllocator& other) const noexcept
+		{
+			return block_ != other.block_;
+		}
+
+	private:
+		template <typename> friend class HandlerAllocator;
+
+		HandlerMemory::Block* block_;
+	};
+
+	// 핸들러에 HandlerMemory 를 associated allocator 로 붙인다.
+	template <typename Handler>
+	class AllocHandler
+	{
+	public:
+		using allocator_type = HandlerAllocator<Handler>;
+
+		AllocHandler(const Ptr<HandlerMemory::Block>& block, Handler handler)
+			: block_(block)
+			, handler_(std::move(handler))
+		{
+		}
+
+		allocator_type get_allocator() const noexcept
+		{
+			return allocator_type(block_.get());
+		}
+
+		template <typename... Args>
+		void operator()(Args&&... args)
+		{
+			handler_(std::forward<Args>(args)...);
+		}
+
+	private:
+		Ptr<HandlerMemory::Block> block_;
+		Handler handler_;
+	};
+
+	template <typename Handler>
+	inline AllocHandler<typename std::decay<Handler>::type> MakeAllocHandler(HandlerMemory& memory, Handler&& handler)
+	{
+		return AllocHandler<typename std::decay<Handler>::type>(memory.GetBlock(), std::forward<Handler>(handler));
+	}
+
+	// 연속된 asio::const_buffer 배열을 가리키는 ConstBufferSequence.
+	// std::vector 를 그대로 넘기면 asio 가 작업마다 vector 를 복사하므로 대신 사용한다.
+	class ConstBufferSpan
+	{
+	public:
+		using value_type = asio::const_buffer;
+		using const_iterator = const asio::const_buffer*;
+
+		ConstBufferSpan(const asio::const_buffer* first, const asio::const_buffer* last)
+			: begin_(first)
+			, end_(last)
+		{
+		}
+
+		const_iterator begin() const { return begin_; }
+		const_iterator end() const { return end_; }
+
+	private:
+		const asio::const_buffer* begin_;
+		const asio::const_buffer* end_;
+	};
+
 } // namespace net
\ No newline at end of file
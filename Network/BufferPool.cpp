@@ -0,0 +1,217 @@
+#include <new>
+#include <atomic>
+#include <algorithm>
+#include "BufferPool.h"
+#include "ThreadStats.h"
+
+namespace net {
+
+namespace {
+
+	constexpr size_t CLASS_COUNT = 9; // 256, 512, ... 64K
+
+	static_assert((BufferPool::MIN_BLOCK_SIZE << (CLASS_COUNT - 1)) == BufferPool::MAX_BLOCK_SIZE, "invalid size class count");
+
+	// 반환된 블록의 앞부분을 다음 블록의 포인터로 사용한다.
+	struct FreeBlock
+	{
+		FreeBlock* next;
+	};
+
+	// 스레드 캐시가 가득 차면 넘치는 블록을 보관하는 공용 목록.
+	// 빌더는 World 스레드에서 할당하고 버퍼는 io 스레드에서 해제하므로 스레드 캐시만으로는 재사용되지 않는다.
+	// 넣을때는 하나씩 CAS 로 넣고 꺼낼때는 목록 전체를 가져가므로 ABA 문제가 없다.
+	struct Depot
+	{
+		std::atomic<FreeBlock*> head{ nullptr };
+		std::atomic<size_t> count{ 0 };
+	};
+
+	// 크기별로 공용 목록에 보관하는 최대 블록 수. 넘으면 바로 해제한다.
+	constexpr size_t MAX_DEPOT_BLOCKS = 1024;
+
+	std::array<Depot, CLASS_COUNT> g_depots;
+
+	bool PushDepot(size_t index, FreeBlock* block)
+	{
+		Depot& depot = g_depots[index];
+		if (depot.count.load(std::memory_order_relaxed) >= MAX_DEPOT_BLOCKS)
+			return false;
+
+		depot.count.fetch_add(1, std::memory_order_relaxed);
+		FreeBlock* head = depot.head.load(std::memory_order_relaxed);
+		do
+		{
+			block->next = head;
+		} while (!depot.head.compare_exchange_weak(head, block, std::memory_order_release, std::memory_order_relaxed));
+		return true;
+	}
+
+	// 공용 목록의 블록을 모두 가져온다. 가져온 수는 count 에 넣는다.
+	FreeBlock* TakeDepot(size_t index, size_t& count)
+	{
+		Depot& depot = g_depots[index];
+		count = 0;
+		if (depot.head.load(std::memory_order_relaxed) == nullptr)
+			return nullptr;
+
+		FreeBlock* head = depot.head.exchange(nullptr, std::memory_order_acquire);
+		for (FreeBlock* block = head; block != nullptr; block = block->next)
+			count++;
+		depot.count.fetch_sub(count, std::memory_order_relaxed);
+		return head;
+	}
+
+	struct ThreadCache
+	{
+		std::array<FreeBlock*, CLASS_COUNT> free_list{};
+		std::array<size_t, CLASS_COUNT> count{};
+		// 소유한 스레드만 쓰고 GetStats 에서 읽는다.
+		std::array<StatCounter, CLASS_COUNT> hits{};
+		std::array<StatCounter, CLASS_COUNT> misses{};
+
+		ThreadCache();
+		~ThreadCache();
+	};
+
+	// 스레드 캐시의 적중 횟수 합계.
+	struct StatsTotals
+	{
+		std::array<uint64_t, CLASS_COUNT> hits{};
+		std::array<uint64_t, CLASS_COUNT> misses{};
+	};
+
+	using StatsRegistry = ThreadStatsRegistry<ThreadCache, StatsTotals>;
+
+	void Accumulate(StatsTotals& totals, const ThreadCache& cache)
+	{
+		for (size_t i = 0; i < CLASS_COUNT; i++)
+		{
+			totals.hits[i] += LoadStat(cache.hits[i]);
+			totals.misses[i] += LoadStat(cache.misses[i]);
+		}
+	}
+
+	// 스레드가 종료되어 캐시가 해제된 뒤에는 nullptr 이 된다.
+	thread_local ThreadCache* t_cache = nullptr;
+
+	ThreadCache::ThreadCache()
+	{
+		t_cache = this;
+		StatsRegistry::Instance().Register(this);
+	}
+
+	ThreadCache::~ThreadCache()
+	{
+		t_cache = nullptr;
+		StatsRegistry::Instance().Retire(this, Accumulate);
+
+		for (auto head : free_list)
+		{
+			while (head)
+			{
+				FreeBlock* next = head->next;
+				::operator delete(head);
+				head = next;
+			}
+		}
+	}
+
+	ThreadCache* GetThreadCache()
+	{
+		thread_local ThreadCache cache;
+		return t_cache;
+	}
+
+	size_t ClassIndex(size_t size)
+	{
+		size_t index = 0;
+		size_t block_size = BufferPool::MIN_BLOCK_SIZE;
+		while (block_size < size)
+		{
+			block_size <<= 1;
+			index++;
+		}
+		return index;
+	}
+
+} // namespace
+
+size_t BufferPool::BlockSize(size_t size)
+{
+	if (size > MAX_BLOCK_SIZE)
+		return size;
+
+	return MIN_BLOCK_SIZE << ClassIndex(size);
+}
+
+uint8_t* BufferPool::Allocate(size_t size)
+{
+	if (size > MAX_BLOCK_SIZE)
+		return static_cast<uint8_t*>(::operator new(size));
+
+	size_t index = ClassIndex(size);
+	ThreadCache* cache = GetThreadCache();
+	if (cache && cache->free_list[index] == nullptr)
+	{
+		// 다른 스레드가 해제한 블록을 공용 목록에서 가져온다.
+		size_t count = 0;
+		cache->free_list[index] = TakeDepot(index, count);
+		cache->count[index] = count;
+	}
+	if (cache && cache->free_list[index])
+	{
+		FreeBlock* block = cache->free_list[index];
+		cache->free_list[index] = block->next;
+		cache->count[index]--;
+		AddStat(cache->hits[index], 1);
+		return reinterpret_cast<uint8_t*>(block);
+	}
+
+	if (cache)
+		AddStat(cache->misses[index], 1);
+	return static_cast<uint8_t*>(::operator new(MIN_BLOCK_SIZE << index));
+}
+
+void BufferPool::Deallocate(uint8_t* p, size_t size)
+{
+	if (p == nullptr)
+		return;
+
+	if (size > MAX_BLOCK_SIZE)
+	{
+		::operator delete(p);
+		return;
+	}
+
+	size_t index = ClassIndex(size);
+	ThreadCache* cache = GetThreadCache();
+	FreeBlock* block = reinterpret_cast<FreeBlock*>(p);
+	// 캐시가 가득 찼거나 스레드 종료 중이면 할당하는 스레드가 가져가도록 공용 목록에 넣는다.
+	if (cache == nullptr || cache->count[index] >= MAX_CACHED_BLOCKS)
+	{
+		if (!PushDepot(index, block))
+			::operator delete(p);
+		return;
+	}
+
+	block->next = cache->free_list[index];
+	cache->free_list[index] = block;
+	cache->count[index]++;
+}
+
+std::vector<BufferPoolStats> BufferPool::GetStats()
+{
+	std::vector<BufferPoolStats> stats(CLASS_COUNT);
+
+	auto totals = StatsRegistry::Instance().Collect(Accumulate);
+	for (size_t i = 0; i < CLASS_COUNT; i++)
+	{
+		stats[i].block_size = MIN_BLOCK_SIZE << i;
+		stats[i].hits = totals.hits[i];
+		stats[i].misses = totals.misses[i];
+	}
+	return stats;
+}
+
+} // namespace net
\ No newline at end of file
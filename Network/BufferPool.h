@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <vector>
+
+namespace net {
+
+	// 크기별 캐시 사용 통계.
+	struct BufferPoolStats
+	{
+		size_t block_size = 0;
+		uint64_t hits = 0;		// 스레드 캐시나 공용 목록에서 할당.
+		uint64_t misses = 0;	// 캐시가 비어서 새로 할당.
+	};
+
+	// 크기별로 메모리 블록을 재사용하는 풀.
+	// 블록 크기는 MIN_BLOCK_SIZE 부터 MAX_BLOCK_SIZE 까지 2배씩 증가한다.
+	// 반환된 블록은 스레드별 캐시에 보관하므로 할당/해제에 락이 없다.
+	// 캐시가 가득 차면 크기별 공용 목록에 넣고, 캐시가 빈 스레드가 목록을 통째로 가져간다.
+	// 다른 스레드에서 해제된 블록도 할당하는 스레드로 돌아온다.
+	class BufferPool
+	{
+	public:
+		static constexpr size_t MIN_BLOCK_SIZE = 256;
+		static constexpr size_t MAX_BLOCK_SIZE = 64 * 1024;
+		// 스레드별, 크기별로 보관하는 최대 블록 수.
+		static constexpr size_t MAX_CACHED_BLOCKS = 64;
+
+		// size 이상의 블록을 할당한다. MAX_BLOCK_SIZE 보다 크면 풀을 거치지 않는다.
+		static uint8_t* Allocate(size_t size);
+		// Allocate 로 할당한 블록을 돌려준다. size 는 Allocate 에 넘긴 값과 같아야 한다.
+		static void Deallocate(uint8_t* p, size_t size);
+
+		// size 가 실제로 할당되는 블록 크기.
+		static size_t BlockSize(size_t size);
+
+		// 크기별 hit/miss. 종료된 스레드의 값도 포함한다.
+		static std::vector<BufferPoolStats> GetStats();
+	};
+
+	// BufferPool 을 사용하는 표준 할당자.
+	template <typename T>
+	class PoolAllocator
+	{
+	public:
+		using value_type = T;
+
+		PoolAllocator() = default;
+
+		template <typename U>
+		PoolAllocator(const PoolAllocator<U>&) noexcept
+		{
+		}
+
+		T* allocate(size_t n)
+		{
+			return reinterpret_cast<T*>(BufferPool::Allocate(n * sizeof(T)));
+		}
+
+		void deallocate(T* p, size_t n)
+		{
+			BufferPool::Deallocate(reinterpret_cast<uint8_t*>(p), n * sizeof(T));
+		}
+
+		template <typename U>
+		bool operator==(const PoolAllocator<U>&) const noexcept
+		{
+			return true;
+		}
+
+		template <typename U>
+		bool operator!=(const PoolAllocator<U>&) const noexcept
+		{
+			return false;
+		}
+	};
+
+} // namespace net
\ No newline at end of file
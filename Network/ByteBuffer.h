@@ -6,6 +6,9 @@
 #include <algorithm>
 #include <array>
 #include <vector>
+#include <memory>
+#include <cstring>
+#include "BufferPool.h"
 
 namespace net {
 
@@ -16,71 +19,95 @@ namespace net {
 		typedef ByteBuffer<Allocator> this_type;
 
 		explicit ByteBuffer(std::size_t initial_capacity = 1024, std::size_t max_capacity = std::numeric_limits<size_t>::max(), const Allocator& allocator = Allocator())
-			: max_capacity_(max_capacity)
-			, r_index_(0)
+			: r_index_(0)
 			, w_index_(0)
-			, data_(allocator)
+			, max_capacity_(max_capacity)
+			, data_(nullptr)
+			, capacity_(0)
+			, allocator_(allocator)
 		{
 			size_t size = std::min<size_t>(max_capacity_, initial_capacity);
-			data_.resize(std::max<size_t>(size, 1));	// ּ ũ 1Ҵ.
+			AdjustCapacity(std::max<size_t>(size, 1));	// 최소 크기 1할당.
 		}
 
-		//  
+		~ByteBuffer()
+		{
+			Deallocate();
+		}
+
+		// 복사 생성자
 		ByteBuffer(const this_type& rhs)
-			: max_capacity_(0)
-			, r_index_(0)
+			: r_index_(0)
 			, w_index_(0)
-			, data_()
+			, max_capacity_(0)
+			, data_(nullptr)
+			, capacity_(0)
+			, allocator_(rhs.allocator_)
 		{
 			*this = rhs;
 		}
 
-		//  
+		// 대입 연산자
 		this_type& operator=(const this_type& rhs)
 		{
 			if (this == &rhs)
 				return *this;
 
+			// 쓰여진 부분만 복사한다.
+			Deallocate();
+			if (rhs.data_)
+			{
+				data_ = AllocTraits::allocate(allocator_, rhs.capacity_);
+				capacity_ = rhs.capacity_;
+				std::memcpy(data_, rhs.data_, rhs.w_index_);
+			}
+
 			max_capacity_ = rhs.max_capacity_;
 			r_index_ = rhs.r_index_;
 			w_index_ = rhs.w_index_;
-			data_ = rhs.data_;
 
 			return *this;
 		}
 
-		// ̵ 
+		// 이동 생성자
 		ByteBuffer(this_type&& rhs) noexcept
-			: max_capacity_(0)
-			, r_index_(0)
+			: r_index_(0)
 			, w_index_(0)
-			, data_()
+			, max_capacity_(0)
+			, data_(nullptr)
+			, capacity_(0)
+			, allocator_(rhs.allocator_)
 		{
 			*this = std::move(rhs);
 		}
 
-		// ̵  
+		// 이동 대입 연산자
 		this_type& operator=(this_type&& rhs) noexcept
 		{
 			if (this == &rhs)
 				return *this;
 
+			Deallocate();
 			max_capacity_ = rhs.max_capacity_;
 			r_index_ = rhs.r_index_;
 			w_index_ = rhs.w_index_;
-			data_ = std::move(rhs.data_);
+			data_ = rhs.data_;
+			capacity_ = rhs.capacity_;
+			rhs.data_ = nullptr;
+			rhs.capacity_ = 0;
 			rhs.r_index_ = rhs.w_index_ = 0;
 
 			return *this;
 		}
 
-		//  뷮.
+		// 버퍼의 용량.
 		size_t Capacity() const
 		{
-			return data_.size();
+			return capacity_;
 		}
 
-		//  뷮  Ѵ.
+		// 버퍼의 용량을 조절 한다.
+		// 새 메모리는 0 으로 초기화하지 않고 WriterIndex 까지만 복사한다.
 		void AdjustCapacity(size_t new_capacity)
 		{
 			if (new_capacity > MaxCapacity())
@@ -88,10 +115,20 @@ namespace net {
 				throw std::out_of_range("new_capacity exceeds MaxCapacity");
 			}
 
-			size_t old_capacity = data_.size();
-			//  ũ⸦ .
-			data_.resize(new_capacity);
-			//  ũ⺸ پ 
+			if (new_capacity == capacity_)
+				return;
+
+			size_t old_capacity = capacity_;
+			// 버퍼 크기를 리사이즈.
+			uint8_t* new_data = AllocTraits::allocate(allocator_, new_capacity);
+			if (data_)
+			{
+				std::memcpy(new_data, data_, std::min(w_index_, new_capacity));
+				AllocTraits::deallocate(allocator_, data_, capacity_);
+			}
+			data_ = new_data;
+			capacity_ = new_capacity;
+			// 이전 크기보다 줄어들 경우
 			if (new_capacity < old_capacity)
 			{
 				if (ReaderIndex() < new_capacity)
@@ -108,7 +145,7 @@ namespace net {
 			}
 		}
 
-		//  ִ 뷮.
+		// 버퍼 최대 용량.
 		size_t MaxCapacity() const
 		{
 			return max_capacity_;
@@ -153,55 +190,55 @@ namespace net {
 			w_index_ = writer_index;
 		}
 
-		//  ִ ũ⸦ ´
+		// 읽을수 있는 크기를 얻는다
 		size_t ReadableBytes() const
 		{
 			return WriterIndex() - ReaderIndex();
 		}
 
-		//  ִ ũ⸦ ´ (new_capacity )
+		// 쓸수 있는 크기를 얻는다 (new_capacity 까지)
 		size_t WritableBytes() const
 		{
 			return Capacity() - WriterIndex();
 		}
 
-		// Max cpapcity   ִ ũ⸦ ´
+		// Max cpapcity 까지 쓸수 있는 크기를 얻는다
 		size_t MaxWritableBytes() const
 		{
 			return MaxCapacity() - WriterIndex();
 		}
 
-		//  ִ  ִ ˻
+		// 읽을수 있는 공간이 있는지 검사
 		bool IsReadable() const
 		{
 			return ReadableBytes() > 0;
 		}
 
-		// size ŭ  ִ ˻
+		// size 만큼 읽을수 있는지 검사
 		bool IsReadable(int size) const
 		{
 			return ReadableBytes() >= size;
 		}
 
-		//  ִ  ִ ˻
+		// 쓸수 있는 공간이 있는지 검사
 		bool IsWritable() const
 		{
 			return WritableBytes() > 0;
 		}
 
-		// size ŭ  ִ ˻
+		// size 만큼 쓸수 있는지 검사
 		bool IsWritable(int size) const
 		{
 			return WritableBytes() >= size;
 		}
 
-		// ReaderIndex, WriterIndex  0  .  ͸  ʴ´.
+		// ReaderIndex, WriterIndex 를 0 으로 설정. 내부 데이터를 지우지는 않는다.
 		void Clear()
 		{
 			r_index_ = w_index_ = 0;
 		}
 
-		// ̹  Ʈ     Ʈ  
+		// 이미 읽은 바이트는 버리고 뒤의 읽지 않은 바이트를 앞으로 땡긴다
 		void DiscardReadBytes()
 		{
 			if (r_index_ == 0)
@@ -213,28 +250,28 @@ namespace net {
 				return;
 			}
 
-			//  
-			std::memmove(data_.data(), data_.data() + r_index_, w_index_ - r_index_);
+			// 앞으로 땡긴다
+			std::memmove(data_, data_ + r_index_, w_index_ - r_index_);
 			w_index_ -= r_index_;
 			r_index_ = 0;
 		}
 
-		// min_writable_bytes ŭ  ִ  ȮѴ.
+		// min_writable_bytes 만큼 쓸수 있는 공간을 확보한다.
 		void EnsureWritable(size_t min_writable_bytes)
 		{
-			//  ִ  
+			// 쓸수 있는 공간이 충분
 			if (min_writable_bytes <= WritableBytes())
 				return;
 
-			// ִ 뷮 ʰ
+			// 최대 용량 초과
 			if (WriterIndex() + min_writable_bytes > MaxCapacity())
 			{
 				throw std::out_of_range("Ensure writable bytes is greater than the max capacity");
 			}
 
-			// 뷮 (2辿 )
+			// 용량 계산(2배씩 증가)
 			size_t new_capacity = CalcNewCapacity(WriterIndex() + min_writable_bytes);
-			// 뷮 ũ⸦ Ѵ.
+			// 용량 크기를 조절한다.
 			AdjustCapacity(new_capacity);
 		}
 
@@ -247,11 +284,11 @@ namespace net {
 		template <typename PodType>
 		void GetPOD(size_t index, PodType* dst) const
 		{
-			// POD Ÿ ƴϸ  
+			// POD 타입이 아니면 컴파일 에러
 			static_assert(std::is_pod<PodType>::value, "dst is not pod.");
 
 			//std::memcpy(dst, data_.at(0) + rpos_, length);
-			*dst = *((PodType*)(data_.data() + index));
+			*dst = *((PodType*)(data_ + index));
 		}
 
 		void GetBytes(size_t index, this_type& dst) const
@@ -280,7 +317,7 @@ namespace net {
 		void GetBytes(size_t index, uint8_t* dst, size_t dstIndex, size_t length) const
 		{
 			CheckIndex(index, length);
-			std::memcpy(dst + dstIndex, data_.data() + index, length);
+			std::memcpy(dst + dstIndex, data_ + index, length);
 		}
 
 		template <typename PodType>
@@ -292,11 +329,11 @@ namespace net {
 		template <typename PodType>
 		void SetPOD(size_t index, const PodType* value)
 		{
-			// POD Ÿ ƴϸ  
+			// POD 타입이 아니면 컴파일 에러
 			static_assert(std::is_pod<PodType>::value, "value is not pod.");
 
-			//std::memcpy(data_.data() + index, value, length);
-			*(PodType*)(data_.data() + index) = *value;
+			//std::memcpy(data_ + index, value, length);
+			*(PodType*)(data_ + index) = *value;
 		}
 
 		void SetByte(size_t index, const this_type& src)
@@ -325,17 +362,17 @@ namespace net {
 		void SetBytes(size_t index, const uint8_t* src, size_t srcIndex, size_t length)
 		{
 			CheckIndex(index, length);
-			std::memcpy(data_.data() + index, src + srcIndex, length);
+			std::memcpy(data_ + index, src + srcIndex, length);
 		}
 
-		// index ġ . ReaderIndex, WriterIndex   ʴ´. ʿϸ   ϵѴ.
+		// index 위치에 삽입. ReaderIndex, WriterIndex 를 변경하지 않는다. 필요하면 직접 변경 하도록한다.
 		void InsertBytes(size_t index, const uint8_t* src, size_t srcIndex, size_t length)
 		{
 			CheckIndex(index);
-			size_t old_cap = Capacity();
 			size_t add_length = (index > w_index_) ? (index - w_index_) : 0;
+			size_t move_length = (index < w_index_) ? (w_index_ - index) : 0;
 			EnsureWritable(length + add_length);
-			std::memmove(Data() + index + length, Data() + index, old_cap - index);
+			std::memmove(Data() + index + length, Data() + index, move_length);
 			SetBytes(index, src, srcIndex, length);
 		}
 
@@ -365,14 +402,14 @@ namespace net {
 		void Read(float* dst) { ReadPOD(dst); }
 		void Read(double* dst) { ReadPOD(dst); }
 
-		// POD ŸԸ д´. ReaderIndex  ŭ Ų.
+		// POD 타입만 읽는다. ReaderIndex 를 읽은만큼 전진시킨다.
 		template <typename PodType>
 		void ReadPOD(PodType& dst)
 		{
 			ReadPOD(&dst);
 		}
 
-		// POD ŸԸ д´. ReaderIndex  ŭ Ų.
+		// POD 타입만 읽는다. ReaderIndex 를 읽은만큼 전진시킨다.
 		template <typename PodType>
 		void ReadPOD(PodType* dst)
 		{
@@ -382,7 +419,7 @@ namespace net {
 			r_index_ += length;
 		}
 
-		// ۿ length ŭ Ʈ а  ۷ .
+		// 버퍼에서 length 만큼의 바이트를 읽고 새 버퍼로 리턴.
 		this_type ReadBytes(size_t length)
 		{
 			CheckReadableBytes(length);
@@ -432,7 +469,7 @@ namespace net {
 			r_index_ += length;
 		}
 
-		// bytes ŭ ReaderIndex  Ų.
+		// bytes 만큼 ReaderIndex 전진 시킨다.
 		void SkipBytes(size_t length)
 		{
 			CheckReadableBytes(length);
@@ -443,7 +480,7 @@ namespace net {
 		//template <typename PodType, std::size_t N>
 		//void Send(const PodType(&src)[N])
 		//{
-		//	// POD Ÿ ƴϸ  
+		//	// POD 타입이 아니면 컴파일 에러
 		//	static_assert(std::is_pod<PodType>::value, "src is not pod.");
 
 		//	Send((uint8_t*)src, N * sizeof(PodType));
@@ -453,7 +490,7 @@ namespace net {
 		//template <typename PodType, std::size_t N>
 		//void Send(const std::array<PodType, N>& src)
 		//{
-		//	// POD Ÿ ƴϸ  
+		//	// POD 타입이 아니면 컴파일 에러
 		//	static_assert(std::is_pod<PodType>::value, "src is not pod.");
 
 		//	Send((uint8_t*)src.data(), src.size() * sizeof(PodType));
@@ -463,7 +500,7 @@ namespace net {
 		//template <typename PodType, typename Allocator>
 		//void Send(const std::vector<PodType, Allocator>& src)
 		//{
-		//	// POD Ÿ ƴϸ  
+		//	// POD 타입이 아니면 컴파일 에러
 		//	static_assert(std::is_pod<PodType>::value, "src is not pod.");
 
 		//	Send((uint8_t*)src.data(), src.size() * sizeof(PodType));
@@ -502,7 +539,7 @@ namespace net {
 		void Write(const float* value) { WritePOD(value); }
 		void Write(const double* value) { WritePOD(value); }
 
-		// POD ŸԸ . WriterIndex  ŭ Ѵ.
+		// POD 타입만 쓴다. WriterIndex 를 쓴만큼 전진한다.
 		template <typename PodType>
 		void WritePOD(const PodType& src)
 		{
@@ -552,19 +589,19 @@ namespace net {
 			w_index_ += length;
 		}
 
-		//   迭 .
+		// 버퍼의 내부 배열을 리턴.
 		const uint8_t* Data() const
 		{
-			return data_.data();
+			return data_;
 		}
 
-		//   迭 .
+		// 버퍼의 내부 배열을 리턴.
 		uint8_t* Data()
 		{
-			return data_.data();
+			return data_;
 		}
 
-		// Copy Լ  縦 Ѵ
+		// Copy 함수들은 깊은 복사를 한다
 		this_type Copy() const
 		{
 			return Copy(ReaderIndex(), ReadableBytes());
@@ -574,7 +611,7 @@ namespace net {
 		{
 			CheckIndex(index, length);
 
-			this_type new_buffer(length, MaxCapacity(), data_.get_allocator());
+			this_type new_buffer(length, MaxCapacity(), allocator_);
 			std::memcpy(new_buffer.Data(), Data() + index, length);
 			new_buffer.WriterIndex(length);
 
@@ -582,7 +619,7 @@ namespace net {
 		}
 
 	protected:
-		//  ȿ üũѴ.
+		// 영역이 유효한지 체크한다.
 		void CheckIndex(size_t index) const
 		{
 			if (index >= Capacity())
@@ -599,7 +636,7 @@ namespace net {
 			}
 		}
 
-		// readable_bytes ŭ  ִ üũѴ
+		// readable_bytes 만큼 읽을수 있는지 체크한다
 		void CheckReadableBytes(size_t min_readable_bytes) const
 		{
 			if (r_index_ + min_readable_bytes > w_index_)
@@ -608,11 +645,11 @@ namespace net {
 			}
 		}
 
-		//  Ҵ  ũ⸦ 
+		// 새로 할당할 버퍼 크기를 계산
 		size_t CalcNewCapacity(size_t min_new_capacity)
 		{
 			size_t max_capacity = MaxCapacity();
-			// ι辿 δ.  ũ 64.
+			// 두배씩 늘인다. 시작 크기는 64.
 			size_t new_capacity = 64;
 			while (new_capacity < min_new_capacity)
 			{
@@ -622,12 +659,26 @@ namespace net {
 			return std::min<size_t>(new_capacity, max_capacity);
 		}
 
+		void Deallocate()
+		{
+			if (data_)
+			{
+				AllocTraits::deallocate(allocator_, data_, capacity_);
+				data_ = nullptr;
+				capacity_ = 0;
+			}
+		}
+
+		using AllocTraits = std::allocator_traits<Allocator>;
+
 		size_t r_index_, w_index_;
 		size_t max_capacity_;
-		std::vector<uint8_t> data_;
+		uint8_t* data_;
+		size_t capacity_;
+		Allocator allocator_;
 	};
 
-	// ⺻  Ÿ.
-	using Buffer = net::ByteBuffer<>;
+	// 기본 버퍼 타입. BufferPool 의 블록을 사용한다.
+	using Buffer = net::ByteBuffer<PoolAllocator<uint8_t>>;
 
 } // namespace net
\ No newline at end of file
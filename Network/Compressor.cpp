@@ -0,0 +1,255 @@
+#include <cstring>
+#include <vector>
+#include "Compressor.h"
+#include "SendBuffer.h"
+
+namespace net {
+
+namespace {
+
+	constexpr size_t MIN_MATCH = 4;
+	constexpr size_t MAX_OFFSET = 65535;
+	// 마지막 LAST_LITERALS 바이트는 항상 literal 로 보낸다.
+	constexpr size_t LAST_LITERALS = 5;
+	constexpr size_t MATCH_LIMIT = 12;
+	constexpr int HASH_BITS = 12;
+
+	inline uint32_t Read32(const uint8_t* p)
+	{
+		uint32_t v;
+		std::memcpy(&v, p, sizeof(v));
+		return v;
+	}
+
+	inline uint32_t Hash(uint32_t v)
+	{
+		return (v * 2654435761U) >> (32 - HASH_BITS);
+	}
+
+	// 길이 확장 바이트 (255 단위)
+	inline bool WriteLength(uint8_t*& op, uint8_t* end, size_t len)
+	{
+		while (len >= 255)
+		{
+			if (op >= end) return false;
+			*op++ = 255;
+			len -= 255;
+		}
+		if (op >= end) return false;
+		*op++ = static_cast<uint8_t>(len);
+		return true;
+	}
+
+	inline bool ReadLength(const uint8_t*& ip, const uint8_t* end, size_t& len)
+	{
+		uint8_t b = 0;
+		do
+		{
+			if (ip >= end) return false;
+			b = *ip++;
+			len += b;
+		} while (b == 255);
+		return true;
+	}
+
+	// literal 과 match 하나를 쓴다. match_len 이 0 이면 literal 만 쓴다.
+	bool WriteSequence(uint8_t*& op, uint8_t* end, const uint8_t* literal, size_t literal_len, size_t offset, size_t match_len)
+	{
+		if (op >= end) return false;
+		uint8_t* token = op++;
+		size_t ml = (match_len > 0) ? match_len - MIN_MATCH : 0;
+		*token = static_cast<uint8_t>(((literal_len >= 15 ? 15 : literal_len) << 4) | (ml >= 15 ? 15 : ml));
+
+		if (literal_len >= 15 && !WriteLength(op, end, literal_len - 15))
+			return false;
+
+		if (static_cast<size_t>(end - op) < literal_len)
+			return false;
+		std::memcpy(op, literal, literal_len);
+		op += literal_len;
+
+		if (match_len == 0)
+			return true;
+
+		if (end - op < 2) return false;
+		*op++ = static_cast<uint8_t>(offset & 0xff);
+		*op++ = static_cast<uint8_t>(offset >> 8);
+
+		if (ml >= 15 && !WriteLength(op, end, ml - 15))
+			return false;
+
+		return true;
+	}
+
+	// 스레드 공용 버퍼. 압축 해제한 payload 를 처리하는 도중에 압축할수 있으므로 따로 쓴다.
+	thread_local std::vector<uint8_t> t_compress_scratch;
+	thread_local std::vector<uint8_t> t_decompress_scratch;
+
+	// 이보다 커진 공용 버퍼는 작은 프레임이 오면 놓아준다. 큰 프레임 하나로 스레드마다 메모리가 남지 않게 한다.
+	constexpr size_t SCRATCH_KEEP_SIZE = 64 * 1024;
+
+	uint8_t* PrepareScratch(std::vector<uint8_t>& scratch, size_t size)
+	{
+		if (scratch.capacity() > SCRATCH_KEEP_SIZE && size <= SCRATCH_KEEP_SIZE)
+			std::vector<uint8_t>().swap(scratch);
+
+		scratch.resize(size);
+		return scratch.data();
+	}
+
+} // namespace
+
+size_t Compressor::MaxCompressedSize(size_t size)
+{
+	return size + size / 255 + 16;
+}
+
+size_t Compressor::Compress(const uint8_t* src, size_t size, uint8_t* dst, size_t capacity)
+{
+	uint8_t* op = dst;
+	uint8_t* op_end = dst + capacity;
+
+	// 위치 + 1 을 저장한다. 0 은 비어있음.
+	uint32_t table[1 << HASH_BITS] = { 0 };
+
+	size_t ip = 0;
+	size_t anchor = 0;
+	size_t limit = (size > MATCH_LIMIT) ? size - MATCH_LIMIT : 0;
+	while (ip < limit)
+	{
+		uint32_t seq = Read32(src + ip);
+		uint32_t h = Hash(seq);
+		size_t ref = table[h];
+		table[h] = static_cast<uint32_t>(ip + 1);
+
+		if (ref == 0 || ip - (ref - 1) > MAX_OFFSET || Read32(src + ref - 1) != seq)
+		{
+			ip++;
+			continue;
+		}
+		ref -= 1;
+
+		size_t match_len = MIN_MATCH;
+		size_t match_end = size - LAST_LITERALS;
+		while (ip + match_len < match_end && src[ref + match_len] == src[ip + match_len])
+		{
+			match_len++;
+		}
+
+		if (!WriteSequence(op, op_end, src + anchor, ip - anchor, ip - ref, match_len))
+			return 0;
+
+		ip += match_len;
+		anchor = ip;
+	}
+
+	// 남은 literal
+	if (!WriteSequence(op, op_end, src + anchor, size - anchor, 0, 0))
+		return 0;
+
+	return op - dst;
+}
+
+bool Compressor::Decompress(const uint8_t* src, size_t size, uint8_t* dst, size_t dst_size)
+{
+	const uint8_t* ip = src;
+	const uint8_t* ip_end = src + size;
+	uint8_t* op = dst;
+	uint8_t* op_end = dst + dst_size;
+
+	while (ip < ip_end)
+	{
+		uint8_t token = *ip++;
+
+		size_t literal_len = token >> 4;
+		if (literal_len == 15 && !ReadLength(ip, ip_end, literal_len))
+			return false;
+
+		if (static_cast<size_t>(ip_end - ip) < literal_len || static_cast<size_t>(op_end - op) < literal_len)
+			return false;
+		std::memcpy(op, ip, literal_len);
+		ip += literal_len;
+		op += literal_len;
+
+		// 마지막 sequence 는 literal 만 있다.
+		if (ip == ip_end)
+			break;
+
+		if (ip_end - ip < 2)
+			return false;
+		size_t offset = ip[0] | (ip[1] << 8);
+		ip += 2;
+		if (offset == 0 || offset > static_cast<size_t>(op - dst))
+			return false;
+
+		size_t match_len = token & 15;
+		if (match_len == 15 && !ReadLength(ip, ip_end, match_len))
+			return false;
+		match_len += MIN_MATCH;
+
+		if (static_cast<size_t>(op_end - op) < match_len)
+			return false;
+
+		// 겹칠수 있으므로 한 바이트씩 복사한다.
+		const uint8_t* match = op - offset;
+		for (size_t i = 0; i < match_len; i++)
+		{
+			op[i] = match[i];
+		}
+		op += match_len;
+	}
+
+	return op == op_end;
+}
+
+Ptr<const SendBuffer> Compressor::CompressFrame(const SendBuffer& frame)
+{
+	FrameHeader header = frame.Header();
+	const uint8_t* payload = frame.Data() + sizeof(FrameHeader);
+	size_t payload_size = frame.Size() - sizeof(FrameHeader);
+
+	uint8_t* scratch = PrepareScratch(t_compress_scratch, MaxCompressedSize(payload_size));
+	size_t compressed_size = Compress(payload, payload_size, scratch, t_compress_scratch.size());
+	if (compressed_size == 0 || compressed_size + sizeof(uint32_t) >= payload_size)
+		return nullptr;
+
+	// [헤더][원래 크기][압축 블록]
+	Buffer buf(sizeof(FrameHeader) + sizeof(uint32_t) + compressed_size);
+	buf.WriterIndex(sizeof(FrameHeader));
+	buf.ReaderIndex(sizeof(FrameHeader));
+	buf.Write(static_cast<uint32_t>(payload_size));
+	buf.WriteBytes(scratch, compressed_size);
+	// 메시지 타입은 압축하지 않고 헤더에 그대로 둔다.
+	return ByteSendBuffer::Create(std::move(buf), FrameHeader::COMPRESSED, header.message_type);
+}
+
+uint8_t* Compressor::DecompressPayload(const uint8_t* payload, size_t size, size_t max_size, size_t& out_size)
+{
+	if (size < sizeof(uint32_t))
+		return nullptr;
+
+	uint32_t original_size = 0;
+	std::memcpy(&original_size, payload, sizeof(original_size));
+	if (original_size > max_size)
+		return nullptr;
+
+	// 메모리가 모자라도 세션만 닫히도록 예외는 여기서 막는다.
+	uint8_t* dst = nullptr;
+	try
+	{
+		dst = PrepareScratch(t_decompress_scratch, original_size);
+	}
+	catch (const std::exception& e)
+	{
+		BOOST_LOG_TRIVIAL(warning) << "Decompress buffer allocation failed: " << e.what() << ", size: " << original_size;
+		return nullptr;
+	}
+
+	if (!Decompress(payload + sizeof(uint32_t), size - sizeof(uint32_t), dst, original_size))
+		return nullptr;
+
+	out_size = original_size;
+	return dst;
+}
+
+} // namespace net
\ No newline at end of file
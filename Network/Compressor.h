@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Types.h"
+
+namespace net {
+
+	class SendBuffer;
+
+	// LZ77 계열의 블록 압축. (LZ4 블록 포맷과 같은 구조)
+	// 압축된 프레임의 payload 는 [uint32 원래 크기][압축 블록] 이다.
+	class Compressor
+	{
+	public:
+		// size 바이트를 압축했을때 필요한 최대 크기.
+		static size_t MaxCompressedSize(size_t size);
+
+		// src 를 압축해서 dst 에 쓴다. 압축된 크기를 리턴. capacity 를 넘으면 0.
+		static size_t Compress(const uint8_t* src, size_t size, uint8_t* dst, size_t capacity);
+
+		// 압축을 풀어 dst 에 정확히 dst_size 바이트를 쓴다. 데이터가 잘못되었으면 false.
+		static bool Decompress(const uint8_t* src, size_t size, uint8_t* dst, size_t dst_size);
+
+		// 프레임을 압축한 새 프레임을 만든다. 크기가 줄지 않으면 nullptr.
+		static Ptr<const SendBuffer> CompressFrame(const SendBuffer& frame);
+
+		// 압축된 payload 를 스레드 공용 버퍼에 푼다. 다음 호출 전까지만 유효하다.
+		// 풀린 크기가 max_size 를 넘거나 데이터가 잘못되었거나 메모리를 잡지 못하면 nullptr.
+		static uint8_t* DecompressPayload(const uint8_t* payload, size_t size, size_t max_size, size_t& out_size);
+	};
+
+} // namespace net
\ No newline at end of file
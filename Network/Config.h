@@ -1,21 +1,116 @@
 #pragma once
 
 #include <thread>
+#include <vector>
+#include <string>
+#include <utility>
 #include "Types.h"
 
 namespace net {
 
 	class EventLoop;
 
+	enum class EventLoopMode
+	{
+		Shared,				// 모든 스레드가 하나의 io_context 를 실행한다.
+		ContextPerThread	// 스레드마다 자신의 io_context 를 실행한다. 세션은 하나의 스레드에 고정된다.
+	};
+
+	// ContextPerThread 모드에서 새 세션을 배정할 io_context 를 고르는 방법.
+	enum class SessionAffinity
+	{
+		RoundRobin,			// 차례대로 배정.
+		LeastLoad			// 세션 수가 가장 적은 곳에 배정.
+	};
+
+	// 토큰 버킷 설정. 초당 rate 개씩 채워지고 burst 개까지 모인다. rate 가 0 이면 제한하지 않는다.
+	struct RateLimit
+	{
+		double				rate = 0;
+		double				burst = 1;
+	};
+
+	// EventLoop 의 스레드 설정.
+	struct EventLoopConfig
+	{
+		std::size_t			thread_count = std::thread::hardware_concurrency(); // 0 이면 hardware_concurrency.
+		EventLoopMode		mode = EventLoopMode::Shared;
+		// 실행할 핸들러가 없어도 이 시간(us) 동안은 블록하지 않고 poll 한다. 0 이면 바로 블록한다.
+		// 블록했다가 깨어나는 지연이 줄어드는 대신 그동안 코어를 점유한다. ContextPerThread 모드에서 사용한다.
+		size_t				spin_time = 0;
+		// i 번째 스레드를 cpu_affinity[i % size] 번 코어에 고정한다. 비어 있으면 고정하지 않는다.
+		std::vector<int>	cpu_affinity;
+		// 스레드 이름은 thread_name 뒤에 스레드 번호를 붙인다.
+		std::string			thread_name = "net";
+		// 스레드별 사용률(GetThreadStats)을 센다. 끄고 spin_time 이 0 이면 io_context::run 으로 바로 실행한다.
+		bool				thread_stats = false;
+	};
+
 	struct ServerConfig
 	{
 		// execution
 		Ptr<EventLoop>		event_loop = nullptr;
-		std::size_t			thread_count = std::thread::hardware_concurrency(); // event_loop  Ǿ  ̰ .
+		std::size_t			thread_count = std::thread::hardware_concurrency(); // event_loop 이 설정되어 있으면 이값은 무시.
+		EventLoopMode		event_loop_mode = EventLoopMode::Shared; // event_loop 이 설정되어 있으면 이값은 무시.
+		SessionAffinity		session_affinity = SessionAffinity::RoundRobin;
+		// accept
+		size_t				accept_count = 1;		// acceptor 마다 동시에 대기하는 accept 수.
+		bool				reuse_port = false;		// io_context 마다 SO_REUSEPORT acceptor 를 만든다. 지원하지 않으면 무시.
+		size_t				accept_retry_interval = 100;	// 파일 디스크립터나 메모리가 모자라 accept 가 실패하면 이 시간(ms) 뒤에 다시 받는다.
 		// session
 		size_t				max_session_count = 100000;
 		size_t				min_receive_size = 1024 * 4;
 		size_t				max_receive_buffer_size = std::numeric_limits<size_t>::max();
+		// true 이면 스레드별 공용 버퍼로 받고 세션은 프레임 조각만 보관한다.
+		// 대기중인 세션은 수신 버퍼를 가지지 않는다. 사용량은 NetServer::GetReceiveMemoryStats 로 얻는다.
+		bool				shared_receive_buffer = false;
+		// true 이면 세션이 cork 상태로 시작한다. Session::Flush 를 호출해야 보낸다.
+		bool				cork = false;
+		// cork 상태에서 모인 크기가 이 값을 넘으면 Flush 없이도 보낸다.
+		size_t				cork_threshold = 1024 * 16;
+		// 보내지 못하고 쌓인 데이터의 최대 크기. 넘은 상태가 send_overflow_timeout 동안 이어지거나 두배를 넘으면 연결을 끊는다.
+		size_t				max_send_buffer_size = std::numeric_limits<size_t>::max();
+		// max_send_buffer_size 를 넘어도 이 시간(ms) 안에 줄어들면 연결을 유지한다. 0 이면 넘는 즉시 끊는다.
+		size_t				send_overflow_timeout = 1000;
+		// payload 가 이 값 이상인 프레임은 압축해서 보낸다. 0 이면 압축하지 않는다.
+		// 받는 쪽은 설정과 관계없이 압축된 프레임을 처리한다.
+		size_t				compress_threshold = 0;
+		// 압축된 프레임을 풀었을때 허용하는 최대 크기. 넘으면 연결을 끊는다.
+		// 원래 크기는 보내는 쪽이 정하므로 max_receive_buffer_size 와 따로 작게 둔다.
+		size_t				max_decompressed_size = 1024 * 1024;
+		// 한번 받은 데이터에서 처리하는 최대 프레임 수. 넘으면 이벤트 루프에 양보한 뒤 이어서 처리하고 그동안 읽지 않는다.
+		// 프레임을 몰아서 보내는 세션이 스레드를 오래 점유하지 못하게 한다. 0 이면 제한하지 않는다.
+		size_t				max_frames_per_read = 0;
+		// 세션마다 받을수 있는 메시지의 비율. 넘은 메시지는 버리고 위반으로 센다.
+		RateLimit			message_rate_limit;
+		// message_type 별 비율. 세션마다 따로 센다. message_rate_limit 와 함께 적용한다.
+		std::vector<std::pair<uint16_t, RateLimit>> message_type_rate_limits;
+		// 세션의 위반이 이 수에 이르면 CloseReason::RateLimited 로 닫는다. 0 이면 닫지 않는다.
+		size_t				max_rate_violations = 0;
+		// 이 시간(ms) 동안 받은 데이터가 없는 세션은 CloseReason::Timeout 으로 닫는다. 0 이면 검사하지 않는다.
+		// payload 가 없는 프레임을 heartbeat 로 보내면 연결이 유지된다.
+		size_t				idle_timeout = 0;
+		// idle_timeout 을 검사하는 간격(ms). 타이밍 휠의 틱 크기.
+		size_t				idle_check_interval = 100;
+		// true 이면 TCP 와 같은 포트로 UDP 를 열고 세션을 열때 token 을 보낸다.
+		// 클라이언트가 token 으로 바인드하면 Session::SendUnreliable 이 UDP 로 보낸다.
+		bool				udp_channel = false;
+		// 헤더를 포함한 UDP 데이터그램 최대 크기. 넘는 메시지는 TCP 로 보낸다.
+		size_t				max_datagram_size = 1200;
+		// UDP 로 받을 message_type. 다른 타입의 데이터그램은 버리므로 나머지 메시지는 TCP 로만 받는다.
+		// 비어 있으면 UDP 로는 받지 않는다.
+		std::vector<uint16_t>	udp_message_types;
+		// true 이면 세션을 asio 대신 io_uring 으로 읽고 쓴다. Linux 의 ContextPerThread 모드에서만 사용하고 아니면 무시한다.
+		// 커널이 지원하면 미리 맡긴 수신 버퍼로 multishot 수신을 한다. 세션은 shared_receive_buffer 처럼 프레임 조각만 보관한다.
+		bool				io_uring = false;
+		// io_context 마다 만드는 링의 제출 큐 크기.
+		unsigned			io_uring_entries = 4096;
+		// io_context 마다 커널에 맡기는 수신 버퍼의 크기와 수. 0 이면 multishot 수신을 사용하지 않는다.
+		size_t				io_uring_buffer_size = 1024 * 8;
+		unsigned			io_uring_buffer_count = 1024;
+		// 이 간격(ms) 마다 NetServer::GetNetStats 와 송신 큐가 가장 큰 세션들을 로그로 남긴다. 0 이면 남기지 않는다.
+		size_t				stats_log_interval = 0;
+		size_t				stats_log_sessions = 5;
 		// socket options
 		bool				no_delay = false;
 	};
@@ -27,6 +122,18 @@ namespace net {
 		// session
 		size_t				min_receive_size = 1024 * 4;
 		size_t				max_receive_buffer_size = std::numeric_limits<size_t>::max();
+		// payload 가 이 값 이상인 프레임은 압축해서 보낸다. 0 이면 압축하지 않는다.
+		size_t				compress_threshold = 0;
+		// 압축된 프레임을 풀었을때 허용하는 최대 크기. 넘으면 연결을 끊는다.
+		size_t				max_decompressed_size = 1024 * 1024;
+		// 이 간격(ms) 마다 payload 가 없는 heartbeat 프레임을 보낸다. 0 이면 보내지 않는다.
+		size_t				heartbeat_interval = 0;
+		// true 이면 서버가 보낸 token 으로 UDP 채널을 바인드한다. 서버도 udp_channel 이 켜져 있어야 한다.
+		bool				udp_channel = false;
+		size_t				max_datagram_size = 1200;
+		// UDP 바인드 요청 간격(ms)과 횟수. 응답이 없으면 TCP 만 사용한다.
+		size_t				udp_bind_interval = 200;
+		size_t				udp_bind_attempts = 10;
 		// socket options
 		bool				no_delay = false;
 	};
@@ -24,16 +24,16 @@ namespace net
 
 		const int HEADER_SIZE = sizeof(Header);
 
-		// ڵ
+		// 디코드
 		void Decode(Buffer& read_buf)
 		{
-			// ó Ͱ  ݺ
+			// 처리할 데이터가 있으면 반복
 			while (read_buf.IsReadable())
 			{
 				// Decode MsgHeader
 				if (!header_decoded_)
 				{
-					// ڵ尡 ϸ .
+					// 디코드가 실패하면 나간다.
 					if (!DecodeHeader(read_buf))
 						break;
 				}
@@ -48,16 +48,16 @@ namespace net
 		}
 
 	private:
-		//  ڵ
+		// 헤더 디코드
 		bool DecodeHeader(Buffer& read_buf)
 		{
-			//   ŭ   
+			// 헤더 사이즈 만큼 받지 못했으면 리턴
 			if (!read_buf.IsReadable(HEADER_SIZE))
 			{
 				return false;
 			}
 
-			// TO DO :  ? ȣȭ?
+			// TO DO : 헤더 검증? 복호화?
 			read_buf.Read(header_.opCode);
 			read_buf.Read(header_.payload_length);
 
@@ -65,18 +65,18 @@ namespace net
 			return true;
 		}
 
-		// ٵ ڵ
+		// 바디 디코드
 		bool DecodeBody(Buffer& read_buf)
 		{
 			if (!read_buf.IsReadable(header_.payload_length))
 				return false;
 
-			// TO DO : Deserialize. ޽ ü .
-			// Ϸ ڵ鷯 ݹ
+			// TO DO : Deserialize. 메시지 객체로 만든다.
+			// 완료 핸들러 콜백
 
-			// body  ŭ ReaderIndex .
+			// body 사이즈 만큼 ReaderIndex 전진.
 			read_buf.SkipBytes(header_.payload_length);
-			//  ʱȭ
+			// 헤더 초기화
 			header_decoded_ = false;
 			header_.opCode = 0;
 			header_.payload_length = 0;
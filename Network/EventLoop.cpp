@@ -1,23 +1,136 @@
 #include "EventLoop.h"
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#endif
 
 namespace net {
 
-EventLoop::EventLoop(size_t thread_count)
-	: work_(asio::make_work_guard(io_context_))
+namespace {
+
+	using Clock = std::chrono::steady_clock;
+
+	// 빈 poll 은 1us 보다 짧으므로 ns 로 센다.
+	uint64_t ToNanoseconds(Clock::duration duration)
+	{
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+	}
+
+	// 현재 스레드가 사용한 CPU 시간. 블록한 동안에는 늘지 않으므로 깨어나서 핸들러를 실행한 시간을 구할때 사용한다.
+	Clock::duration ThreadCpuTime()
+	{
+#if defined(__linux__)
+		timespec ts;
+		if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+			return std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec));
+		return Clock::duration::zero();
+#elif defined(_WIN32)
+		// 해상도가 낮아서 누적 값만 의미가 있다.
+		FILETIME creation, exit, kernel, user;
+		if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user))
+			return Clock::duration::zero();
+		uint64_t total = ((static_cast<uint64_t>(kernel.dwHighDateTime) << 32) | kernel.dwLowDateTime)
+			+ ((static_cast<uint64_t>(user.dwHighDateTime) << 32) | user.dwLowDateTime);
+		return std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(total * 100));
+#else
+		// 구할수 없으면 깨어나서 실행한 핸들러 시간도 idle 로 센다.
+		return Clock::duration::zero();
+#endif
+	}
+
+	void SetThreadName(const std::string& name)
+	{
+#if defined(__linux__)
+		// 커널이 15 글자까지만 저장한다.
+		pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+#elif defined(_WIN32)
+		// SetThreadDescription 은 Windows 10 1607 부터 있으므로 찾아서 호출한다.
+		using SetThreadDescriptionFunc = HRESULT(WINAPI*)(HANDLE, PCWSTR);
+		auto func = reinterpret_cast<SetThreadDescriptionFunc>(GetProcAddress(GetModuleHandleW(L"kernel32.dll"), "SetThreadDescription"));
+		if (func)
+		{
+			std::wstring wide(name.begin(), name.end());
+			func(GetCurrentThread(), wide.c_str());
+		}
+#endif
+	}
+
+	bool PinThread(int cpu)
+	{
+#if defined(__linux__)
+		if (cpu >= CPU_SETSIZE)
+			return false;
+		cpu_set_t cpus;
+		CPU_ZERO(&cpus);
+		CPU_SET(cpu, &cpus);
+		return pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0;
+#elif defined(_WIN32)
+		if (cpu >= static_cast<int>(sizeof(DWORD_PTR) * 8))
+			return false;
+		return SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << cpu) != 0;
+#else
+		BOOST_LOG_TRIVIAL(info) << "cpu affinity is not supported";
+		return false;
+#endif
+	}
+
+} // namespace
+
+EventLoop::EventLoop(size_t thread_count, EventLoopMode mode)
+	: EventLoop(EventLoopConfig{ thread_count, mode, 0, {}, "net", false })
 {
+}
+
+EventLoop::EventLoop(const EventLoopConfig& config)
+	: mode_(config.mode)
+	, spin_time_(config.spin_time)
+	, thread_stats_(config.thread_stats)
+{
+	size_t thread_count = config.thread_count;
 	if (thread_count == 0) {
 		thread_count = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
 	}
-	
-	for (int i = 0; i < thread_count; i++)
+
+	if (mode_ == EventLoopMode::ContextPerThread)
+	{
+		// 하나의 스레드만 실행하므로 io_context 내부의 락을 사용하지 않는다.
+		for (size_t i = 0; i < thread_count; i++)
+		{
+			io_contexts_.emplace_back(std::make_unique<asio::io_context>(1));
+		}
+	}
+	else
+	{
+		io_contexts_.emplace_back(std::make_unique<asio::io_context>());
+	}
+
+	for (auto& io_context : io_contexts_)
+	{
+		works_.emplace_back(asio::make_work_guard(*io_context));
+	}
+
+	for (size_t i = 0; i < thread_count; i++)
+	{
+		auto state = std::make_unique<ThreadState>();
+		state->name = config.thread_name + "-" + std::to_string(i);
+		state->io_context_index = i % io_contexts_.size();
+		if (!config.cpu_affinity.empty())
+			state->cpu = config.cpu_affinity[i % config.cpu_affinity.size()];
+		thread_states_.emplace_back(std::move(state));
+	}
+
+	for (auto& state : thread_states_)
 	{
-		threads_.emplace_back(std::thread([this]()
+		ThreadState& thread_state = *state;
+		threads_.emplace_back(std::thread([this, &thread_state]()
 		{
-				io_context_.run();
+				Run(thread_state);
 		}));
 	}
 
-	BOOST_LOG_TRIVIAL(info) << "Run EventLoop. thread_count:" << thread_count;
+	BOOST_LOG_TRIVIAL(info) << "Run EventLoop. thread_count:" << thread_count << " io_context_count:" << io_contexts_.size()
+		<< " spin_time:" << config.spin_time << "us";
 }
 
 EventLoop::~EventLoop()
@@ -28,8 +141,14 @@ EventLoop::~EventLoop()
 
 void EventLoop::Stop()
 {
-    work_.reset();
-	io_context_.stop();
+	for (auto& work : works_)
+	{
+		work.reset();
+	}
+	for (auto& io_context : io_contexts_)
+	{
+		io_context->stop();
+	}
 
 	BOOST_LOG_TRIVIAL(info) << "Stop EventLoop";
 }
@@ -43,4 +162,79 @@ void EventLoop::Wait()
 	}
 }
 
+std::vector<EventLoopThreadStats> EventLoop::GetThreadStats() const
+{
+	std::vector<EventLoopThreadStats> stats;
+	stats.reserve(thread_states_.size());
+	for (auto& state : thread_states_)
+	{
+		EventLoopThreadStats thread_stats;
+		thread_stats.name = state->name;
+		thread_stats.io_context_index = state->io_context_index;
+		thread_stats.cpu = state->cpu.load(std::memory_order_relaxed);
+		thread_stats.busy_time = LoadStat(state->busy_time) / 1000;
+		thread_stats.spin_time = LoadStat(state->spin_time) / 1000;
+		thread_stats.idle_time = LoadStat(state->idle_time) / 1000;
+		thread_stats.handlers = LoadStat(state->handlers);
+		thread_stats.wakeups = LoadStat(state->wakeups);
+		stats.emplace_back(std::move(thread_stats));
+	}
+	return stats;
+}
+
+void EventLoop::Run(ThreadState& state)
+{
+	SetThreadName(state.name);
+	int cpu = state.cpu.load(std::memory_order_relaxed);
+	if (cpu >= 0 && !PinThread(cpu))
+	{
+		BOOST_LOG_TRIVIAL(info) << "Can not pin " << state.name << " to cpu " << cpu;
+		state.cpu.store(-1, std::memory_order_relaxed);
+	}
+
+	asio::io_context& io_context = *io_contexts_[state.io_context_index];
+	if (spin_time_.count() == 0 && !thread_stats_)
+	{
+		// 셀 것도 poll 할 것도 없으면 매번 시계를 읽지 않고 asio 에 맡긴다.
+		io_context.run();
+		return;
+	}
+
+	auto last_work = Clock::now();
+	while (!io_context.stopped())
+	{
+		// 블록하지 않고 준비된 핸들러를 모두 실행한다.
+		auto start = Clock::now();
+		size_t count = io_context.poll();
+		auto end = Clock::now();
+		if (count > 0)
+		{
+			AddStat(state.busy_time, ToNanoseconds(end - start));
+			AddStat(state.handlers, count);
+			last_work = end;
+			continue;
+		}
+		AddStat(state.spin_time, ToNanoseconds(end - start));
+
+		if (end - last_work < spin_time_)
+			continue;
+
+		// 블록해서 기다렸다가 핸들러 하나를 실행한다. 그 핸들러를 실행한 시간은 스레드 CPU 시간으로 나눈다.
+		auto cpu_start = ThreadCpuTime();
+		count = io_context.run_one();
+		auto cpu_time = ThreadCpuTime() - cpu_start;
+		auto wake = Clock::now();
+		if (count == 0)
+			break;
+
+		auto elapsed = wake - end;
+		cpu_time = std::min(cpu_time, elapsed);
+		AddStat(state.busy_time, ToNanoseconds(cpu_time));
+		AddStat(state.idle_time, ToNanoseconds(elapsed - cpu_time));
+		AddStat(state.handlers, 1);
+		AddStat(state.wakeups, 1);
+		last_work = wake;
+	}
+}
+
 } // namespace net
\ No newline at end of file
@@ -3,11 +3,27 @@
 #include <thread>
 #include <atomic>
 #include <vector>
+#include <chrono>
 #include <boost/asio/executor_work_guard.hpp>
 #include "Types.h"
+#include "Config.h"
+#include "ThreadStats.h"
 
 namespace net {
 
+	// 이벤트 루프 스레드 하나의 사용률. 시간(us)은 스레드가 시작한 뒤의 누적.
+	struct EventLoopThreadStats
+	{
+		std::string name;
+		size_t io_context_index = 0;
+		int cpu = -1;				// 고정한 코어. 고정하지 않았으면 -1.
+		uint64_t busy_time = 0;		// 핸들러를 실행한 시간.
+		uint64_t spin_time = 0;		// 실행할 핸들러 없이 poll 한 시간.
+		uint64_t idle_time = 0;		// 블록해서 기다린 시간.
+		uint64_t handlers = 0;		// 실행한 핸들러 수.
+		uint64_t wakeups = 0;		// 블록했다가 깨어난 횟수.
+	};
+
 	// Run event processing loop.
 	class EventLoop
 	{
@@ -15,21 +31,62 @@ namespace net {
 		EventLoop(const EventLoop&) = delete;
 		EventLoop& operator=(const EventLoop&) = delete;
 
-		explicit EventLoop(size_t thread_count = 1);
+		explicit EventLoop(size_t thread_count = 1, EventLoopMode mode = EventLoopMode::Shared);
+		explicit EventLoop(const EventLoopConfig& config);
 		~EventLoop();
 
 		void Stop();
 		void Wait();
 
+		EventLoopMode GetMode() const
+		{
+			return mode_;
+		}
+
+		// 기본 io_context. ContextPerThread 모드에서는 첫번째 스레드의 io_context.
 		asio::io_context& GetIoContext()
 		{
-			return io_context_;
+			return *io_contexts_[0];
+		}
+
+		asio::io_context& GetIoContext(size_t index)
+		{
+			return *io_contexts_[index];
+		}
+
+		size_t GetIoContextCount() const
+		{
+			return io_contexts_.size();
 		}
 
+		// 스레드 순서로 담는다. 다른 스레드에서 호출해도 된다. thread_stats 를 끄면 카운터는 0 이다.
+		std::vector<EventLoopThreadStats> GetThreadStats() const;
+
 	private:
+		using work_guard = asio::executor_work_guard<asio::io_context::executor_type>;
+
+		// 스레드의 설정과 카운터. 카운터는 그 스레드만 쓴다.
+		struct ThreadState
+		{
+			std::string name;
+			size_t io_context_index = 0;
+			std::atomic<int> cpu{ -1 };		// 고정하지 못하면 스레드가 -1 로 바꾼다.
+			StatCounter busy_time{ 0 };		// ns
+			StatCounter spin_time{ 0 };
+			StatCounter idle_time{ 0 };
+			StatCounter handlers{ 0 };
+			StatCounter wakeups{ 0 };
+		};
+
+		// 핸들러가 없으면 spin_time 동안 poll 하다가 블록한다.
+		void Run(ThreadState& state);
 
-		asio::io_context io_context_;
-		asio::executor_work_guard<asio::io_context::executor_type> work_;
+		EventLoopMode mode_;
+		std::chrono::microseconds spin_time_;
+		bool thread_stats_;
+		std::vector<std::unique_ptr<asio::io_context>> io_contexts_;
+		std::vector<work_guard> works_;
+		std::vector<std::unique_ptr<ThreadState>> thread_states_;
 		std::vector<std::thread> threads_;
 	};
 
@@ -0,0 +1,580 @@
+#include "IoUring.h"
+
+#if defined(NET_HAS_IO_URING)
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/eventfd.h>
+#include <sys/utsname.h>
+#include <linux/io_uring.h>
+
+namespace net {
+
+namespace {
+
+	// liburing 없이 시스템 콜을 바로 호출한다. 실패하면 -1 이고 errno 가 설정된다.
+	int SysSetup(unsigned entries, io_uring_params* params)
+	{
+		return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+	}
+
+	int SysEnter(int ring_fd, unsigned to_submit, unsigned min_complete, unsigned flags)
+	{
+		return static_cast<int>(::syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, nullptr, 0));
+	}
+
+	int SysRegister(int ring_fd, unsigned opcode, void* arg, unsigned nr_args)
+	{
+		return static_cast<int>(::syscall(__NR_io_uring_register, ring_fd, opcode, arg, nr_args));
+	}
+
+	// 기능 플래그로 알수 없는 기능은 커널 버전으로 판단한다.
+	bool KernelAtLeast(int major, int minor)
+	{
+		utsname name;
+		if (::uname(&name) != 0)
+			return false;
+
+		int kernel_major = 0;
+		int kernel_minor = 0;
+		if (std::sscanf(name.release, "%d.%d", &kernel_major, &kernel_minor) != 2)
+			return false;
+
+		return kernel_major > major || (kernel_major == major && kernel_minor >= minor);
+	}
+
+	// 링마다 하나의 버퍼 그룹만 사용한다.
+	constexpr uint16_t BUFFER_GROUP = 0;
+	// 버퍼 id 는 16bit 다.
+	constexpr unsigned MAX_BUFFER_COUNT = 65536;
+
+} // namespace
+
+Ptr<IoUring> IoUring::Create(asio::io_context& io_context, unsigned entries, size_t buffer_size, unsigned buffer_count)
+{
+	auto uring = std::make_shared<IoUring>(io_context);
+	if (!uring->Setup(std::max<unsigned>(entries, 1)))
+		return nullptr;
+
+	uring->SetupBufferGroup(buffer_size, buffer_count);
+	uring->WaitCompletion();
+	return uring;
+}
+
+IoUring::IoUring(asio::io_context& io_context)
+	: io_context_(io_context)
+	, event_descriptor_(io_context)
+{
+}
+
+IoUring::~IoUring()
+{
+	Close();
+
+	if (sqes_)
+		::munmap(sqes_, sqes_size_);
+	if (cq_ring_ && cq_ring_ != sq_ring_)
+		::munmap(cq_ring_, cq_ring_size_);
+	if (sq_ring_)
+		::munmap(sq_ring_, sq_ring_size_);
+}
+
+bool IoUring::Setup(unsigned entries)
+{
+	io_uring_params params;
+	std::memset(&params, 0, sizeof(params));
+	// multishot 수신은 제출 하나가 여러 완료를 만드므로 완료 큐를 넉넉하게 잡는다.
+	params.flags = IORING_SETUP_CQSIZE;
+	params.cq_entries = entries * 4;
+
+	ring_fd_ = SysSetup(entries, &params);
+	if (ring_fd_ < 0)
+	{
+		BOOST_LOG_TRIVIAL(info) << "io_uring_setup failed: " << std::strerror(errno);
+		return false;
+	}
+
+	// 완료 큐가 넘쳐도 완료를 잃어버리지 않아야 하고, 소켓 작업을 커널 스레드 풀 없이 poll 로 처리해야 한다.
+	features_ = params.features;
+	if (!(features_ & IORING_FEAT_NODROP) || !(features_ & IORING_FEAT_FAST_POLL))
+	{
+		BOOST_LOG_TRIVIAL(info) << "io_uring features are not supported: " << features_;
+		return false;
+	}
+
+	sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+	cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+	if (features_ & IORING_FEAT_SINGLE_MMAP)
+	{
+		sq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+		cq_ring_size_ = sq_ring_size_;
+	}
+
+	sq_ring_ = ::mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+	if (sq_ring_ == MAP_FAILED)
+	{
+		sq_ring_ = nullptr;
+		BOOST_LOG_TRIVIAL(info) << "io_uring mmap failed: " << std::strerror(errno);
+		return false;
+	}
+
+	if (features_ & IORING_FEAT_SINGLE_MMAP)
+	{
+		cq_ring_ = sq_ring_;
+	}
+	else
+	{
+		cq_ring_ = ::mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING);
+		if (cq_ring_ == MAP_FAILED)
+		{
+			cq_ring_ = nullptr;
+			BOOST_LOG_TRIVIAL(info) << "io_uring mmap failed: " << std::strerror(errno);
+			return false;
+		}
+	}
+
+	sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+	void* sqes = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+	if (sqes == MAP_FAILED)
+	{
+		BOOST_LOG_TRIVIAL(info) << "io_uring mmap failed: " << std::strerror(errno);
+		return false;
+	}
+	sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+	uint8_t* sq = static_cast<uint8_t*>(sq_ring_);
+	sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+	sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+	sq_flags_ = reinterpret_cast<unsigned*>(sq + params.sq_off.flags);
+	sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+	sq_entries_ = params.sq_entries;
+	sq_local_tail_ = *sq_tail_;
+
+	// 제출 큐 배열은 sqe 인덱스를 그대로 가리키게 한번만 채운다.
+	unsigned* sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+	for (unsigned i = 0; i < sq_entries_; i++)
+	{
+		sq_array[i] = i;
+	}
+
+	uint8_t* cq = static_cast<uint8_t*>(cq_ring_);
+	cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+	cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+	cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+	cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+	// 완료가 생기면 커널이 eventfd 에 알린다. io_context 는 eventfd 를 기다린다.
+	event_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (event_fd_ < 0)
+	{
+		BOOST_LOG_TRIVIAL(info) << "eventfd failed: " << std::strerror(errno);
+		return false;
+	}
+	if (SysRegister(ring_fd_, IORING_REGISTER_EVENTFD, &event_fd_, 1) < 0)
+	{
+		BOOST_LOG_TRIVIAL(info) << "io_uring register eventfd failed: " << std::strerror(errno);
+		::close(event_fd_);
+		event_fd_ = -1;
+		return false;
+	}
+
+	error_code ec;
+	event_descriptor_.assign(event_fd_, ec);
+	if (ec)
+	{
+		BOOST_LOG_TRIVIAL(info) << "eventfd assign failed: " << ec.message();
+		::close(event_fd_);
+		event_fd_ = -1;
+		return false;
+	}
+
+	return true;
+}
+
+bool IoUring::SetupBufferGroup(size_t buffer_size, unsigned buffer_count)
+{
+	if (buffer_size == 0 || buffer_count == 0)
+		return false;
+
+	// 버퍼를 맡기는 작업은 5.7, 수신 multishot 은 6.0 부터 지원한다.
+	// 5.19 의 버퍼 링 등록(IORING_REGISTER_PBUF_RING)은 일부 커널에서 버퍼를 찾지 못하므로 사용하지 않는다.
+	if (!KernelAtLeast(6, 0))
+	{
+		BOOST_LOG_TRIVIAL(info) << "io_uring multishot receive is not supported";
+		return false;
+	}
+
+	unsigned count = std::min(buffer_count, MAX_BUFFER_COUNT);
+	buffer_size_ = buffer_size;
+	buffers_.resize(count * buffer_size);
+
+	// 처음 맡기는 결과는 여기서 바로 확인한다.
+	io_uring_sqe* sqe = ProvideBuffers(0, count);
+	if (sqe == nullptr)
+		return false;
+	sqe->user_data = 0;
+	sq_local_tail_++;
+	__atomic_store_n(sq_tail_, sq_local_tail_, __ATOMIC_RELEASE);
+	if (SysEnter(ring_fd_, 1, 1, IORING_ENTER_GETEVENTS) < 0)
+	{
+		BOOST_LOG_TRIVIAL(info) << "io_uring provide buffers failed: " << std::strerror(errno);
+		buffers_.clear();
+		return false;
+	}
+
+	unsigned head = *cq_head_;
+	int result = cqes_[head & cq_mask_].res;
+	__atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+	if (result < 0)
+	{
+		BOOST_LOG_TRIVIAL(info) << "io_uring provide buffers failed: " << std::strerror(-result);
+		buffers_.clear();
+		return false;
+	}
+
+	buffer_count_ = count;
+	return true;
+}
+
+io_uring_sqe* IoUring::ProvideBuffers(uint16_t id, unsigned count)
+{
+	io_uring_sqe* sqe = GetSqe();
+	if (sqe == nullptr)
+		return nullptr;
+
+	sqe->opcode = IORING_OP_PROVIDE_BUFFERS;
+	sqe->fd = static_cast<int32_t>(count);
+	sqe->addr = reinterpret_cast<uint64_t>(buffers_.data() + id * buffer_size_);
+	sqe->len = static_cast<uint32_t>(buffer_size_);
+	sqe->off = id;
+	sqe->buf_group = BUFFER_GROUP;
+	return sqe;
+}
+
+void IoUring::Close()
+{
+	if (closed_)
+		return;
+	closed_ = true;
+
+	error_code ec;
+	event_descriptor_.close(ec);
+	event_fd_ = -1;
+
+	// 링을 닫으면 커널이 남은 작업을 취소한다. 완료를 받지 않으므로 붙잡고 있는 객체를 놓는다.
+	if (ring_fd_ >= 0)
+	{
+		::close(ring_fd_);
+		ring_fd_ = -1;
+	}
+
+	while (pending_head_)
+	{
+		IoUringOperation* op = pending_head_;
+		Unlink(op);
+		op->Abandon();
+	}
+}
+
+bool IoUring::Receive(int fd, uint8_t* data, size_t size, IoUringOperation* op)
+{
+	io_uring_sqe* sqe = GetSqe();
+	if (sqe == nullptr)
+		return false;
+
+	sqe->opcode = IORING_OP_RECV;
+	sqe->fd = fd;
+	sqe->addr = reinterpret_cast<uint64_t>(data);
+	sqe->len = static_cast<uint32_t>(size);
+	Push(sqe, op);
+	return true;
+}
+
+bool IoUring::ReceiveMultishot(int fd, IoUringOperation* op)
+{
+	if (!HasBufferGroup())
+		return false;
+
+	io_uring_sqe* sqe = GetSqe();
+	if (sqe == nullptr)
+		return false;
+
+	sqe->opcode = IORING_OP_RECV;
+	sqe->fd = fd;
+	sqe->ioprio = IORING_RECV_MULTISHOT;
+	sqe->flags = IOSQE_BUFFER_SELECT;
+	sqe->buf_group = BUFFER_GROUP;
+	Push(sqe, op);
+	return true;
+}
+
+bool IoUring::SendMessage(int fd, const msghdr* message, IoUringOperation* op)
+{
+	io_uring_sqe* sqe = GetSqe();
+	if (sqe == nullptr)
+		return false;
+
+	sqe->opcode = IORING_OP_SENDMSG;
+	sqe->fd = fd;
+	sqe->addr = reinterpret_cast<uint64_t>(message);
+	sqe->len = 1;
+	sqe->msg_flags = MSG_NOSIGNAL;
+	Push(sqe, op);
+	return true;
+}
+
+bool IoUring::Cancel(IoUringOperation* op)
+{
+	if (!op->IsPending())
+		return false;
+
+	io_uring_sqe* sqe = GetSqe();
+	if (sqe == nullptr)
+		return false;
+
+	sqe->opcode = IORING_OP_ASYNC_CANCEL;
+	sqe->fd = -1;
+	sqe->addr = reinterpret_cast<uint64_t>(op);
+	// 성공한 완료는 받지 않는다.
+	if (features_ & IORING_FEAT_CQE_SKIP)
+		sqe->flags |= IOSQE_CQE_SKIP_SUCCESS;
+	Push(sqe, nullptr);
+	return true;
+}
+
+const uint8_t* IoUring::GetBuffer(uint32_t flags) const
+{
+	if (!HasBufferGroup() || !(flags & IORING_CQE_F_BUFFER))
+		return nullptr;
+
+	uint16_t id = static_cast<uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT);
+	return buffers_.data() + id * buffer_size_;
+}
+
+void IoUring::ReleaseBuffer(uint32_t flags)
+{
+	if (!HasBufferGroup() || !(flags & IORING_CQE_F_BUFFER))
+		return;
+
+	// 다른 제출과 함께 다음 io_uring_enter 에서 제출된다.
+	uint16_t id = static_cast<uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT);
+	io_uring_sqe* sqe = ProvideBuffers(id, 1);
+	if (sqe == nullptr)
+	{
+		// 버리면 커널이 고를 버퍼가 줄어든다. 제출 큐가 비면 다시 맡긴다.
+		if (!closed_)
+		{
+			released_buffers_.push_back(id);
+			PostSubmit();
+		}
+		return;
+	}
+
+	// 성공한 완료는 받지 않는다.
+	if (features_ & IORING_FEAT_CQE_SKIP)
+		sqe->flags |= IOSQE_CQE_SKIP_SUCCESS;
+	Push(sqe, nullptr);
+}
+
+void IoUring::ProvideReleasedBuffers()
+{
+	// GetSqe 가 다시 Submit 하지 않도록 빈 자리만큼만 채운다.
+	unsigned free_entries = sq_entries_ - (sq_local_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE));
+	size_t count = std::min<size_t>(free_entries, released_buffers_.size());
+	size_t provided = 0;
+	for (; provided < count; provided++)
+	{
+		io_uring_sqe* sqe = ProvideBuffers(released_buffers_[provided], 1);
+		if (sqe == nullptr)
+			break;
+
+		if (features_ & IORING_FEAT_CQE_SKIP)
+			sqe->flags |= IOSQE_CQE_SKIP_SUCCESS;
+		Push(sqe, nullptr);
+	}
+	released_buffers_.erase(released_buffers_.begin(), released_buffers_.begin() + provided);
+}
+
+bool IoUring::HasMore(uint32_t flags)
+{
+	return (flags & IORING_CQE_F_MORE) != 0;
+}
+
+io_uring_sqe* IoUring::GetSqe()
+{
+	if (closed_)
+		return nullptr;
+
+	// 제출 큐가 가득 찼으면 모아둔 것을 먼저 제출한다.
+	if (sq_local_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_)
+	{
+		Submit();
+		if (sq_local_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_)
+		{
+			BOOST_LOG_TRIVIAL(info) << "io_uring submission queue is full";
+			return nullptr;
+		}
+	}
+
+	io_uring_sqe* sqe = &sqes_[sq_local_tail_ & sq_mask_];
+	std::memset(sqe, 0, sizeof(*sqe));
+	return sqe;
+}
+
+void IoUring::Push(io_uring_sqe* sqe, IoUringOperation* op)
+{
+	sqe->user_data = reinterpret_cast<uint64_t>(op);
+	if (op)
+		Link(op);
+
+	sq_local_tail_++;
+	__atomic_store_n(sq_tail_, sq_local_tail_, __ATOMIC_RELEASE);
+
+	// 지금 핸들러에서 제출하는 작업을 모아서 다음 핸들러에서 한번에 제출한다.
+	PostSubmit();
+}
+
+void IoUring::PostSubmit()
+{
+	if (submit_posted_)
+		return;
+
+	submit_posted_ = true;
+	asio::post(io_context_, MakeAllocHandler(submit_memory_, [this, self = shared_from_this()]
+	{
+		submit_posted_ = false;
+		Submit();
+	}));
+}
+
+void IoUring::Submit()
+{
+	if (closed_)
+		return;
+
+	for (;;)
+	{
+		unsigned to_submit = sq_local_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+		if (to_submit == 0)
+		{
+			// 제출 큐가 비었으니 돌려주지 못한 버퍼를 맡긴다. 다음 핸들러에서 제출된다.
+			if (!released_buffers_.empty())
+				ProvideReleasedBuffers();
+			return;
+		}
+
+		if (SysEnter(ring_fd_, to_submit, 0, 0) >= 0)
+			continue;
+
+		if (errno == EINTR)
+			continue;
+
+		if (errno == EAGAIN || errno == EBUSY)
+		{
+			// 넘친 완료를 처리한 뒤에 다시 제출한다.
+			PostSubmit();
+			return;
+		}
+
+		BOOST_LOG_TRIVIAL(info) << "io_uring_enter failed: " << std::strerror(errno);
+		return;
+	}
+}
+
+void IoUring::WaitCompletion()
+{
+	event_descriptor_.async_wait(asio::posix::stream_descriptor::wait_read, MakeAllocHandler(wait_memory_,
+		[this, self = shared_from_this()](const error_code& error)
+	{
+		if (error || closed_)
+			return;
+
+		// eventfd 를 먼저 비워야 처리하는 동안 추가된 완료가 다시 알려진다.
+		uint64_t value = 0;
+		while (::read(event_fd_, &value, sizeof(value)) > 0)
+		{
+		}
+
+		Reap();
+		WaitCompletion();
+	}));
+}
+
+void IoUring::Reap()
+{
+	for (;;)
+	{
+		unsigned head = *cq_head_;
+		unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+		if (head == tail)
+		{
+			// 완료 큐가 넘쳤으면 커널에 들어가야 남은 완료가 큐로 옮겨진다.
+			if (!(__atomic_load_n(sq_flags_, __ATOMIC_RELAXED) & IORING_SQ_CQ_OVERFLOW))
+				return;
+
+			SysEnter(ring_fd_, 0, 0, IORING_ENTER_GETEVENTS);
+			continue;
+		}
+
+		for (; head != tail; head++)
+		{
+			const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+			auto* op = reinterpret_cast<IoUringOperation*>(cqe.user_data);
+			int result = cqe.res;
+			uint32_t flags = cqe.flags;
+			__atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+
+			if (op == nullptr)
+			{
+				// 취소하려던 작업이 이미 끝났으면 ENOENT, 끝나는 중이면 EALREADY.
+				if (result < 0 && result != -ENOENT && result != -EALREADY)
+					BOOST_LOG_TRIVIAL(info) << "io_uring operation failed: " << std::strerror(-result);
+				continue;
+			}
+			if (!op->pending_)
+				continue;
+
+			if (!HasMore(flags))
+				Unlink(op);
+			op->Complete(result, flags);
+
+			if (closed_)
+				return;
+		}
+	}
+}
+
+void IoUring::Link(IoUringOperation* op)
+{
+	assert(!op->pending_);
+
+	op->pending_ = true;
+	op->prev_ = nullptr;
+	op->next_ = pending_head_;
+	if (pending_head_)
+		pending_head_->prev_ = op;
+	pending_head_ = op;
+}
+
+void IoUring::Unlink(IoUringOperation* op)
+{
+	if (op->prev_)
+		op->prev_->next_ = op->next_;
+	else
+		pending_head_ = op->next_;
+	if (op->next_)
+		op->next_->prev_ = op->prev_;
+
+	op->pending_ = false;
+	op->prev_ = nullptr;
+	op->next_ = nullptr;
+}
+
+} // namespace net
+
+#endif // NET_HAS_IO_URING
\ No newline at end of file
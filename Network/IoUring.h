@@ -0,0 +1,218 @@
+#pragma once
+
+// io_uring 은 Linux 에서만 사용한다. 다른 플랫폼은 epoll/IOCP 경로로 동작한다.
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define NET_HAS_IO_URING 1
+#endif
+#endif
+
+#if defined(NET_HAS_IO_URING)
+
+#include <vector>
+#include <sys/socket.h>
+#include "Types.h"
+#include "AsioHelper.h"
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace net {
+
+	class IoUring;
+
+	// 링에 제출한 작업. 완료되면 IoUring 이 Complete 를 호출한다.
+	// 작업이 진행중인 동안 객체가 유지되어야 한다.
+	class IoUringOperation
+	{
+	public:
+		IoUringOperation() = default;
+		IoUringOperation(const IoUringOperation&) = delete;
+		IoUringOperation& operator=(const IoUringOperation&) = delete;
+		virtual ~IoUringOperation() = default;
+
+		bool IsPending() const
+		{
+			return pending_;
+		}
+
+	protected:
+		friend class IoUring;
+
+		// result 는 시스템 콜의 리턴값. 실패하면 -errno.
+		virtual void Complete(int result, uint32_t flags) = 0;
+		// 링이 닫혀서 완료되지 않는 작업.
+		virtual void Abandon() = 0;
+
+	private:
+		bool pending_ = false;
+		IoUringOperation* prev_ = nullptr;
+		IoUringOperation* next_ = nullptr;
+	};
+
+	// 완료되면 owner 의 멤버 함수를 호출하는 작업.
+	// 진행중에는 Hold 한 owner 를 붙잡아 두고, 더 이상 완료가 없으면 놓는다.
+	template <typename T>
+	class IoUringMemberOperation : public IoUringOperation
+	{
+	public:
+		using Callback = void (T::*)(int, uint32_t);
+
+		IoUringMemberOperation(T* owner, Callback callback)
+			: owner_(owner)
+			, callback_(callback)
+		{
+		}
+
+		void Hold(Ptr<T> self)
+		{
+			self_ = std::move(self);
+		}
+
+		void Release()
+		{
+			self_.reset();
+		}
+
+	protected:
+		void Complete(int result, uint32_t flags) override
+		{
+			// 콜백에서 다시 제출하면 새로 Hold 한다.
+			Ptr<T> self = IsPending() ? self_ : std::move(self_);
+			(owner_->*callback_)(result, flags);
+		}
+
+		void Abandon() override
+		{
+			self_.reset();
+		}
+
+	private:
+		T* owner_;
+		Callback callback_;
+		Ptr<T> self_;
+	};
+
+	// io_context 하나가 사용하는 io_uring.
+	// liburing 없이 시스템 콜로 링을 만들고, 완료는 링에 등록한 eventfd 로 io_context 에서 받는다.
+	// 한 핸들러에서 제출한 작업은 모아서 한번의 io_uring_enter 로 제출한다.
+	// 링은 하나의 스레드에서만 사용하므로 io_context 를 하나의 스레드가 실행할 때만 사용해야 한다.
+	class IoUring : public std::enable_shared_from_this<IoUring>
+	{
+	public:
+		IoUring(const IoUring&) = delete;
+		IoUring& operator=(const IoUring&) = delete;
+
+		// 커널이 지원하지 않으면 nullptr.
+		// buffer_count 개의 buffer_size 크기 수신 버퍼를 커널에 맡긴다. 맡기지 못하면 multishot 수신을 사용하지 않는다.
+		static Ptr<IoUring> Create(asio::io_context& io_context, unsigned entries, size_t buffer_size, unsigned buffer_count);
+
+		explicit IoUring(asio::io_context& io_context);
+		~IoUring();
+
+		// 완료를 기다리지 않는 작업은 버린다. io_context 의 스레드에서 호출한다.
+		void Close();
+
+		bool IsClosed() const
+		{
+			return closed_;
+		}
+
+		// 커널에 맡긴 수신 버퍼가 있으면 multishot 수신을 사용할수 있다.
+		bool HasBufferGroup() const
+		{
+			return buffer_count_ > 0;
+		}
+
+		asio::io_context& GetIoContext()
+		{
+			return io_context_;
+		}
+
+		// 제출 큐가 가득 찼거나 링이 닫혔으면 false.
+		bool Receive(int fd, uint8_t* data, size_t size, IoUringOperation* op);
+		// 소켓에 데이터가 올때마다 커널이 고른 버퍼에 받아서 완료한다. 완료의 flags 로 GetBuffer 를 호출해서 데이터를 얻는다.
+		// 버퍼가 모자라거나 연결이 끊어지면 HasMore 가 false 인 완료로 끝난다.
+		bool ReceiveMultishot(int fd, IoUringOperation* op);
+		// message 는 완료될때까지 유지되어야 한다.
+		bool SendMessage(int fd, const msghdr* message, IoUringOperation* op);
+		// 진행중인 op 를 취소한다. op 는 -ECANCELED 로 완료되고 multishot 이면 그 완료로 끝난다.
+		// 이미 끝났으면 아무 일도 없다. 제출 큐가 가득 찼거나 진행중이 아니면 false.
+		bool Cancel(IoUringOperation* op);
+
+		// multishot 수신 완료의 데이터. 버퍼가 없으면 nullptr.
+		const uint8_t* GetBuffer(uint32_t flags) const;
+		// 다 사용한 수신 버퍼를 커널에 돌려준다.
+		void ReleaseBuffer(uint32_t flags);
+
+		// 같은 작업의 완료가 더 있는지.
+		static bool HasMore(uint32_t flags);
+
+	private:
+		bool Setup(unsigned entries);
+		bool SetupBufferGroup(size_t buffer_size, unsigned buffer_count);
+		// id 부터 count 개의 버퍼를 커널에 맡기는 제출.
+		io_uring_sqe* ProvideBuffers(uint16_t id, unsigned count);
+
+		// 제출 큐가 가득 차서 돌려주지 못한 버퍼를 다시 맡긴다.
+		void ProvideReleasedBuffers();
+
+		io_uring_sqe* GetSqe();
+		// op 가 nullptr 이면 완료를 받지 않는 작업.
+		void Push(io_uring_sqe* sqe, IoUringOperation* op);
+		// 지금 핸들러가 끝난 뒤에 Submit 한다.
+		void PostSubmit();
+		void Submit();
+		void WaitCompletion();
+		void Reap();
+
+		void Link(IoUringOperation* op);
+		void Unlink(IoUringOperation* op);
+
+		asio::io_context& io_context_;
+		asio::posix::stream_descriptor event_descriptor_;
+		bool closed_ = false;
+
+		int ring_fd_ = -1;
+		int event_fd_ = -1;
+		uint32_t features_ = 0;
+
+		// 커널과 공유하는 링 메모리.
+		void* sq_ring_ = nullptr;
+		size_t sq_ring_size_ = 0;
+		void* cq_ring_ = nullptr;
+		size_t cq_ring_size_ = 0;
+		io_uring_sqe* sqes_ = nullptr;
+		size_t sqes_size_ = 0;
+
+		unsigned* sq_head_ = nullptr;
+		unsigned* sq_tail_ = nullptr;
+		unsigned* sq_flags_ = nullptr;
+		unsigned sq_mask_ = 0;
+		unsigned sq_entries_ = 0;
+		// 채웠지만 커널에 알리지 않은 tail.
+		unsigned sq_local_tail_ = 0;
+
+		unsigned* cq_head_ = nullptr;
+		unsigned* cq_tail_ = nullptr;
+		unsigned cq_mask_ = 0;
+		io_uring_cqe* cqes_ = nullptr;
+
+		// 커널에 맡긴 수신 버퍼. multishot 수신이 완료될때마다 하나씩 골라 쓴다.
+		size_t buffer_size_ = 0;
+		unsigned buffer_count_ = 0;
+		std::vector<uint8_t> buffers_;
+		// 제출 큐가 가득 차서 아직 커널에 돌려주지 못한 버퍼 id. 다음 Submit 뒤에 다시 맡긴다.
+		std::vector<uint16_t> released_buffers_;
+
+		bool submit_posted_ = false;
+		// 진행중인 작업. 링이 닫힐때 붙잡고 있는 객체를 놓는다.
+		IoUringOperation* pending_head_ = nullptr;
+
+		HandlerMemory wait_memory_;
+		HandlerMemory submit_memory_;
+	};
+
+} // namespace net
+
+#endif // NET_HAS_IO_URING
\ No newline at end of file
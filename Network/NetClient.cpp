@@ -1,7 +1,19 @@
+#include <cstring>
 #include "NetClient.h"
 
 namespace net {
 
+namespace {
+
+	// payload 가 없는 프레임. 받는 쪽은 핸들러에 넘기지 않는다.
+	const Ptr<const SendBuffer>& HeartbeatFrame()
+	{
+		static const Ptr<const SendBuffer> frame = ByteSendBuffer::Create(Buffer(0));
+		return frame;
+	}
+
+} // namespace
+
 Ptr<NetClient> NetClient::Create(const ClientConfig& config)
 {
 	return std::make_shared<NetClient>(config);
@@ -13,7 +25,7 @@ NetClient::NetClient(const ClientConfig& config)
 {
 	event_loop_ = config_.event_loop;
 
-	//  event_loop   .
+	// 설정된 event_loop 이 없으면 생성.
 	if (event_loop_ == nullptr)
 	{
 		size_t thread_count = 1;
@@ -22,6 +34,8 @@ NetClient::NetClient(const ClientConfig& config)
 
 	socket_ = std::make_unique<tcp::socket>(event_loop_->GetIoContext());
 	strand_ = std::make_unique<strand>(event_loop_->GetIoContext());
+	heartbeat_timer_ = std::make_unique<asio::steady_timer>(event_loop_->GetIoContext());
+	udp_bind_timer_ = std::make_unique<asio::steady_timer>(event_loop_->GetIoContext());
 }
 
 NetClient::~NetClient()
@@ -78,7 +92,7 @@ void NetClient::ConnectStart(tcp::resolver::iterator endpoint_iterator)
 			// Start
 			// socket option
 			socket_->set_option(tcp::no_delay(config_.no_delay));
-			// read  
+			// read 버퍼 생성
 			size_t initial_capacity = config_.min_receive_size;
 			size_t max_capacity = config_.max_receive_buffer_size;
 			read_buf_ = std::make_shared<Buffer>(initial_capacity, max_capacity);
@@ -86,6 +100,7 @@ void NetClient::ConnectStart(tcp::resolver::iterator endpoint_iterator)
 
 			// Read
 			Read(config_.min_receive_size);
+			StartHeartbeat();
 			if (net_event_handler_) net_event_handler_(NetEventType::Opened);
 		}
 		else
@@ -110,11 +125,11 @@ inline void NetClient::Read(size_t min_read_bytes)
 	}
 
 	auto asio_buf = mutable_buffer(*read_buf_);
-	socket_->async_read_some(boost::asio::buffer(asio_buf), asio::bind_executor(*strand_,
+	socket_->async_read_some(boost::asio::buffer(asio_buf), asio::bind_executor(*strand_, MakeAllocHandler(read_memory_,
 		[this](const error_code& error, std::size_t bytes_transferred)
 	{
 		HandleRead(error, bytes_transferred);
-	}));
+	})));
 }
 
 inline void NetClient::HandleRead(const error_code & error, std::size_t bytes_transferred)
@@ -130,11 +145,11 @@ inline void NetClient::HandleRead(const error_code & error, std::size_t bytes_tr
 		return;
 	}
 
-	//  WriterIndex  ۹  ũ⸸ŭ 
+	// 버퍼의 WriterIndex 을 전송받은 데이터의 크기만큼 전진
 	read_buf_->WriterIndex(read_buf_->WriterIndex() + bytes_transferred);
 
 	size_t next_read_size = 0;
-	//  Ÿ ó
+	// 받은 데이타 처리
 	HandleReceiveData(*read_buf_, next_read_size);
 
 	size_t prepare_size = std::max<size_t>((size_t)next_read_size, config_.min_receive_size);
@@ -143,7 +158,7 @@ inline void NetClient::HandleRead(const error_code & error, std::size_t bytes_tr
 
 inline bool NetClient::PrepareRead(size_t min_prepare_bytes)
 {
-	//    ش.
+	// 읽을게 없으면 포지션을 리셋해준다.
 	if (read_buf_->ReadableBytes() == 0)
 	{
 		read_buf_->Clear();
@@ -167,14 +182,14 @@ inline bool NetClient::PrepareRead(size_t min_prepare_bytes)
 	return true;
 }
 
-inline void NetClient::PendWrite(Ptr<Buffer> buf)
+void NetClient::PendWrite(Ptr<const SendBuffer> buf)
 {
 	asio::dispatch(*strand_, [this, buf = std::move(buf)]() mutable
 	{
 		if (!IsConnected())
 			return;
 
-		pending_list_.emplace_back(std::move(buf));
+		pending_list_.emplace_back(CompressFrame(buf));
 		if (sending_list_.empty())
 		{
 			Write();
@@ -182,6 +197,21 @@ inline void NetClient::PendWrite(Ptr<Buffer> buf)
 	});
 }
 
+void NetClient::PendUnreliable(uint64_t key, Ptr<const SendBuffer> buf)
+{
+	asio::dispatch(*strand_, [this, key, buf = std::move(buf)]() mutable
+	{
+		if (!IsConnected())
+			return;
+
+		if (udp_bound_.load(std::memory_order_relaxed) &&
+			udp_channel_->SendFrame(udp_server_endpoint_, udp_token_, ++udp_send_sequence_, key, *buf))
+			return;
+
+		PendWrite(std::move(buf));
+	});
+}
+
 inline void NetClient::Write()
 {
 	assert(sending_list_.empty());
@@ -192,23 +222,21 @@ inline void NetClient::Write()
 	if (pending_list_.empty())
 		return;
 
-	// TO DO : sending_list_.swap(pending_list_);
-
 	// Scatter-Gather I/O
-	std::vector<asio::const_buffer> bufs;
+	// 버퍼 목록은 재사용한다. asio 에는 목록을 복사하지 않도록 span 으로 넘긴다.
+	write_buffers_.clear();
 	for (auto& buffer : pending_list_)
 	{
-		EncodeSendData(buffer);
-		bufs.emplace_back(const_buffer(*buffer));
-		sending_list_.emplace_back(std::move(buffer));
+		buffer->AppendTo(write_buffers_);
 	}
-	pending_list_.clear();
+	sending_list_.swap(pending_list_);
 
-	boost::asio::async_write(*socket_, bufs, asio::bind_executor(*strand_,
+	ConstBufferSpan bufs(write_buffers_.data(), write_buffers_.data() + write_buffers_.size());
+	boost::asio::async_write(*socket_, bufs, asio::bind_executor(*strand_, MakeAllocHandler(write_memory_,
 		[this](error_code const& ec, std::size_t)
 		{
 			HandleWrite(ec);
-		}));
+		})));
 }
 
 inline void NetClient::HandleWrite(const error_code & error)
@@ -233,7 +261,7 @@ inline void NetClient::HandleWrite(const error_code & error)
 
 inline void NetClient::HandleError(const error_code & error)
 {
-	//   ̴.
+	// 상대방이 연결을 끊은것이다.
 	if (error == boost::asio::error::eof || error == boost::asio::error::operation_aborted)
 	{
 		return;
@@ -242,11 +270,150 @@ inline void NetClient::HandleError(const error_code & error)
 	BOOST_LOG_TRIVIAL(info) << "Socket error: " << error.message();
 }
 
+void NetClient::StartHeartbeat()
+{
+	if (config_.heartbeat_interval == 0)
+		return;
+
+	heartbeat_timer_->expires_after(std::chrono::milliseconds(config_.heartbeat_interval));
+	heartbeat_timer_->async_wait(asio::bind_executor(*strand_, [this](const error_code& error)
+	{
+		if (error || !IsConnected())
+			return;
+
+		PendWrite(HeartbeatFrame());
+		StartHeartbeat();
+	}));
+}
+
+void NetClient::HandleControl(const uint8_t* payload, size_t size)
+{
+	switch (static_cast<ControlType>(payload[0]))
+	{
+	case ControlType::UdpToken:
+	{
+		// [type][uint64 token][uint16 port]
+		if (!config_.udp_channel || udp_channel_ || size < sizeof(uint8_t) + sizeof(uint64_t) + sizeof(uint16_t))
+			return;
+
+		uint64_t token;
+		uint16_t port;
+		std::memcpy(&token, payload + sizeof(uint8_t), sizeof(token));
+		std::memcpy(&port, payload + sizeof(uint8_t) + sizeof(uint64_t), sizeof(port));
+		BindUdp(token, port);
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+void NetClient::BindUdp(uint64_t token, uint16_t port)
+{
+	error_code ec;
+	auto remote = socket_->remote_endpoint(ec);
+	if (ec)
+		return;
+
+	// 다시 바인드하면 이전 채널은 닫는다.
+	if (udp_channel_)
+		udp_channel_->Close();
+
+	// TCP 로 연결된 서버 주소의 UDP 포트로 보낸다.
+	udp_server_endpoint_ = asio::ip::udp::endpoint(remote.address(), port);
+	auto local = remote.address().is_v6() ? asio::ip::udp::v6() : asio::ip::udp::v4();
+	try
+	{
+		udp_channel_ = std::make_shared<UdpChannel>(event_loop_->GetIoContext(), asio::ip::udp::endpoint(local, 0), config_.max_datagram_size);
+	}
+	catch (const std::exception& e)
+	{
+		BOOST_LOG_TRIVIAL(info) << "Can not open udp channel: " << e.what();
+		return;
+	}
+
+	udp_token_ = token;
+	udp_bound_ = false;
+	udp_send_sequence_ = 0;
+	udp_receive_filter_.Clear();
+	udp_channel_->Start([this](const DatagramHeader& header, const asio::ip::udp::endpoint& endpoint, const uint8_t* payload, size_t size)
+	{
+		HandleDatagram(header, endpoint, payload, size);
+	});
+	SendUdpBind(config_.udp_bind_attempts);
+}
+
+void NetClient::SendUdpBind(size_t remain_attempts)
+{
+	if (!IsConnected() || udp_bound_.load() || remain_attempts == 0)
+		return;
+
+	DatagramHeader bind = { static_cast<uint8_t>(DatagramType::Bind), udp_token_, 0, 0, 0 };
+	udp_channel_->SendTo(udp_server_endpoint_, bind, nullptr, 0);
+
+	udp_bind_timer_->expires_after(std::chrono::milliseconds(config_.udp_bind_interval));
+	udp_bind_timer_->async_wait(asio::bind_executor(*strand_, [this, remain_attempts](const error_code& error)
+	{
+		if (error)
+			return;
+
+		SendUdpBind(remain_attempts - 1);
+	}));
+}
+
+void NetClient::HandleDatagram(const DatagramHeader& header, const asio::ip::udp::endpoint& endpoint, const uint8_t* payload, size_t size)
+{
+	// 서버가 아닌 곳에서 온 데이터그램은 버린다.
+	if (endpoint != udp_server_endpoint_ || header.token != udp_token_)
+		return;
+
+	switch (static_cast<DatagramType>(header.type))
+	{
+	case DatagramType::BindAck:
+		asio::dispatch(*strand_, [this]
+		{
+			if (!IsConnected())
+				return;
+
+			udp_bound_.store(true, std::memory_order_release);
+			udp_bind_timer_->cancel();
+		});
+		break;
+	case DatagramType::Data:
+	{
+		if (size == 0 || size > config_.max_receive_buffer_size)
+			return;
+
+		// 채널의 수신 버퍼는 바로 재사용되므로 복사해서 넘긴다.
+		auto buf = std::make_shared<Buffer>(size);
+		buf->WriteBytes(payload, size);
+		asio::dispatch(*strand_, [this, key = header.key, sequence = header.sequence, message_type = header.message_type, buf]
+		{
+			if (!IsConnected() || !udp_receive_filter_.Accept(key, sequence))
+				return;
+
+			if (message_handler_)
+				message_handler_(message_type, buf->Data() + buf->ReaderIndex(), buf->ReadableBytes());
+		});
+		break;
+	}
+	default:
+		break;
+	}
+}
+
 void NetClient::_Close()
 {
 	if (state_ == State::Closed)
 		return;
 
+	heartbeat_timer_->cancel();
+	udp_bind_timer_->cancel();
+	udp_bound_ = false;
+	udp_receive_filter_.Clear();
+	if (udp_channel_)
+		udp_channel_->Close();
+
 	boost::system::error_code ec;
 	socket_->shutdown(tcp::socket::shutdown_both, ec);
 	socket_->close();
@@ -3,8 +3,10 @@
 #include "Types.h"
 #include "Config.h"
 #include "ByteBuffer.h"
+#include "SendBuffer.h"
 #include "EventLoop.h"
 #include "AsioHelper.h"
+#include "UdpChannel.h"
 
 namespace net {
 
@@ -21,8 +23,8 @@ namespace net {
 	public:
 		// Network evnet handler.
 		using NetEventHandler = std::function<void(const NetEventType&)>;
-		// Message handler.
-		using MessageHandler = std::function<void(const uint8_t*, size_t)>;
+		// Message handler. message_type 은 프레임 헤더의 타입.
+		using MessageHandler = std::function<void(uint16_t/*message_type*/, const uint8_t*, size_t)>;
 
 		using tcp = boost::asio::ip::tcp;
 		using strand = asio::io_context::strand;
@@ -46,28 +48,53 @@ namespace net {
 		// Inherited via Client
 		virtual void Send(const uint8_t * data, size_t size)
 		{
-			auto buffer = std::make_shared<Buffer>(size);
-			buffer->WriteBytes(data, size);
-			Send(std::move(buffer));
+			Send(ByteSendBuffer::Create(data, size));
 		}
 
 		virtual void Send(const Buffer & data)
 		{
-			Send(std::make_shared<Buffer>(data));
+			Send(ByteSendBuffer::Create(data.Data() + data.ReaderIndex(), data.ReadableBytes()));
 		}
 
 		virtual void Send(Buffer&& data)
 		{
-			Send(std::make_shared<Buffer>(std::move(data)));
+			Send(ByteSendBuffer::Create(std::move(data)));
 		}
 
+		// 버퍼를 복사하지 않고 참조해서 보낸다. 보낸 뒤에는 버퍼를 바꾸면 안된다.
 		virtual void Send(Ptr<Buffer> message)
+		{
+			Send(SharedByteSendBuffer::Create(std::move(message)));
+		}
+
+		// 헤더가 인코딩된 버퍼를 복사 없이 전송 큐에 넣는다.
+		virtual void Send(Ptr<const SendBuffer> message)
 		{
 			if (!IsConnected()) return;
 
 			PendWrite(std::move(message));
 		}
 
+		// 서버가 보낸 token 으로 바인드한 UDP 채널로 보낸다. 받는 쪽은 같은 key 의 이전 메시지를 버린다.
+		// UDP 가 바인드되지 않았거나 데이터그램 크기를 넘으면 TCP 로 보낸다.
+		virtual void SendUnreliable(uint64_t key, const uint8_t* data, size_t size)
+		{
+			SendUnreliable(key, ByteSendBuffer::Create(data, size));
+		}
+
+		virtual void SendUnreliable(uint64_t key, Ptr<const SendBuffer> message)
+		{
+			if (!IsConnected()) return;
+
+			PendUnreliable(key, std::move(message));
+		}
+
+		// UDP 채널이 바인드 되었는지.
+		bool IsUdpBound() const
+		{
+			return udp_bound_.load(std::memory_order_acquire);
+		}
+
 		virtual void RegisterNetEventHandler(const NetEventHandler& handler)
 		{
 			net_event_handler_ = handler;
@@ -97,16 +124,13 @@ namespace net {
 			Closed
 		};
 
-		struct Header
-		{
-			int32_t payload_len;
-		};
-
 		using MessageHandlerMap = std::map<uint16_t, MessageHandler>;
 
 		void ConnectStart(tcp::resolver::iterator endpoint_iterator);
 		void Read(size_t min_read_bytes);
 		void HandleRead(const error_code & error, std::size_t bytes_transferred);
+		// heartbeat_interval 마다 heartbeat 프레임을 보낸다.
+		void StartHeartbeat();
 
 		void HandleReceiveData(Buffer& read_buf, size_t& next_read_size)
 		{
@@ -114,65 +138,116 @@ namespace net {
 		}
 
 		bool PrepareRead(size_t min_prepare_bytes);
-		void PendWrite(Ptr<Buffer> buf);
+		void PendWrite(Ptr<const SendBuffer> buf);
+		void PendUnreliable(uint64_t key, Ptr<const SendBuffer> buf);
 		void Write();
 		void HandleWrite(const error_code & error);
 		void HandleError(const error_code & error);
 		void _Close();
 
-		void EncodeSendData(Ptr<Buffer>& data)
-		{
-			// Make header
-			Header header;
-			header.payload_len = (int32_t)data->ReadableBytes();
-
-			// To Do : ȣȭ  ..
-
-			data->InsertBytes(data->ReaderIndex(), reinterpret_cast<uint8_t*>(&header.payload_len), 0, sizeof(header.payload_len));
-			data->WriterIndex(data->WriterIndex() + sizeof(header.payload_len));
-		}
+		// 서버가 보낸 제어 메시지.
+		void HandleControl(const uint8_t* payload, size_t size);
+		// 서버의 UDP 포트로 채널을 열고 token 으로 바인드를 요청한다.
+		void BindUdp(uint64_t token, uint16_t port);
+		// BindAck 를 받을 때까지 udp_bind_interval 마다 다시 요청한다.
+		void SendUdpBind(size_t remain_attempts);
+		// UDP 채널이 받은 데이터그램. io_context 에서 호출되므로 strand 로 넘긴다.
+		void HandleDatagram(const DatagramHeader& header, const asio::ip::udp::endpoint& endpoint, const uint8_t* payload, size_t size);
 
 		void DecodeRecvData(Buffer& buf, size_t&)
 		{
-			Header header = { 0 };
-			// ó Ͱ  ݺ
+			FrameHeader header{};
+			// 처리할 데이터가 있으면 반복
 			while (buf.IsReadable())
 			{
 				// Decode Header
-				//   ŭ   
-				if (!buf.IsReadable(sizeof(Header)))
+				// 헤더 사이즈 만큼 받지 못했으면 리턴
+				if (!buf.IsReadable(sizeof(FrameHeader)))
 					return;
 
-				// TO DO :  ?
-				buf.GetPOD(buf.ReaderIndex(), header.payload_len);
+				// TO DO : 헤더 검증?
+				buf.GetPOD(buf.ReaderIndex(), header);
+				size_t payload_len = header.Length();
 
 				// Decode Body
-				// Header + Body  ŭ   
-				if (!buf.IsReadable(sizeof(Header) + header.payload_len))
+				// Header + Body 사이즈 만큼 받지 못했으면 리턴
+				if (!buf.IsReadable(sizeof(FrameHeader) + payload_len))
 					return;
 
-				//  ŭ 
-				buf.SkipBytes(sizeof(Header));
-				// TO DO : ȣȭ?
+				// 헤더 사이즈만큼 전진
+				buf.SkipBytes(sizeof(FrameHeader));
+				// TO DO : 복호화?
+
+				// payload 가 없는 프레임은 연결 유지용이다.
+				if (payload_len == 0)
+					continue;
+
+				if (header.IsControl())
+				{
+					HandleControl(buf.Data() + buf.ReaderIndex(), payload_len);
+					buf.SkipBytes(payload_len);
+					continue;
+				}
+
+				const uint8_t* payload = buf.Data() + buf.ReaderIndex();
+				size_t payload_size = payload_len;
+				// 압축된 payload 는 풀어서 넘긴다.
+				if (header.IsCompressed())
+				{
+					payload = Compressor::DecompressPayload(payload, payload_len, config_.max_decompressed_size, payload_size);
+					if (payload == nullptr)
+					{
+						_Close();
+						if (net_event_handler_) net_event_handler_(NetEventType::Closed);
+						return;
+					}
+				}
 
 				// Call receive handler
 				if (message_handler_)
-					message_handler_(buf.Data() + buf.ReaderIndex(), header.payload_len);
+					message_handler_(header.message_type, payload, payload_size);
 
-				// ٵ ŭ 
-				buf.SkipBytes(header.payload_len);
+				// 바디 사이즈만큼 전진
+				buf.SkipBytes(payload_len);
 			}
 		}
 
+		// compress_threshold 보다 큰 프레임은 압축한 프레임으로 바꾼다.
+		Ptr<const SendBuffer> CompressFrame(const Ptr<const SendBuffer>& buf) const
+		{
+			if (config_.compress_threshold == 0 || buf->Size() < sizeof(FrameHeader) + config_.compress_threshold)
+				return buf;
+
+			auto compressed = buf->Compressed();
+			return compressed ? compressed : buf;
+		}
+
 		NetEventHandler net_event_handler_;
 		MessageHandler message_handler_;
 
 		std::unique_ptr<tcp::socket> socket_;
 		std::unique_ptr<strand> strand_;
+		std::unique_ptr<asio::steady_timer> heartbeat_timer_;
 
 		Ptr<Buffer> read_buf_;
-		std::vector<Ptr<Buffer>> pending_list_;
-		std::vector<Ptr<Buffer>> sending_list_;
+		std::vector<Ptr<const SendBuffer>> pending_list_;
+		std::vector<Ptr<const SendBuffer>> sending_list_;
+		// sending_list_ 의 메모리 조각. Write 마다 재사용한다.
+		std::vector<asio::const_buffer> write_buffers_;
+		// 읽기/쓰기 완료 핸들러가 재사용하는 메모리.
+		HandlerMemory read_memory_;
+		HandlerMemory write_memory_;
+
+		// UDP 채널. 아래는 udp_bound_ 를 빼고 strand 에서만 사용한다.
+		Ptr<UdpChannel> udp_channel_;
+		std::unique_ptr<asio::steady_timer> udp_bind_timer_;
+		asio::ip::udp::endpoint udp_server_endpoint_;
+		uint64_t udp_token_ = 0;
+		std::atomic<bool> udp_bound_{ false };
+		uint32_t udp_send_sequence_ = 0;
+		// key 는 서버가 정하고 보이는 Actor 마다 하나씩 늘어나므로 수를 제한하지 않는다.
+		// 바인드할때마다 서버의 sequence 가 1 부터 시작하므로 비운다.
+		SequenceFilter udp_receive_filter_{ 0 };
 
 		ClientConfig	config_;
 		State				state_;
@@ -0,0 +1,234 @@
+#include <algorithm>
+#include "NetMetrics.h"
+#include "ThreadStats.h"
+#include "Session.h"
+
+namespace net {
+
+namespace {
+
+	static_assert(static_cast<size_t>(CloseReason::RateLimited) + 1 == NetStats::CLOSE_REASON_COUNT, "invalid close reason count");
+
+	struct MessageTypeCounters
+	{
+		StatCounter received_messages{ 0 };
+		StatCounter received_bytes{ 0 };
+		StatCounter sent_messages{ 0 };
+		StatCounter sent_bytes{ 0 };
+		StatCounter rate_limited_messages{ 0 };
+	};
+
+	// 스레드별 카운터. 소유한 스레드만 쓰고 GetStats 에서 읽는다.
+	struct ThreadCounters
+	{
+		StatCounter accepted_sessions{ 0 };
+		StatCounter rejected_sessions{ 0 };
+		std::array<StatCounter, NetStats::CLOSE_REASON_COUNT> closed_sessions{};
+
+		StatCounter reads{ 0 };
+		StatCounter read_bytes{ 0 };
+		std::array<StatCounter, NetStats::HISTOGRAM_BUCKETS> read_size_histogram{};
+
+		StatCounter writes{ 0 };
+		StatCounter write_bytes{ 0 };
+		StatCounter write_latency_total_us{ 0 };
+		StatCounter write_latency_max_us{ 0 };
+		std::array<StatCounter, NetStats::HISTOGRAM_BUCKETS> write_latency_histogram{};
+
+		StatCounter send_queue_peak_messages{ 0 };
+		StatCounter send_queue_peak_bytes{ 0 };
+
+		std::array<MessageTypeCounters, NetMetrics::MESSAGE_TYPE_COUNT> message_types;
+
+		ThreadCounters();
+		~ThreadCounters();
+	};
+
+	// 스레드 카운터의 합계.
+	struct StatsTotals
+	{
+		NetStats stats;
+		std::array<MessageTypeStats, NetMetrics::MESSAGE_TYPE_COUNT> message_types{};
+	};
+
+	using StatsRegistry = ThreadStatsRegistry<ThreadCounters, StatsTotals>;
+
+	// counters 의 값을 totals 에 더한다.
+	void Accumulate(StatsTotals& totals, const ThreadCounters& counters)
+	{
+		auto& stats = totals.stats;
+		auto& message_types = totals.message_types;
+
+		stats.accepted_sessions += LoadStat(counters.accepted_sessions);
+		stats.rejected_sessions += LoadStat(counters.rejected_sessions);
+		for (size_t i = 0; i < NetStats::CLOSE_REASON_COUNT; i++)
+			stats.closed_sessions[i] += LoadStat(counters.closed_sessions[i]);
+
+		stats.reads += LoadStat(counters.reads);
+		stats.read_bytes += LoadStat(counters.read_bytes);
+		stats.writes += LoadStat(counters.writes);
+		stats.write_bytes += LoadStat(counters.write_bytes);
+		stats.write_latency_total_us += LoadStat(counters.write_latency_total_us);
+		stats.write_latency_max_us = std::max<uint64_t>(stats.write_latency_max_us, LoadStat(counters.write_latency_max_us));
+		for (size_t i = 0; i < NetStats::HISTOGRAM_BUCKETS; i++)
+		{
+			stats.read_size_histogram[i] += LoadStat(counters.read_size_histogram[i]);
+			stats.write_latency_histogram[i] += LoadStat(counters.write_latency_histogram[i]);
+		}
+
+		stats.send_queue_peak_messages = std::max<size_t>(stats.send_queue_peak_messages, LoadStat(counters.send_queue_peak_messages));
+		stats.send_queue_peak_bytes = std::max<size_t>(stats.send_queue_peak_bytes, LoadStat(counters.send_queue_peak_bytes));
+
+		for (size_t i = 0; i < NetMetrics::MESSAGE_TYPE_COUNT; i++)
+		{
+			auto& src = counters.message_types[i];
+			auto& dst = message_types[i];
+			dst.received_messages += LoadStat(src.received_messages);
+			dst.received_bytes += LoadStat(src.received_bytes);
+			dst.sent_messages += LoadStat(src.sent_messages);
+			dst.sent_bytes += LoadStat(src.sent_bytes);
+			dst.rate_limited_messages += LoadStat(src.rate_limited_messages);
+		}
+	}
+
+	// 스레드가 종료되어 카운터가 해제된 뒤에는 nullptr 이 된다.
+	thread_local ThreadCounters* t_counters = nullptr;
+
+	ThreadCounters::ThreadCounters()
+	{
+		t_counters = this;
+		StatsRegistry::Instance().Register(this);
+	}
+
+	ThreadCounters::~ThreadCounters()
+	{
+		t_counters = nullptr;
+		StatsRegistry::Instance().Retire(this, Accumulate);
+	}
+
+	ThreadCounters* GetThreadCounters()
+	{
+		thread_local ThreadCounters counters;
+		return t_counters;
+	}
+
+	size_t MessageTypeIndex(uint16_t message_type)
+	{
+		return message_type < NetMetrics::MESSAGE_TYPE_COUNT ? message_type : 0;
+	}
+
+} // namespace
+
+size_t NetMetrics::HistogramBucket(uint64_t value)
+{
+	size_t bucket = 0;
+	while (value != 0 && bucket < NetStats::HISTOGRAM_BUCKETS - 1)
+	{
+		value >>= 1;
+		bucket++;
+	}
+	return bucket;
+}
+
+void NetMetrics::RecordAccept()
+{
+	if (auto counters = GetThreadCounters())
+		AddStat(counters->accepted_sessions, 1);
+}
+
+void NetMetrics::RecordReject()
+{
+	if (auto counters = GetThreadCounters())
+		AddStat(counters->rejected_sessions, 1);
+}
+
+void NetMetrics::RecordClose(CloseReason reason)
+{
+	size_t index = static_cast<size_t>(reason);
+	auto counters = GetThreadCounters();
+	if (counters && index < NetStats::CLOSE_REASON_COUNT)
+		AddStat(counters->closed_sessions[index], 1);
+}
+
+void NetMetrics::RecordRead(size_t bytes)
+{
+	auto counters = GetThreadCounters();
+	if (counters == nullptr)
+		return;
+
+	AddStat(counters->reads, 1);
+	AddStat(counters->read_bytes, bytes);
+	AddStat(counters->read_size_histogram[HistogramBucket(bytes)], 1);
+}
+
+void NetMetrics::RecordWrite(size_t bytes, std::chrono::steady_clock::duration latency)
+{
+	auto counters = GetThreadCounters();
+	if (counters == nullptr)
+		return;
+
+	uint64_t latency_us = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+	AddStat(counters->writes, 1);
+	AddStat(counters->write_bytes, bytes);
+	AddStat(counters->write_latency_total_us, latency_us);
+	MaxStat(counters->write_latency_max_us, latency_us);
+	AddStat(counters->write_latency_histogram[HistogramBucket(latency_us)], 1);
+}
+
+void NetMetrics::RecordSendQueue(size_t messages, size_t bytes)
+{
+	auto counters = GetThreadCounters();
+	if (counters == nullptr)
+		return;
+
+	MaxStat(counters->send_queue_peak_messages, messages);
+	MaxStat(counters->send_queue_peak_bytes, bytes);
+}
+
+void NetMetrics::RecordReceivedMessage(uint16_t message_type, size_t bytes)
+{
+	auto counters = GetThreadCounters();
+	if (counters == nullptr)
+		return;
+
+	auto& type_counters = counters->message_types[MessageTypeIndex(message_type)];
+	AddStat(type_counters.received_messages, 1);
+	AddStat(type_counters.received_bytes, bytes);
+}
+
+void NetMetrics::RecordSentMessage(uint16_t message_type, size_t bytes)
+{
+	auto counters = GetThreadCounters();
+	if (counters == nullptr)
+		return;
+
+	auto& type_counters = counters->message_types[MessageTypeIndex(message_type)];
+	AddStat(type_counters.sent_messages, 1);
+	AddStat(type_counters.sent_bytes, bytes);
+}
+
+void NetMetrics::RecordRateLimited(uint16_t message_type)
+{
+	if (auto counters = GetThreadCounters())
+		AddStat(counters->message_types[MessageTypeIndex(message_type)].rate_limited_messages, 1);
+}
+
+NetStats NetMetrics::GetStats()
+{
+	auto totals = StatsRegistry::Instance().Collect(Accumulate);
+	NetStats stats = totals.stats;
+	auto& message_types = totals.message_types;
+
+	for (size_t i = 0; i < MESSAGE_TYPE_COUNT; i++)
+	{
+		auto& type_stats = message_types[i];
+		if (type_stats.received_messages == 0 && type_stats.sent_messages == 0)
+			continue;
+
+		type_stats.message_type = static_cast<uint16_t>(i);
+		stats.message_types.push_back(type_stats);
+	}
+	return stats;
+}
+
+} // namespace net
\ No newline at end of file
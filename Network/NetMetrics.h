@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <vector>
+#include <chrono>
+
+namespace net {
+
+	enum class CloseReason;
+
+	// 메시지 타입별 송수신 통계. 타입은 프레임 헤더의 message_type, 바이트는 헤더를 포함한 프레임 크기.
+	struct MessageTypeStats
+	{
+		uint16_t message_type = 0;
+		uint64_t received_messages = 0;
+		uint64_t received_bytes = 0;
+		uint64_t sent_messages = 0;
+		uint64_t sent_bytes = 0;
+		uint64_t rate_limited_messages = 0;	// 받았지만 비율 제한을 넘어서 버린 메시지.
+	};
+
+	// NetServer 세션들의 통계. 프로세스 전체의 합계.
+	struct NetStats
+	{
+		static constexpr size_t CLOSE_REASON_COUNT = 5;
+		// 분포는 2의 거듭제곱 구간으로 센다. 0 번은 0, i 번은 [2^(i-1), 2^i). 마지막 구간은 그 이상 모두.
+		static constexpr size_t HISTOGRAM_BUCKETS = 24;
+
+		uint64_t accepted_sessions = 0;
+		uint64_t rejected_sessions = 0;		// 최대 세션 수를 넘어서 끊은 연결.
+		std::array<uint64_t, CLOSE_REASON_COUNT> closed_sessions{};	// CloseReason 별.
+
+		uint64_t reads = 0;
+		uint64_t read_bytes = 0;
+		std::array<uint64_t, HISTOGRAM_BUCKETS> read_size_histogram{};		// 한번에 읽은 바이트.
+
+		uint64_t writes = 0;
+		uint64_t write_bytes = 0;
+		uint64_t write_latency_total_us = 0;
+		uint64_t write_latency_max_us = 0;
+		std::array<uint64_t, HISTOGRAM_BUCKETS> write_latency_histogram{};	// async_write 시작부터 완료까지(us).
+
+		// 세션 하나의 송신 큐가 가장 컸을때의 크기.
+		size_t send_queue_peak_messages = 0;
+		size_t send_queue_peak_bytes = 0;
+
+		// 메시지가 오간 타입만 타입 순서로 담는다.
+		std::vector<MessageTypeStats> message_types;
+	};
+
+	// 네트워크 계층 카운터.
+	// 스레드마다 따로 세고 GetStats 에서 합치므로 기록할때 락이나 캐시 라인 경합이 없다.
+	class NetMetrics
+	{
+	public:
+		// 타입별로 세는 message_type 범위. flatbuffers union 의 타입은 1 byte 이므로 모두 들어간다.
+		// 범위를 넘는 타입은 0(타입 없음) 으로 센다.
+		static constexpr size_t MESSAGE_TYPE_COUNT = 256;
+
+		static void RecordAccept();
+		static void RecordReject();
+		static void RecordClose(CloseReason reason);
+		static void RecordRead(size_t bytes);
+		static void RecordWrite(size_t bytes, std::chrono::steady_clock::duration latency);
+		static void RecordSendQueue(size_t messages, size_t bytes);
+		static void RecordReceivedMessage(uint16_t message_type, size_t bytes);
+		static void RecordSentMessage(uint16_t message_type, size_t bytes);
+		static void RecordRateLimited(uint16_t message_type);
+
+		// 종료된 스레드의 값도 포함한다.
+		static NetStats GetStats();
+
+		// value 가 들어가는 분포 구간.
+		static size_t HistogramBucket(uint64_t value);
+	};
+
+} // namespace net
\ No newline at end of file
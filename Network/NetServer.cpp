@@ -1,4 +1,7 @@
 #include "NetServer.h"
+#if defined(__linux__)
+#include <sys/random.h>
+#endif
 
 namespace net {
 
@@ -10,23 +13,21 @@ Ptr<NetServer> NetServer::Create(const ServerConfig& config)
 NetServer::NetServer(const ServerConfig & config)
 	: config_(config)
 	, state_(State::Ready)
+	, sessions_(config.max_session_count)
 {
-	//  event_loop  .
+	// 설정된 event_loop 없으면 생성.
 	if (config_.event_loop == nullptr)
 	{
 		size_t thread_count = std::max<size_t>(config_.thread_count, 1);
-		event_loop_ = std::make_shared<EventLoop>(thread_count);
+		event_loop_ = std::make_shared<EventLoop>(thread_count, config_.event_loop_mode);
 	}
 	else
 	{
 		event_loop_ = config_.event_loop;
 	}
-	
-	// Free session id list  . 
-	for (int i = 1; i <= config_.max_session_count; i++)
-	{
-		free_session_id_.push_back(i);
-	}
+
+	context_session_count_ = std::vector<std::atomic<size_t>>(event_loop_->GetIoContextCount());
+	slot_context_.resize(sessions_.Capacity(), 0);
 }
 
 NetServer::~NetServer()
@@ -50,9 +51,52 @@ void NetServer::Start(std::string address, uint16_t port)
 	}
 
 	Listen(endpoint);
-	AcceptStart();
 	state_ = State::Start;
 
+	if (config_.io_uring)
+	{
+		StartIoUring();
+	}
+
+	if (config_.udp_channel)
+	{
+		// TCP 와 같은 주소와 포트를 사용한다.
+		asio::ip::udp::endpoint udp_endpoint(endpoint.address(), endpoint.port());
+		udp_channel_ = std::make_shared<UdpChannel>(event_loop_->GetIoContext(0), udp_endpoint, config_.max_datagram_size);
+		udp_channel_->Start([this](const DatagramHeader& header, const asio::ip::udp::endpoint& sender, const uint8_t* payload, size_t size)
+		{
+			HandleDatagram(header, sender, payload, size);
+		});
+	}
+
+	if (config_.idle_timeout > 0)
+	{
+		size_t interval = std::max<size_t>(config_.idle_check_interval, 1);
+		idle_timeout_ticks_ = (config_.idle_timeout + interval - 1) / interval;
+		idle_start_time_ = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < event_loop_->GetIoContextCount(); i++)
+		{
+			idle_wheels_.emplace_back(std::make_unique<TimerWheel>());
+			idle_timers_.emplace_back(std::make_unique<asio::steady_timer>(event_loop_->GetIoContext(i)));
+			StartIdleTimer(i);
+		}
+	}
+
+	if (config_.stats_log_interval > 0)
+	{
+		stats_timer_ = std::make_unique<asio::steady_timer>(event_loop_->GetIoContext(0));
+		StartStatsTimer();
+	}
+
+	size_t accept_count = std::max<size_t>(config_.accept_count, 1);
+	for (size_t i = 0; i < acceptors_.size(); i++)
+	{
+		for (size_t n = 0; n < accept_count; n++)
+		{
+			AcceptStart(i);
+		}
+	}
+
 	BOOST_LOG_TRIVIAL(info) << "The tcp server started: " << endpoint;
 }
 
@@ -61,94 +105,374 @@ void NetServer::Stop()
 	if (!(state_ == State::Start))
 		return;
 
-	acceptor_->close();
-	//   ݴ´.
-	for (auto& pair : sessions_)
+	for (auto& acceptor : acceptors_)
+	{
+		acceptor->close();
+	}
+	for (auto& timer : idle_timers_)
 	{
-		pair.second->Close();
+		timer->cancel();
+	}
+	if (stats_timer_)
+	{
+		stats_timer_->cancel();
+	}
+	if (udp_channel_)
+	{
+		udp_channel_->Close();
+	}
+	// 모든 세션을 닫는다.
+	sessions_.ForEach([](const Ptr<Session>& session)
+	{
+		session->Close();
+	});
+#if defined(NET_HAS_IO_URING)
+	// 세션들이 닫힌 뒤에 링을 닫는다. 링은 자신의 io_context 에서만 사용한다.
+	for (auto& uring : urings_)
+	{
+		asio::post(uring->GetIoContext(), [uring]
+		{
+			uring->Close();
+		});
 	}
-	sessions_.clear();
-	free_session_id_.clear();
+#endif
 
 	state_ = State::Stop;
 
 	BOOST_LOG_TRIVIAL(info) << "The tcp server stopped";
 }
 
+#if defined(SO_REUSEPORT)
+using reuse_port = asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+#endif
+
 void NetServer::Listen(tcp::endpoint endpoint)
 {
-	auto acceptor = std::make_unique<tcp::acceptor>(event_loop_->GetIoContext());
+	size_t acceptor_count = 1;
+#if defined(SO_REUSEPORT)
+	// 커널이 연결을 acceptor 들에게 나눠준다.
+	if (config_.reuse_port)
+		acceptor_count = event_loop_->GetIoContextCount();
+#else
+	if (config_.reuse_port)
+		BOOST_LOG_TRIVIAL(info) << "SO_REUSEPORT is not supported. use a single acceptor";
+#endif
+
+	for (size_t i = 0; i < acceptor_count; i++)
+	{
+		auto acceptor = std::make_unique<tcp::acceptor>(event_loop_->GetIoContext(i));
 
-	acceptor->open(endpoint.protocol());
-	acceptor->set_option(tcp::acceptor::reuse_address(true));
-	acceptor->bind(endpoint);
-	acceptor->listen(tcp::acceptor::max_connections);
+		acceptor->open(endpoint.protocol());
+		acceptor->set_option(tcp::acceptor::reuse_address(true));
+#if defined(SO_REUSEPORT)
+		if (config_.reuse_port)
+			acceptor->set_option(reuse_port(true));
+#endif
+		acceptor->bind(endpoint);
+		acceptor->listen(tcp::acceptor::max_connections);
 
-	acceptor_ = std::move(acceptor);
+		acceptors_.emplace_back(std::move(acceptor));
+	}
 }
 
-inline void NetServer::AcceptStart()
+void NetServer::StartIoUring()
 {
-	int id = 0;
+#if defined(NET_HAS_IO_URING)
+	// 링은 하나의 스레드에서만 사용할수 있다.
+	if (event_loop_->GetMode() != EventLoopMode::ContextPerThread)
 	{
-		std::lock_guard<std::mutex> guard(mutex_);
-		if (free_session_id_.empty())
-			return;
+		BOOST_LOG_TRIVIAL(info) << "io_uring requires EventLoopMode::ContextPerThread. use asio";
+		return;
+	}
 
-		// id ߱
-		id = free_session_id_.front();
-		free_session_id_.pop_front();
-		//  ü .
+	for (size_t i = 0; i < event_loop_->GetIoContextCount(); i++)
+	{
+		auto uring = IoUring::Create(event_loop_->GetIoContext(i), config_.io_uring_entries, config_.io_uring_buffer_size, config_.io_uring_buffer_count);
+		if (!uring)
+		{
+			BOOST_LOG_TRIVIAL(info) << "io_uring is not available. use asio";
+			for (auto& created : urings_)
+			{
+				asio::post(created->GetIoContext(), [created]
+				{
+					created->Close();
+				});
+			}
+			urings_.clear();
+			return;
+		}
+		urings_.emplace_back(std::move(uring));
 	}
 
-	// Create Session
-	auto session = std::make_shared<Session>(event_loop_->GetIoContext(), id, config_);
+	BOOST_LOG_TRIVIAL(info) << "io_uring enabled. multishot receive: " << (urings_[0]->HasBufferGroup() ? "on" : "off");
+#else
+	BOOST_LOG_TRIVIAL(info) << "io_uring is not supported. use asio";
+#endif
+}
+
+void NetServer::AcceptStart(size_t acceptor_index)
+{
+	// 세션이 실행될 io_context 배정. 세션이 닫힐때까지 바뀌지 않는다.
+	size_t context_index = SelectIoContext();
+	auto& io_context = event_loop_->GetIoContext(context_index);
 
 	// Async accept
-	acceptor_->async_accept(session->GetSocket(), [this, self = shared_from_this(), session](error_code error) mutable
+	auto& acceptor = *acceptors_[acceptor_index];
+	acceptor.async_accept(io_context, [this, self = shared_from_this(), acceptor_index, context_index, &io_context](error_code error, tcp::socket socket) mutable
 	{
 		if (state_ == State::Stop)
-		{
-			session->Close();
 			return;
-		}
 
-		if (!error)
+		if (error)
 		{
+			BOOST_LOG_TRIVIAL(info) << "The tcp server accept error: " << error.message();
+			if (error == asio::error::operation_aborted)
+				return;
+
+			// 자원이 모자라면 대기중인 연결이 남아 있어서 바로 다시 받으면 계속 실패한다.
+			if (error == asio::error::no_descriptors || error == asio::error::no_buffer_space ||
+				error == asio::error::no_memory || error.value() == ENFILE)
 			{
-				std::lock_guard<std::mutex> guard(mutex_);
-				//  Ʈ ߰.
-				sessions_.emplace(session->GetID(), session);
+				AcceptRetry(acceptor_index);
+				return;
 			}
-			// ڵ鷯 
-			session->open_handler = [this](auto& s) {
-				HandleSessionOpen(s);
-			};
-			session->close_handler = [this](auto& s, CloseReason reason) {
-				HandleSessionClose(s, reason);
-			};
-			session->recv_handler = [this](auto& s, const uint8_t* buf, size_t bytes) {
-				HandleSessionReceive(s, buf, bytes);
-			};
-
-			//  
-			session->Start();
+
+			AcceptStart(acceptor_index);
+			return;
+		}
+
+		// id 발급
+		int id = 0;
+		if (!sessions_.Acquire(id))
+		{
+			// 최대 세션 수를 넘으면 연결을 끊는다.
+			NetMetrics::RecordReject();
+			BOOST_LOG_TRIVIAL(info) << "The tcp server session limit reached: " << sessions_.Capacity();
+			error_code ec;
+			socket.close(ec);
+			AcceptStart(acceptor_index);
+			return;
 		}
+
+		NetMetrics::RecordAccept();
+		context_session_count_[context_index]++;
+		slot_context_[sessions_.Index(id)] = context_index;
+
+		// Create Session
+		// io_context 마다 스레드가 하나면 strand 가 필요없다.
+		// 닫힌 세션 객체의 마지막 참조가 사라져 슬롯으로 돌아와 있으면 재사용한다.
+		bool use_strand = event_loop_->GetMode() != EventLoopMode::ContextPerThread;
+		auto session = sessions_.TakeRecyclable(id);
+		if (session)
+			session->Reset(io_context, id, use_strand);
 		else
+			session = sessions_.MakeRecyclable(id, std::make_unique<Session>(io_context, id, config_, use_strand));
+		session->GetSocket() = std::move(socket);
+		if (!idle_wheels_.empty())
+			session->SetIdleWheel(idle_wheels_[context_index].get(), idle_timeout_ticks_);
+		if (udp_channel_)
+			session->SetUdpChannel(udp_channel_, MakeUdpToken(id));
+#if defined(NET_HAS_IO_URING)
+		if (!urings_.empty())
+			session->SetIoUring(urings_[context_index]);
+#endif
+
+		// 세션 리스트에 추가.
+		sessions_.Set(id, session);
+		// 핸들러 등록
+		session->open_handler = [this](auto& s) {
+			HandleSessionOpen(s);
+		};
+		session->close_handler = [this](auto& s, CloseReason reason) {
+			HandleSessionClose(s, reason);
+		};
+		session->recv_handler = [this](auto& s, uint16_t message_type, const uint8_t* buf, size_t bytes) {
+			HandleSessionReceive(s, message_type, buf, bytes);
+		};
+
+		// 세션 시작
+		session->Start();
+
+		// 새로운 접속을 받는다
+		AcceptStart(acceptor_index);
+	});
+}
+
+void NetServer::AcceptRetry(size_t acceptor_index)
+{
+	auto timer = std::make_shared<asio::steady_timer>(acceptors_[acceptor_index]->get_executor());
+	timer->expires_after(std::chrono::milliseconds(config_.accept_retry_interval));
+	timer->async_wait([this, self = shared_from_this(), acceptor_index, timer](const error_code& error)
+	{
+		if (error || state_ == State::Stop)
+			return;
+
+		AcceptStart(acceptor_index);
+	});
+}
+
+size_t NetServer::SelectIoContext()
+{
+	size_t count = context_session_count_.size();
+	if (count == 1)
+		return 0;
+
+	if (config_.session_affinity == SessionAffinity::LeastLoad)
+	{
+		size_t index = 0;
+		size_t min_count = context_session_count_[0].load();
+		for (size_t i = 1; i < count; i++)
 		{
+			size_t n = context_session_count_[i].load();
+			if (n < min_count)
 			{
-				std::lock_guard<std::mutex> guard(mutex_);
-				// id  
-				free_session_id_.push_back(session->GetID());
+				min_count = n;
+				index = i;
 			}
-			BOOST_LOG_TRIVIAL(info) << "The tcp server accept error: " << error.message();
 		}
+		return index;
+	}
+
+	return next_context_.fetch_add(1) % count;
+}
+
+void NetServer::StartIdleTimer(size_t context_index)
+{
+	// 밀리지 않도록 시작 시간 기준으로 다음 틱 시간을 정한다.
+	auto interval = std::chrono::milliseconds(std::max<size_t>(config_.idle_check_interval, 1));
+	auto& timer = *idle_timers_[context_index];
+	timer.expires_at(idle_start_time_ + interval * (idle_wheels_[context_index]->Now() + 1));
+	timer.async_wait([this, self = shared_from_this(), context_index](const error_code& error)
+	{
+		if (error || state_ == State::Stop)
+			return;
+
+		HandleIdleTimer(context_index);
+		StartIdleTimer(context_index);
+	});
+}
+
+void NetServer::HandleIdleTimer(size_t context_index)
+{
+	auto interval = std::chrono::milliseconds(std::max<size_t>(config_.idle_check_interval, 1));
+	uint64_t target = static_cast<uint64_t>((std::chrono::steady_clock::now() - idle_start_time_) / interval);
+
+	TimerWheel& wheel = *idle_wheels_[context_index];
+	std::vector<Ptr<Session>> expired;
+	auto on_expire = [&wheel, &expired](TimerWheel::Entry* entry) -> uint64_t
+	{
+		Session* session = static_cast<Session*>(entry);
+		uint64_t remain = session->CheckIdle(wheel.Now());
+		if (remain == 0)
+			expired.emplace_back(session->shared_from_this());
+		return remain;
+	};
+
+	// 타이머가 늦게 불렸으면 밀린 틱을 모두 진행한다.
+	while (wheel.Now() < target)
+	{
+		wheel.Tick(on_expire);
+	}
+
+	for (auto& session : expired)
+	{
+		session->CloseByTimeout();
+	}
+}
+
+void NetServer::StartStatsTimer()
+{
+	stats_timer_->expires_after(std::chrono::milliseconds(config_.stats_log_interval));
+	stats_timer_->async_wait([this, self = shared_from_this()](const error_code& error)
+	{
+		if (error || state_ == State::Stop)
+			return;
+
+		LogStats();
+		StartStatsTimer();
+	});
+}
+
+void NetServer::LogStats()
+{
+	NetStats stats = GetNetStats();
+	uint64_t write_latency_avg_us = stats.writes > 0 ? stats.write_latency_total_us / stats.writes : 0;
+	BOOST_LOG_TRIVIAL(info) << "Net stats. accepted:" << stats.accepted_sessions << " rejected:" << stats.rejected_sessions
+		<< " reads:" << stats.reads << " read_bytes:" << stats.read_bytes
+		<< " writes:" << stats.writes << " write_bytes:" << stats.write_bytes
+		<< " write_latency_avg_us:" << write_latency_avg_us << " write_latency_max_us:" << stats.write_latency_max_us
+		<< " send_queue_peak:" << stats.send_queue_peak_messages << "/" << stats.send_queue_peak_bytes;
+
+	for (auto& type_stats : stats.message_types)
+	{
+		BOOST_LOG_TRIVIAL(info) << "Net stats. message_type:" << type_stats.message_type
+			<< " received:" << type_stats.received_messages << "/" << type_stats.received_bytes
+			<< " sent:" << type_stats.sent_messages << "/" << type_stats.sent_bytes
+			<< " rate_limited:" << type_stats.rate_limited_messages;
+	}
+
+	// 송신 큐가 비어 있는 세션은 느린 세션이 아니다.
+	for (auto& session : GetSlowestSessions(config_.stats_log_sessions))
+	{
+		auto queue_stats = session->GetSendQueueStats();
+		if (queue_stats.queued_bytes == 0)
+			break;
+
+		auto session_stats = session->GetStats();
+		BOOST_LOG_TRIVIAL(info) << "Net stats. slow session id:" << session->GetID()
+			<< " queued:" << queue_stats.queued_messages << "/" << queue_stats.queued_bytes
+			<< " peak_bytes:" << session_stats.send_queue_peak_bytes
+			<< " write_latency_last_us:" << session_stats.last_write_latency_us << " write_latency_max_us:" << session_stats.max_write_latency_us;
+	}
+}
+
+std::vector<Ptr<Session>> NetServer::GetSlowestSessions(size_t count) const
+{
+	std::vector<std::pair<size_t, Ptr<Session>>> sessions;
+	sessions_.ForEach([&sessions](const Ptr<Session>& session)
+	{
+		if (session->IsOpen())
+			sessions.emplace_back(session->GetSendQueueStats().queued_bytes, session);
+	});
 
-		// ο  ޴´
-		AcceptStart();
+	count = std::min(count, sessions.size());
+	std::partial_sort(sessions.begin(), sessions.begin() + count, sessions.end(), [](auto& lhs, auto& rhs)
+	{
+		return lhs.first > rhs.first;
 	});
 
-	//accept_op_ = true;
+	std::vector<Ptr<Session>> result;
+	result.reserve(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		result.emplace_back(std::move(sessions[i].second));
+	}
+	return result;
+}
+
+uint64_t NetServer::MakeUdpToken(int id)
+{
+	// 받은 token 으로 다른 세션의 token 을 짐작하지 못하도록 운영체제의 암호학적 난수를 쓴다.
+	uint32_t secret = 0;
+#if defined(__linux__)
+	if (getrandom(&secret, sizeof(secret), 0) != static_cast<ssize_t>(sizeof(secret)))
+		secret = std::random_device{}();
+#else
+	// MSVC 의 random_device 는 RtlGenRandom 을 사용한다.
+	secret = std::random_device{}();
+#endif
+	return (static_cast<uint64_t>(secret) << 32) | static_cast<uint32_t>(id);
+}
+
+void NetServer::HandleDatagram(const DatagramHeader& header, const asio::ip::udp::endpoint& endpoint, const uint8_t* payload, size_t size)
+{
+	// token 이 맞지 않는 데이터그램은 버린다.
+	int id = static_cast<int>(header.token & 0xffffffff);
+	auto session = sessions_.Find(id);
+	if (!session || session->GetUdpToken() != header.token)
+		return;
+
+	session->HandleDatagram(header, endpoint, payload, size);
 }
 
 inline void NetServer::HandleSessionOpen(const Ptr<Session>& session)
@@ -159,25 +483,21 @@ inline void NetServer::HandleSessionOpen(const Ptr<Session>& session)
 
 inline void NetServer::HandleSessionClose(const Ptr<Session>& session, CloseReason reason)
 {
+	NetMetrics::RecordClose(reason);
+
 	if (session_closed_handler_)
 		session_closed_handler_(session, reason);
 
 	auto id = session->GetID();
-	//  Ʈ ش.
-	{
-		std::lock_guard<std::mutex> guard(mutex_);
-		sessions_.erase(id);
-		// id  
-		free_session_id_.push_back(id);
-	}
-
-	AcceptStart();
+	// 세션 리스트에서 지우고 슬롯을 돌려준다. 세션 객체는 마지막 참조가 사라지면 슬롯으로 돌아온다.
+	context_session_count_[slot_context_[sessions_.Index(id)]]--;
+	sessions_.Release(id);
 }
 
-inline void NetServer::HandleSessionReceive(const Ptr<Session>& session, const uint8_t* buf, size_t bytes)
+inline void NetServer::HandleSessionReceive(const Ptr<Session>& session, uint16_t message_type, const uint8_t* buf, size_t bytes)
 {
 	if (message_handler_)
-		message_handler_(session, buf, bytes);
+		message_handler_(session, message_type, buf, bytes);
 }
 
 } // namespace net
\ No newline at end of file
@@ -1,9 +1,10 @@
 #pragma once
 
-#include <mutex>
-#include <map>
-#include <deque>
+#include <vector>
+#include <algorithm>
+#include <random>
 #include "Session.h"
+#include "SessionRegistry.h"
 #include "EventLoop.h"
 
 namespace net {
@@ -27,8 +28,8 @@ namespace net {
 		// Handler to be notified on session close. This one ignores the close reason.
 		using SessionClosedHandler = std::function<void(const Ptr<Session>&/*session*/, const CloseReason&)>;
 
-		// Receive handler type.
-		using MessageHandler = std::function<void(const Ptr<Session>&/*session*/, const uint8_t*, size_t)>;
+		// Receive handler type. message_type 은 프레임 헤더의 타입.
+		using MessageHandler = std::function<void(const Ptr<Session>&/*session*/, uint16_t/*message_type*/, const uint8_t*, size_t)>;
 
 		// Create server instance.
 		static Ptr<NetServer> Create(const ServerConfig& config);
@@ -53,11 +54,30 @@ namespace net {
 			return event_loop_;
 		}
 
+		// 수신 버퍼 메모리 사용량. 프로세스 전체 세션의 합계.
+		ReceiveMemoryStats GetReceiveMemoryStats() const
+		{
+			return Session::GetReceiveMemoryStats();
+		}
+
+		// 세션들의 송수신 통계. 프로세스 전체 세션의 합계.
+		NetStats GetNetStats() const
+		{
+			return NetMetrics::GetStats();
+		}
+
+		// 송신 큐에 쌓인 바이트가 많은 순서로 최대 count 개의 세션. 받는 쪽이 느린 세션을 찾을때 사용한다.
+		std::vector<Ptr<Session>> GetSlowestSessions(size_t count) const;
+
+		// udp_channel 이 켜져 있으면 UDP 포트. 아니면 0.
+		uint16_t GetUdpPort() const
+		{
+			return udp_channel_ ? udp_channel_->GetPort() : 0;
+		}
+
 		Ptr<Session> GetSession(int session_id)
 		{
-			std::lock_guard<std::mutex> lock_guard(mutex_);
-			auto iter = sessions_.find(session_id);
-			return (iter != sessions_.end()) ? iter->second : nullptr;
+			return sessions_.Find(session_id);
 		}
 
 		virtual void RegisterSessionOpenedHandler(const SessionOpenedHandler& handler)
@@ -78,12 +98,28 @@ namespace net {
 	private:
 
 		void Listen(tcp::endpoint endpoint);
-		void AcceptStart();
+		// io_context 마다 io_uring 을 만든다. 사용할수 없으면 asio 로 읽고 쓴다.
+		void StartIoUring();
+		void AcceptStart(size_t acceptor_index);
+		// accept_retry_interval 뒤에 AcceptStart 한다.
+		void AcceptRetry(size_t acceptor_index);
+		// 새 세션을 배정할 io_context 의 index.
+		size_t SelectIoContext();
+		// io_context 의 타이밍 휠을 idle_check_interval 마다 돌린다.
+		void StartIdleTimer(size_t context_index);
+		void HandleIdleTimer(size_t context_index);
+		// stats_log_interval 마다 LogStats 한다.
+		void StartStatsTimer();
+		void LogStats();
+		// 세션 id 를 하위 32bit 에 넣은 token. 상위 32bit 는 추측할수 없는 값이다.
+		uint64_t MakeUdpToken(int id);
+		// token 으로 세션을 찾아 데이터그램을 넘긴다.
+		void HandleDatagram(const DatagramHeader& header, const asio::ip::udp::endpoint& endpoint, const uint8_t* payload, size_t size);
 
 		// Session Handler.
 		void HandleSessionOpen(const Ptr<Session>& session);
 		void HandleSessionClose(const Ptr<Session>& session, CloseReason reason);
-		void HandleSessionReceive(const Ptr<Session>& session, const uint8_t* buf, size_t bytes);
+		void HandleSessionReceive(const Ptr<Session>& session, uint16_t message_type, const uint8_t* buf, size_t bytes);
 
 		// handler
 		SessionOpenedHandler	session_opened_handler_;
@@ -93,12 +129,25 @@ namespace net {
 		ServerConfig			config_;
 		State					state_;
 		Ptr<EventLoop>			event_loop_;
-		std::mutex				mutex_;
-		std::deque<int>					free_session_id_;
-		std::map<int, Ptr<Session>>	sessions_;
-
-		std::unique_ptr<tcp::acceptor> acceptor_;
-		// bool accept_op_ = false;
+		// idle_timeout 검사. 세션마다 타이머를 두지 않고 io_context 마다 하나의 타이밍 휠을 사용한다.
+		// 세션이 휠을 참조하므로 sessions_ 보다 먼저 선언한다.
+		std::vector<std::unique_ptr<TimerWheel>>			idle_wheels_;
+		std::vector<std::unique_ptr<asio::steady_timer>>	idle_timers_;
+		std::chrono::steady_clock::time_point				idle_start_time_;
+		uint64_t											idle_timeout_ticks_ = 0;
+		std::unique_ptr<asio::steady_timer>				stats_timer_;
+		SessionRegistry			sessions_;
+		// io_context 별 세션 수와 슬롯별 세션이 배정된 io_context index.
+		std::vector<std::atomic<size_t>>	context_session_count_;
+		std::vector<size_t>					slot_context_;
+		std::atomic<size_t>					next_context_{ 0 };
+
+		std::vector<std::unique_ptr<tcp::acceptor>> acceptors_;
+		Ptr<UdpChannel>			udp_channel_;
+#if defined(NET_HAS_IO_URING)
+		// io_context 별 링. 비어 있으면 사용하지 않는다.
+		std::vector<Ptr<IoUring>>	urings_;
+#endif
 	};
 
 } // namespace net
\ No newline at end of file
@@ -0,0 +1,199 @@
+#pragma once
+
+#include "Types.h"
+#include <mutex>
+#include "ByteBuffer.h"
+#include "Compressor.h"
+
+namespace net {
+
+#pragma pack(push, 1)
+	// 프레임 헤더.
+	// payload_len 의 상위 bit 는 플래그로 사용한다.
+	struct FrameHeader
+	{
+		static constexpr int32_t COMPRESSED = 0x40000000;	// payload 가 압축됨.
+		static constexpr int32_t CONTROL = 0x20000000;		// 네트워크 계층의 제어 메시지. 핸들러에 넘기지 않는다.
+		static constexpr int32_t LENGTH_MASK = 0x1fffffff;
+
+		int32_t payload_len;
+		// payload 의 메시지 타입. 받는 쪽은 payload 를 보지 않고 핸들러를 찾거나 버릴수 있다.
+		// 0 이면 타입을 알리지 않은 프레임.
+		uint16_t message_type;
+		// 헤더를 8 byte 로 맞춰 뒤따르는 payload(flatbuffers) 가 정렬되게 한다. 항상 0.
+		uint16_t reserved;
+
+		size_t Length() const { return static_cast<size_t>(payload_len & LENGTH_MASK); }
+		bool IsCompressed() const { return (payload_len & COMPRESSED) != 0; }
+		bool IsControl() const { return (payload_len & CONTROL) != 0; }
+	};
+#pragma pack(pop)
+	static_assert(sizeof(FrameHeader) == 8, "FrameHeader must keep the payload 8-byte aligned");
+
+	// 헤더까지 인코딩이 끝난 전송 버퍼.
+	// 큐에 넣은 뒤에는 내용을 바꾸지 않으므로 여러 세션이 같은 버퍼를 공유할수 있다.
+	// 하위 클래스의 Create 는 객체를 BufferPool 에서 할당해서 메시지마다 힙 할당을 하지 않는다.
+	class SendBuffer
+	{
+	public:
+		virtual ~SendBuffer() {}
+
+		// 헤더를 포함한 프레임 데이터.
+		virtual const uint8_t* Data() const = 0;
+		// 헤더를 포함한 프레임 크기.
+		virtual size_t Size() const = 0;
+
+		// 프레임 헤더.
+		virtual FrameHeader Header() const
+		{
+			FrameHeader header{};
+			std::memcpy(&header, Data(), sizeof(header));
+			return header;
+		}
+
+		// 전송할 메모리 조각들을 buffers 뒤에 추가한다.
+		virtual void AppendTo(std::vector<asio::const_buffer>& buffers) const
+		{
+			buffers.emplace_back(Data(), Size());
+		}
+
+		// 압축한 프레임. 처음 호출할때 한번만 압축하고 이후에는 공유한다.
+		// 크기가 줄지 않거나 다른 스레드에서 압축중이면 nullptr.
+		Ptr<const SendBuffer> Compressed() const
+		{
+			int state = compress_state_.load(std::memory_order_acquire);
+			if (state == COMPRESS_DONE)
+				return compressed_;
+
+			if (state != COMPRESS_NONE || !compress_state_.compare_exchange_strong(state, COMPRESS_RUNNING))
+				return nullptr;
+
+			compressed_ = Compressor::CompressFrame(*this);
+			compress_state_.store(COMPRESS_DONE, std::memory_order_release);
+			return compressed_;
+		}
+
+	private:
+		enum { COMPRESS_NONE = 0, COMPRESS_RUNNING, COMPRESS_DONE };
+
+		mutable Ptr<const SendBuffer> compressed_;
+		mutable std::atomic<int> compress_state_{ COMPRESS_NONE };
+	};
+
+	// ByteBuffer 를 사용하는 전송 버퍼.
+	class ByteSendBuffer : public SendBuffer
+	{
+	public:
+		// 헤더 공간을 확보한 버퍼에 payload 를 복사한다.
+		static Ptr<ByteSendBuffer> Create(const uint8_t* payload, size_t size, uint16_t message_type = 0)
+		{
+			auto send_buffer = std::allocate_shared<ByteSendBuffer>(PoolAllocator<ByteSendBuffer>(), Buffer(sizeof(FrameHeader) + size));
+			Buffer& buf = send_buffer->buf_;
+			buf.WriterIndex(sizeof(FrameHeader));
+			buf.ReaderIndex(sizeof(FrameHeader));
+			buf.WriteBytes(payload, size);
+			send_buffer->EncodeHeader(0, message_type);
+			return send_buffer;
+		}
+
+		// payload 버퍼를 넘겨 받는다. flags 는 FrameHeader 의 플래그.
+		static Ptr<ByteSendBuffer> Create(Buffer&& payload, int32_t flags = 0, uint16_t message_type = 0)
+		{
+			auto send_buffer = std::allocate_shared<ByteSendBuffer>(PoolAllocator<ByteSendBuffer>(), std::move(payload));
+			send_buffer->EncodeHeader(flags, message_type);
+			return send_buffer;
+		}
+
+		explicit ByteSendBuffer(Buffer&& buf)
+			: buf_(std::move(buf))
+		{
+		}
+
+		const uint8_t* Data() const override
+		{
+			return buf_.Data() + buf_.ReaderIndex();
+		}
+
+		size_t Size() const override
+		{
+			return buf_.ReadableBytes();
+		}
+
+	private:
+		void EncodeHeader(int32_t flags, uint16_t message_type)
+		{
+			FrameHeader header{};
+			header.payload_len = (int32_t)buf_.ReadableBytes() | flags;
+			header.message_type = message_type;
+
+			// To Do : 암호화 등..
+
+			// ReaderIndex 앞에 헤더 공간이 있으면 그 자리에 쓴다.
+			if (buf_.ReaderIndex() >= sizeof(FrameHeader))
+			{
+				size_t index = buf_.ReaderIndex() - sizeof(FrameHeader);
+				buf_.SetPOD(index, header);
+				buf_.ReaderIndex(index);
+				return;
+			}
+
+			buf_.InsertBytes(buf_.ReaderIndex(), reinterpret_cast<uint8_t*>(&header), 0, sizeof(header));
+			buf_.WriterIndex(buf_.WriterIndex() + sizeof(header));
+		}
+
+		Buffer buf_;
+	};
+
+	// 공유된 Buffer 를 복사하지 않고 보내는 전송 버퍼. 헤더는 따로 가지고 payload 앞에 보낸다.
+	// 큐에 넣은 뒤에는 Buffer 를 바꾸면 안된다.
+	class SharedByteSendBuffer : public SendBuffer
+	{
+	public:
+		static Ptr<SharedByteSendBuffer> Create(Ptr<const Buffer> payload, uint16_t message_type = 0)
+		{
+			return std::allocate_shared<SharedByteSendBuffer>(PoolAllocator<SharedByteSendBuffer>(), std::move(payload), message_type);
+		}
+
+		SharedByteSendBuffer(Ptr<const Buffer> payload, uint16_t message_type)
+			: payload_(std::move(payload))
+		{
+			header_.payload_len = (int32_t)payload_->ReadableBytes();
+			header_.message_type = message_type;
+		}
+
+		// 처음 호출할때 헤더와 payload 를 이어 붙인 복사본을 만든다. 압축할때만 사용한다.
+		const uint8_t* Data() const override
+		{
+			std::call_once(flat_once_, [this]
+			{
+				flat_.resize(Size());
+				std::memcpy(flat_.data(), &header_, sizeof(header_));
+				std::memcpy(flat_.data() + sizeof(header_), payload_->Data() + payload_->ReaderIndex(), payload_->ReadableBytes());
+			});
+			return flat_.data();
+		}
+
+		size_t Size() const override
+		{
+			return sizeof(FrameHeader) + payload_->ReadableBytes();
+		}
+
+		FrameHeader Header() const override
+		{
+			return header_;
+		}
+
+		void AppendTo(std::vector<asio::const_buffer>& buffers) const override
+		{
+			buffers.emplace_back(&header_, sizeof(header_));
+			buffers.emplace_back(payload_->Data() + payload_->ReaderIndex(), payload_->ReadableBytes());
+		}
+
+	private:
+		Ptr<const Buffer> payload_;
+		FrameHeader header_{};
+		mutable std::once_flag flat_once_;
+		mutable std::vector<uint8_t> flat_;
+	};
+
+} // namespace net
\ No newline at end of file
@@ -2,23 +2,281 @@
 
 namespace net {
 
+namespace {
+
+	std::atomic<size_t> g_receive_memory{ 0 };
+	std::atomic<size_t> g_receive_memory_peak{ 0 };
+
+	// tracked 로 기록된 크기를 current 로 바꾸고 전체 사용량에 반영한다.
+	void UpdateReceiveMemory(size_t& tracked, size_t current)
+	{
+		if (current > tracked)
+		{
+			size_t add = current - tracked;
+			size_t total = g_receive_memory.fetch_add(add) + add;
+			size_t peak = g_receive_memory_peak.load();
+			while (total > peak && !g_receive_memory_peak.compare_exchange_weak(peak, total))
+			{
+			}
+		}
+		else if (current < tracked)
+		{
+			g_receive_memory.fetch_sub(tracked - current);
+		}
+		tracked = current;
+	}
+
+	// 듀얼 스택 소켓은 IPv4 주소를 IPv4-mapped IPv6 로 알려주므로 비교하기 전에 IPv4 로 바꾼다.
+	asio::ip::address NormalizeAddress(const asio::ip::address& address)
+	{
+		if (address.is_v6() && address.to_v6().is_v4_mapped())
+			return asio::ip::make_address_v4(asio::ip::v4_mapped, address.to_v6());
+		return address;
+	}
+
+	// 스레드 공용 수신 버퍼.
+	struct ReceiveScratch
+	{
+		Buffer buf{ 0 };
+		size_t tracked = 0;
+
+		~ReceiveScratch()
+		{
+			UpdateReceiveMemory(tracked, 0);
+		}
+	};
+
+	thread_local ReceiveScratch t_receive_scratch;
+
+} // namespace
+
 DEFINE_CLASS_PTR(Session);
 
-Session::Session(asio::io_context& io_context, int id, const ServerConfig & config)
+Session::Session(asio::io_context& io_context, int id, const ServerConfig & config, bool use_strand)
 	: id_(id)
 	, state_(State::Ready)
 {
 	socket_ = std::make_unique<tcp::socket>(io_context);
-	strand_ = std::make_unique<strand>(io_context);
+	if (use_strand)
+	{
+		strand_ = std::make_unique<strand>(io_context);
+	}
 
 	// Set config
 	no_delay_ = config.no_delay;
 	min_receive_size_ = config.min_receive_size;
 	max_receive_buffer_size_ = config.max_receive_buffer_size;
+	shared_receive_buffer_ = config.shared_receive_buffer;
+	cork_ = config.cork;
+	corked_ = cork_;
+	cork_threshold_ = config.cork_threshold;
+	max_send_buffer_size_ = config.max_send_buffer_size;
+	send_overflow_timeout_ = std::chrono::milliseconds(config.send_overflow_timeout);
+	compress_threshold_ = config.compress_threshold;
+	max_decompressed_size_ = config.max_decompressed_size;
+	max_frames_per_read_ = config.max_frames_per_read;
+	message_rate_limit_ = config.message_rate_limit;
+	message_type_rate_limits_ = config.message_type_rate_limits;
+	max_rate_violations_ = config.max_rate_violations;
+	udp_message_types_ = config.udp_message_types;
+	rate_limited_ = message_rate_limit_.rate > 0;
+	for (auto& type_limit : message_type_rate_limits_)
+	{
+		if (type_limit.second.rate > 0)
+			rate_limited_ = true;
+	}
+}
+
+void Session::Reset(asio::io_context& io_context, int id, bool use_strand)
+{
+	assert(state_ != State::Opened);
+
+	// 소켓은 NetServer 가 accept 한 소켓으로 교체한다.
+	id_ = id;
+	state_ = State::Ready;
+	strand_.reset();
+	if (use_strand)
+	{
+		strand_ = std::make_unique<strand>(io_context);
+	}
+
+	open_handler = nullptr;
+	close_handler = nullptr;
+	recv_handler = nullptr;
+
+	pending_list_.clear();
+	sending_list_.clear();
+	superseded_count_ = 0;
+	latest_index_.clear();
+	send_overflow_start_time_ = {};
+	pending_bytes_ = 0;
+	sending_bytes_ = 0;
+	corked_ = cork_;
+	flush_requested_ = false;
+	unflushed_ = false;
+
+	stats_queued_messages_ = 0;
+	stats_queued_bytes_ = 0;
+	stats_dropped_bytes_ = 0;
+	stats_merged_messages_ = 0;
+	stats_received_messages_ = 0;
+	stats_received_bytes_ = 0;
+	stats_sent_messages_ = 0;
+	stats_sent_bytes_ = 0;
+	stats_send_queue_peak_bytes_ = 0;
+	stats_last_write_latency_us_ = 0;
+	stats_max_write_latency_us_ = 0;
+	stats_rate_limited_messages_ = 0;
+	receive_yielded_ = false;
+
+	udp_channel_.reset();
+	udp_token_ = 0;
+	udp_bound_ = false;
+	udp_endpoint_ = asio::ip::udp::endpoint();
+	udp_send_sequence_ = 0;
+	udp_receive_filter_.Clear();
+
+	// 남은 프레임 조각은 버린다. 일반 모드의 read 버퍼는 Start 에서 재사용한다.
+	if (UsesSharedReceive())
+	{
+		read_buf_.reset();
+		TrackReceiveMemory();
+	}
+
+#if defined(NET_HAS_IO_URING)
+	uring_.reset();
+#endif
 }
 
 Session::~Session()
 {
+	// NetServer 보다 오래 남은 세션은 휠이 이미 해제했다.
+	if (idle_wheel_ && IsScheduled())
+		idle_wheel_->Cancel(this);
+
+	UpdateReceiveMemory(receive_memory_, 0);
+}
+
+void Session::SetIdleWheel(TimerWheel* idle_wheel, uint64_t timeout_ticks)
+{
+	assert(state_ != State::Opened);
+
+	idle_wheel_ = idle_wheel;
+	idle_timeout_ticks_ = timeout_ticks;
+}
+
+uint64_t Session::CheckIdle(uint64_t now) const
+{
+	uint64_t idle = now - last_receive_tick_.load(std::memory_order_relaxed);
+	if (idle >= idle_timeout_ticks_)
+		return 0;
+
+	return idle_timeout_ticks_ - idle;
+}
+
+void Session::CloseByTimeout()
+{
+	Post([this, self = shared_from_this()]
+	{
+		_Close(CloseReason::Timeout);
+	});
+}
+
+void Session::SetUdpChannel(const Ptr<UdpChannel>& udp_channel, uint64_t token)
+{
+	assert(state_ != State::Opened);
+
+	udp_channel_ = udp_channel;
+	udp_token_ = token;
+}
+
+#if defined(NET_HAS_IO_URING)
+void Session::SetIoUring(const Ptr<IoUring>& uring)
+{
+	assert(state_ != State::Opened);
+
+	uring_ = uring;
+}
+#endif
+
+void Session::SendUdpToken()
+{
+	// [type][token][port] 를 제어 프레임으로 보낸다.
+	Buffer payload(sizeof(uint8_t) + sizeof(uint64_t) + sizeof(uint16_t));
+	payload.Write(static_cast<uint8_t>(ControlType::UdpToken));
+	payload.Write(udp_token_.load());
+	payload.Write(udp_channel_->GetPort());
+	PendWrite(ByteSendBuffer::Create(std::move(payload), FrameHeader::CONTROL));
+}
+
+void Session::HandleDatagram(const DatagramHeader& header, const asio::ip::udp::endpoint& endpoint, const uint8_t* payload, size_t size)
+{
+	switch (static_cast<DatagramType>(header.type))
+	{
+	case DatagramType::Bind:
+		Dispatch([this, self = shared_from_this(), endpoint]
+		{
+			if (!IsOpen())
+				return;
+
+			// token 은 데이터그램마다 평문으로 보내지므로 token 만으로는 바인드하지 않는다.
+			// TCP 로 연결한 주소에서 온 요청만 받아서 token 을 엿본 다른 곳이 세션을 가로채지 못하게 한다.
+			error_code ec;
+			auto remote = socket_->remote_endpoint(ec);
+			if (ec || NormalizeAddress(remote.address()) != NormalizeAddress(endpoint.address()))
+				return;
+
+			udp_endpoint_ = endpoint;
+			udp_bound_.store(true, std::memory_order_release);
+
+			DatagramHeader ack = { static_cast<uint8_t>(DatagramType::BindAck), udp_token_.load(), 0, 0, 0 };
+			udp_channel_->SendTo(endpoint, ack, nullptr, 0);
+		});
+		break;
+	case DatagramType::Data:
+	{
+		if (size == 0 || size > max_receive_buffer_size_)
+			return;
+
+		// UDP 로 받기로 한 타입만 받는다.
+		if (std::find(udp_message_types_.begin(), udp_message_types_.end(), header.message_type) == udp_message_types_.end())
+			return;
+
+		// 채널의 수신 버퍼는 바로 재사용되므로 복사해서 넘긴다.
+		auto buf = std::make_shared<Buffer>(size);
+		buf->WriteBytes(payload, size);
+		Dispatch([this, self = shared_from_this(), endpoint, key = header.key, sequence = header.sequence, message_type = header.message_type, buf]
+		{
+			// 바인드한 주소에서 온 것만 받는다. 주소가 바뀐 클라이언트는 다시 Bind 해야 한다.
+			if (!IsOpen() || !udp_bound_.load(std::memory_order_relaxed) || endpoint != udp_endpoint_)
+				return;
+
+			if (!udp_receive_filter_.Accept(key, sequence))
+				return;
+
+			if (idle_wheel_)
+				last_receive_tick_.store(idle_wheel_->Now(), std::memory_order_relaxed);
+
+			RecordReceivedMessage(message_type, sizeof(DatagramHeader) + buf->ReadableBytes());
+			if (rate_limited_ && !AllowMessage(message_type, TokenBucket::Clock::now()))
+				return;
+
+			if (recv_handler)
+				recv_handler(shared_from_this(), message_type, buf->Data() + buf->ReaderIndex(), buf->ReadableBytes());
+		});
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+ReceiveMemoryStats Session::GetReceiveMemoryStats()
+{
+	ReceiveMemoryStats stats;
+	stats.current_bytes = g_receive_memory.load();
+	stats.peak_bytes = g_receive_memory_peak.load();
+	return stats;
 }
 
 int Session::GetID() const
@@ -39,7 +297,7 @@ bool Session::GetRemoteEndpoint(std::string& ip, uint16_t& port) const
 
 void Session::Close()
 {
-	asio::post(*strand_, [this, self = shared_from_this()]
+	Post([this, self = shared_from_this()]
 	{
 		_Close(CloseReason::ActiveClose);
 	});
@@ -52,17 +310,39 @@ bool Session::IsOpen() const
 
 void Session::Start()
 {
-	asio::post(*strand_, [this, self = shared_from_this()]
+	Post([this, self = shared_from_this()]
 	{
 		try
 		{
 			// socket option
 			socket_->set_option(tcp::no_delay(no_delay_));
 
-			// read  
-			size_t initial_capacity = min_receive_size_;
-			size_t max_capacity = max_receive_buffer_size_;
-			read_buf_ = std::make_shared<Buffer>(initial_capacity, max_capacity);
+			if (UsesSharedReceive())
+			{
+#if defined(NET_HAS_IO_URING)
+				// 커널에 맡긴 버퍼로 받는다. 이전 연결의 조각은 Reset 에서 버렸다.
+				if (uring_)
+				{
+					read_buf_.reset();
+					TrackReceiveMemory();
+				}
+				else
+#endif
+				// 읽을수 있을때 바로 읽으므로 블럭되지 않게 한다.
+				socket_->non_blocking(true);
+			}
+			else
+			{
+				// read 버퍼 생성
+				// 재사용하는 세션이면 이전 버퍼를 그대로 쓴다. 크게 늘어난 버퍼는 새로 만든다.
+				size_t initial_capacity = min_receive_size_;
+				size_t max_capacity = max_receive_buffer_size_;
+				if (read_buf_ && read_buf_->Capacity() <= initial_capacity)
+					read_buf_->Clear();
+				else
+					read_buf_ = std::make_shared<Buffer>(initial_capacity, max_capacity);
+				TrackReceiveMemory();
+			}
 		}
 		catch (const std::exception& e)
 		{
@@ -71,8 +351,30 @@ void Session::Start()
 			return;
 		}
 
+		// 비율 제한은 연결마다 가득 찬 버킷으로 시작한다.
+		if (rate_limited_)
+		{
+			auto now = TokenBucket::Clock::now();
+			message_bucket_ = TokenBucket(message_rate_limit_, now);
+			type_buckets_.clear();
+			for (auto& type_limit : message_type_rate_limits_)
+			{
+				type_buckets_.emplace_back(type_limit.first, TokenBucket(type_limit.second, now));
+			}
+		}
+		// RejectMessage 는 비율 제한이 없어도 센다.
+		rate_violations_ = 0;
+
 		state_ = State::Opened;
+		if (idle_wheel_)
+		{
+			last_receive_tick_ = idle_wheel_->Now();
+			idle_wheel_->Schedule(this, idle_timeout_ticks_);
+		}
 		Read(min_receive_size_);
+		// 다른 메시지보다 먼저 보낸다.
+		if (udp_channel_)
+			SendUdpToken();
 
 		open_handler(shared_from_this());
 	});
@@ -83,50 +385,308 @@ inline void Session::Read(size_t min_read_bytes)
 	if (!IsOpen())
 		return;
 
+#if defined(NET_HAS_IO_URING)
+	if (uring_)
+	{
+		UringRead(min_read_bytes);
+		return;
+	}
+#endif
+
+	if (shared_receive_buffer_)
+	{
+		auto handler = MakeAllocHandler(read_memory_, [this, self = shared_from_this()](const error_code& error)
+		{
+			HandleReadable(error);
+		});
+
+		if (strand_)
+			socket_->async_wait(tcp::socket::wait_read, asio::bind_executor(*strand_, std::move(handler)));
+		else
+			socket_->async_wait(tcp::socket::wait_read, std::move(handler));
+		return;
+	}
+
 	if (!PrepareRead(min_read_bytes))
 	{
 		_Close(CloseReason::ActiveClose);
 		return;
 	}
+	TrackReceiveMemory();
 
 	auto asio_buf = mutable_buffer(*read_buf_);
-	socket_->async_read_some(boost::asio::buffer(asio_buf), asio::bind_executor(*strand_,
-		[this, self = shared_from_this()](const error_code& error, std::size_t bytes_transferred)
+	auto handler = MakeAllocHandler(read_memory_, [this, self = shared_from_this()](const error_code& error, std::size_t bytes_transferred)
 	{
 		HandleRead(error, bytes_transferred);
-	}));
+	});
+
+	if (strand_)
+		socket_->async_read_some(boost::asio::buffer(asio_buf), asio::bind_executor(*strand_, std::move(handler)));
+	else
+		socket_->async_read_some(boost::asio::buffer(asio_buf), std::move(handler));
 }
 
 inline void Session::HandleRead(const error_code & error, std::size_t bytes_transferred)
 {
 	if (!IsOpen())
+	{
+		read_buf_.reset();
+		TrackReceiveMemory();
 		return;
+	}
 
 	if (error)
 	{
-		CloseReason reason = CloseReason::ActiveClose;
-		if (error == boost::asio::error::eof || error == boost::asio::error::operation_aborted)
-			reason = CloseReason::Disconnected;
-
-		HandleError(error);
-		_Close(reason);
+		HandleReadError(error);
 		return;
 	}
 
-	//  WriterIndex  ۹  ũ⸸ŭ 
+	// 버퍼의 WriterIndex 을 전송받은 데이터의 크기만큼 전진
 	read_buf_->WriterIndex(read_buf_->WriterIndex() + bytes_transferred);
+	NetMetrics::RecordRead(bytes_transferred);
+	if (idle_wheel_)
+		last_receive_tick_.store(idle_wheel_->Now(), std::memory_order_relaxed);
 
 	size_t next_read_size = 0;
-	//  Ÿ ó
-	HandleReceiveData(*read_buf_, next_read_size);
+	// 받은 데이타 처리
+	if (HandleReceiveData(*read_buf_, next_read_size))
+	{
+		YieldReceive();
+		return;
+	}
 
 	size_t prepare_size = std::max<size_t>((size_t)next_read_size, min_receive_size_);
 	Read(prepare_size);
 }
 
+inline void Session::HandleReadError(const error_code & error)
+{
+	CloseReason reason = CloseReason::ActiveClose;
+	if (error == boost::asio::error::eof || error == boost::asio::error::operation_aborted)
+		reason = CloseReason::Disconnected;
+
+	HandleError(error);
+	_Close(reason);
+}
+
+inline void Session::HandleReadable(const error_code & error)
+{
+	if (!IsOpen())
+		return;
+
+	if (error)
+	{
+		HandleReadError(error);
+		return;
+	}
+
+	Buffer* buf = PrepareSharedBuffer(min_receive_size_);
+	if (buf == nullptr)
+		return;
+
+	error_code ec;
+	size_t bytes_transferred = socket_->read_some(mutable_buffer(*buf), ec);
+	if (ec == asio::error::would_block || ec == asio::error::try_again)
+	{
+		Read(min_receive_size_);
+		return;
+	}
+	if (ec)
+	{
+		HandleReadError(ec);
+		return;
+	}
+
+	if (HandleSharedData(*buf, bytes_transferred))
+	{
+		YieldReceive();
+		return;
+	}
+
+	Read(min_receive_size_);
+}
+
+inline Buffer* Session::PrepareSharedBuffer(size_t read_size)
+{
+	Buffer* buf = nullptr;
+	size_t frame_size = PendingFrameSize();
+	try
+	{
+		if (frame_size > min_receive_size_)
+		{
+			// 큰 프레임은 조각을 매번 복사하지 않도록 read_buf_ 에 바로 받는다.
+			buf = read_buf_.get();
+			buf->DiscardReadBytes();
+			buf->EnsureWritable(std::max(frame_size - buf->ReadableBytes(), read_size));
+		}
+		else
+		{
+			// 공용 버퍼에 남은 조각을 먼저 붙이고 그 뒤에 받는다.
+			buf = &t_receive_scratch.buf;
+			buf->Clear();
+			size_t leftover = read_buf_ ? read_buf_->ReadableBytes() : 0;
+			buf->EnsureWritable(leftover + read_size);
+			if (leftover > 0)
+			{
+				buf->WriteBytes(read_buf_->Data() + read_buf_->ReaderIndex(), leftover);
+			}
+			UpdateReceiveMemory(t_receive_scratch.tracked, buf->Capacity());
+		}
+	}
+	catch (const std::exception& e)
+	{
+		BOOST_LOG_TRIVIAL(warning) << "Prepare read exception: " << e.what() << "\n";
+		_Close(CloseReason::ActiveClose);
+		return nullptr;
+	}
+
+	return buf;
+}
+
+inline bool Session::HandleSharedData(Buffer& buf, size_t bytes_transferred)
+{
+	// 버퍼의 WriterIndex 을 전송받은 데이터의 크기만큼 전진
+	buf.WriterIndex(buf.WriterIndex() + bytes_transferred);
+	NetMetrics::RecordRead(bytes_transferred);
+	if (idle_wheel_)
+		last_receive_tick_.store(idle_wheel_->Now(), std::memory_order_relaxed);
+
+	// 양보한 동안 도착한 데이터는 남겨 두었다가 ResumeReceive 에서 순서대로 처리한다.
+	if (receive_yielded_)
+	{
+		StashLeftover(buf);
+		return true;
+	}
+
+	size_t next_read_size = 0;
+	// 받은 데이타 처리
+	bool yielded = HandleReceiveData(buf, next_read_size);
+
+	// 처리하지 못한 조각만 남긴다.
+	StashLeftover(buf);
+	return yielded;
+}
+
+void Session::YieldReceive()
+{
+	if (receive_yielded_)
+		return;
+
+	receive_yielded_ = true;
+	Post([this, self = shared_from_this()]
+	{
+		ResumeReceive();
+	});
+}
+
+void Session::ResumeReceive()
+{
+	receive_yielded_ = false;
+	if (!IsOpen())
+		return;
+
+	// 남은 프레임은 read_buf_ 에 있다.
+	bool yielded = false;
+	if (read_buf_)
+	{
+		size_t next_read_size = 0;
+		yielded = HandleReceiveData(*read_buf_, next_read_size);
+		if (UsesSharedReceive())
+			StashLeftover(*read_buf_);
+	}
+
+	if (yielded)
+	{
+		YieldReceive();
+		return;
+	}
+
+	Read(min_receive_size_);
+}
+
+bool Session::AllowMessage(uint16_t message_type, TokenBucket::Clock::time_point now)
+{
+	// 타입별 비율은 헤더의 타입으로 찾으므로 타입을 알리지 않은 프레임(0)은 그 비율을 피해간다.
+	if (message_type == 0 && !type_buckets_.empty())
+	{
+		RejectMessage(message_type);
+		return false;
+	}
+
+	bool allowed = true;
+	for (auto& type_bucket : type_buckets_)
+	{
+		if (type_bucket.first == message_type)
+		{
+			allowed = type_bucket.second.Consume(now);
+			break;
+		}
+	}
+	// 타입 비율을 넘은 메시지는 세션 토큰을 쓰지 않는다.
+	if (allowed && message_bucket_.Consume(now))
+		return true;
+
+	RejectMessage(message_type);
+	return false;
+}
+
+void Session::RejectMessage(uint16_t message_type)
+{
+	AddStat(stats_rate_limited_messages_, 1);
+	NetMetrics::RecordRateLimited(message_type);
+	if (max_rate_violations_ > 0 && ++rate_violations_ >= max_rate_violations_)
+	{
+		BOOST_LOG_TRIVIAL(info) << "Too many rate limit violations. session id: " << id_;
+		_Close(CloseReason::RateLimited);
+	}
+}
+
+inline bool Session::UsesSharedReceive() const
+{
+#if defined(NET_HAS_IO_URING)
+	if (uring_)
+		return uring_->HasBufferGroup();
+#endif
+	return shared_receive_buffer_;
+}
+
+inline size_t Session::PendingFrameSize() const
+{
+	if (!read_buf_ || !read_buf_->IsReadable(sizeof(FrameHeader)))
+		return 0;
+
+	FrameHeader header{};
+	read_buf_->GetPOD(read_buf_->ReaderIndex(), header);
+	return sizeof(FrameHeader) + header.Length();
+}
+
+inline void Session::StashLeftover(Buffer& buf)
+{
+	size_t leftover = buf.ReadableBytes();
+	if (leftover == 0)
+	{
+		// 남은게 없으면 버퍼를 반환한다.
+		read_buf_.reset();
+	}
+	else if (&buf != read_buf_.get() || buf.Capacity() > leftover * 2)
+	{
+		// 조각 크기만큼만 새로 잡는다.
+		auto stash = std::make_shared<Buffer>(leftover, max_receive_buffer_size_);
+		stash->WriteBytes(buf.Data() + buf.ReaderIndex(), leftover);
+		read_buf_ = std::move(stash);
+	}
+
+	TrackReceiveMemory();
+}
+
+inline void Session::TrackReceiveMemory()
+{
+	UpdateReceiveMemory(receive_memory_, read_buf_ ? read_buf_->Capacity() : 0);
+}
+
 inline bool Session::PrepareRead(size_t min_prepare_bytes)
 {
-	//    ش.
+	// 읽을게 없으면 포지션을 리셋해준다.
 	if (read_buf_->ReadableBytes() == 0)
 	{
 		read_buf_->Clear();
@@ -150,14 +710,187 @@ inline bool Session::PrepareRead(size_t min_prepare_bytes)
 	return true;
 }
 
-inline void Session::PendWrite(const Ptr<Buffer>& buf)
+void Session::PendWrite(const Ptr<const SendBuffer>& buf)
 {
-	asio::dispatch(*strand_, [this, self = shared_from_this(), buf = buf]() mutable
+	Dispatch([this, self = shared_from_this(), buf = buf]() mutable
 	{
 		if (!IsOpen())
 			return;
 
+		buf = CompressFrame(buf);
 		pending_list_.emplace_back(buf);
+		pending_bytes_ += buf->Size();
+		// 큐에 넣은 뒤에 켜야 먼저 실행된 Flush 가 빈 큐를 보고 끄지 않는다.
+		unflushed_.store(true, std::memory_order_release);
+		if (!CheckSendBufferSize())
+			return;
+
+		if (sending_list_.empty() && ShouldWrite())
+		{
+			Write();
+		}
+		UpdateSendQueueStats();
+	});
+}
+
+void Session::PendWriteLatest(uint64_t key, const Ptr<const SendBuffer>& buf)
+{
+	Dispatch([this, self = shared_from_this(), key, buf = buf]() mutable
+	{
+		if (!IsOpen())
+			return;
+
+		buf = CompressFrame(buf);
+		size_t size = buf->Size();
+		auto iter = latest_index_.find(key);
+		if (iter != latest_index_.end())
+		{
+			// 아직 보내지 않은 이전 메시지를 교체한다.
+			// 새 메시지는 그 사이에 보낸 메시지 뒤에 가야 하므로 자리는 비워두고 끝에 넣는다.
+			auto& queued = pending_list_[iter->second];
+			pending_bytes_ -= queued->Size();
+			AddStat(stats_dropped_bytes_, queued->Size());
+			AddStat(stats_merged_messages_, 1);
+			queued.reset();
+			++superseded_count_;
+			iter->second = pending_list_.size();
+		}
+		else
+		{
+			latest_index_.emplace(key, pending_list_.size());
+		}
+		pending_list_.emplace_back(std::move(buf));
+		pending_bytes_ += size;
+		unflushed_.store(true, std::memory_order_release);
+		if (!CheckSendBufferSize())
+			return;
+
+		if (sending_list_.empty() && ShouldWrite())
+		{
+			Write();
+		}
+		UpdateSendQueueStats();
+	});
+}
+
+void Session::PendUnreliable(uint64_t key, const Ptr<const SendBuffer>& buf)
+{
+	// UDP 로 못 보내면 PendWriteLatest 가 큐에 넣고 Flush 대상으로 표시한다.
+	Dispatch([this, self = shared_from_this(), key, buf = buf]
+	{
+		if (!IsOpen())
+			return;
+
+		if (udp_bound_.load(std::memory_order_relaxed) &&
+			udp_channel_->SendFrame(udp_endpoint_, udp_token_.load(), ++udp_send_sequence_, key, *buf))
+		{
+			RecordSentMessage(buf->Header().message_type, sizeof(DatagramHeader) + buf->Size() - sizeof(FrameHeader));
+			return;
+		}
+
+		PendWriteLatest(key, buf);
+	});
+}
+
+inline bool Session::CheckSendBufferSize()
+{
+	size_t queued_bytes = pending_bytes_ + sending_bytes_;
+	if (queued_bytes <= max_send_buffer_size_)
+	{
+		send_overflow_start_time_ = {};
+		return true;
+	}
+
+	// 교체된 메시지는 이미 빠졌고 남은 메시지는 모두 받는 쪽에 필요하다.
+	// 잠깐 밀린 것은 기다려 주고 계속 넘거나 너무 많이 쌓이면 끊는다.
+	auto now = std::chrono::steady_clock::now();
+	if (send_overflow_start_time_ == std::chrono::steady_clock::time_point())
+		send_overflow_start_time_ = now;
+
+	bool hard_overflow = max_send_buffer_size_ <= std::numeric_limits<size_t>::max() / 2 && queued_bytes > max_send_buffer_size_ * 2;
+	if (!hard_overflow && now - send_overflow_start_time_ < send_overflow_timeout_)
+		return true;
+
+	BOOST_LOG_TRIVIAL(info) << "Send buffer overflow. session id: " << id_ << ", bytes: " << queued_bytes;
+	_Close(CloseReason::SendBufferOverflow);
+	return false;
+}
+
+inline void Session::UpdateSendQueueStats()
+{
+	size_t queued_messages = pending_list_.size() - superseded_count_;
+	size_t queued_bytes = pending_bytes_ + sending_bytes_;
+	stats_queued_messages_.store(queued_messages, std::memory_order_relaxed);
+	stats_queued_bytes_.store(queued_bytes, std::memory_order_relaxed);
+	if (queued_bytes > stats_send_queue_peak_bytes_.load(std::memory_order_relaxed))
+		stats_send_queue_peak_bytes_.store(queued_bytes, std::memory_order_relaxed);
+
+	NetMetrics::RecordSendQueue(queued_messages, queued_bytes);
+}
+
+inline void Session::RecordReceivedMessage(uint16_t message_type, size_t bytes)
+{
+	AddStat(stats_received_messages_, 1);
+	AddStat(stats_received_bytes_, bytes);
+	NetMetrics::RecordReceivedMessage(message_type, bytes);
+}
+
+inline void Session::RecordSentMessage(uint16_t message_type, size_t bytes)
+{
+	AddStat(stats_sent_messages_, 1);
+	AddStat(stats_sent_bytes_, bytes);
+	NetMetrics::RecordSentMessage(message_type, bytes);
+}
+
+SendQueueStats Session::GetSendQueueStats() const
+{
+	SendQueueStats stats;
+	stats.queued_messages = stats_queued_messages_.load(std::memory_order_relaxed);
+	stats.queued_bytes = stats_queued_bytes_.load(std::memory_order_relaxed);
+	stats.dropped_bytes = stats_dropped_bytes_.load(std::memory_order_relaxed);
+	stats.merged_messages = stats_merged_messages_.load(std::memory_order_relaxed);
+	return stats;
+}
+
+SessionStats Session::GetStats() const
+{
+	SessionStats stats;
+	stats.received_messages = stats_received_messages_.load(std::memory_order_relaxed);
+	stats.received_bytes = stats_received_bytes_.load(std::memory_order_relaxed);
+	stats.sent_messages = stats_sent_messages_.load(std::memory_order_relaxed);
+	stats.sent_bytes = stats_sent_bytes_.load(std::memory_order_relaxed);
+	stats.send_queue_peak_bytes = stats_send_queue_peak_bytes_.load(std::memory_order_relaxed);
+	stats.last_write_latency_us = stats_last_write_latency_us_.load(std::memory_order_relaxed);
+	stats.max_write_latency_us = stats_max_write_latency_us_.load(std::memory_order_relaxed);
+	stats.rate_limited_messages = stats_rate_limited_messages_.load(std::memory_order_relaxed);
+	return stats;
+}
+
+void Session::SetCorked(bool corked)
+{
+	Dispatch([this, self = shared_from_this(), corked]
+	{
+		corked_ = corked;
+		if (sending_list_.empty() && ShouldWrite())
+		{
+			Write();
+		}
+	});
+}
+
+void Session::Flush()
+{
+	// 세션마다 Dispatch 를 걸지 않도록 보낼게 있는 세션만 처리한다.
+	// 표시는 메시지를 큐에 넣은 뒤에 켜지므로 아직 큐에 들어가지 않은 메시지는 다음 Flush 에서 보낸다.
+	if (!unflushed_.exchange(false, std::memory_order_acq_rel))
+		return;
+
+	Dispatch([this, self = shared_from_this()]
+	{
+		if (!IsOpen() || pending_list_.empty())
+			return;
+
+		flush_requested_ = true;
 		if (sending_list_.empty())
 		{
 			Write();
@@ -165,6 +898,14 @@ inline void Session::PendWrite(const Ptr<Buffer>& buf)
 	});
 }
 
+inline bool Session::ShouldWrite() const
+{
+	if (pending_list_.empty())
+		return false;
+
+	return !corked_ || flush_requested_ || pending_bytes_ >= cork_threshold_;
+}
+
 inline void Session::Write()
 {
 	assert(sending_list_.empty());
@@ -175,29 +916,57 @@ inline void Session::Write()
 	if (pending_list_.empty())
 		return;
 
-	// TO DO : sending_list_.swap(pending_list_);
-
 	// Scatter-Gather I/O
-	std::vector<asio::const_buffer> bufs;
-	for (auto& buffer : pending_list_)
+	// 보낸 순서대로 보낸다. 교체되어 비워진 자리는 뺀다.
+	sending_list_.swap(pending_list_);
+	if (superseded_count_ > 0)
 	{
-		EncodeSendData(buffer);
-		bufs.emplace_back(const_buffer(*buffer));
-		sending_list_.emplace_back(std::move(buffer));
+		sending_list_.erase(std::remove(sending_list_.begin(), sending_list_.end(), nullptr), sending_list_.end());
+		superseded_count_ = 0;
 	}
-	pending_list_.clear();
+	latest_index_.clear();
 
-	boost::asio::async_write(*socket_, bufs, asio::bind_executor(*strand_,
-		[this, self = shared_from_this()](error_code const& ec, std::size_t)
-		{
-			HandleWrite(ec);
-		}));
+	// 버퍼 목록은 재사용한다. asio 에는 목록을 복사하지 않도록 span 으로 넘긴다.
+	write_buffers_.clear();
+	for (auto& buffer : sending_list_)
+	{
+		buffer->AppendTo(write_buffers_);
+	}
+	ConstBufferSpan bufs(write_buffers_.data(), write_buffers_.data() + write_buffers_.size());
+	sending_bytes_ = pending_bytes_;
+	pending_bytes_ = 0;
+	flush_requested_ = false;
+	UpdateSendQueueStats();
+	write_start_time_ = std::chrono::steady_clock::now();
+
+#if defined(NET_HAS_IO_URING)
+	if (uring_)
+	{
+		UringWrite();
+		return;
+	}
+#endif
+
+	auto handler = MakeAllocHandler(write_memory_, [this, self = shared_from_this()](error_code const& ec, std::size_t)
+	{
+		HandleWrite(ec);
+	});
+
+	if (strand_)
+		boost::asio::async_write(*socket_, bufs, asio::bind_executor(*strand_, std::move(handler)));
+	else
+		boost::asio::async_write(*socket_, bufs, std::move(handler));
 }
 
 inline void Session::HandleWrite(const error_code & error)
 {
 	if (!IsOpen())
+	{
+		sending_list_.clear();
+		sending_bytes_ = 0;
+		UpdateSendQueueStats();
 		return;
+	}
 
 	if (error)
 	{
@@ -206,16 +975,197 @@ inline void Session::HandleWrite(const error_code & error)
 		return;
 	}
 
+	// 받는 쪽이 느리면 소켓 버퍼가 차서 완료가 늦어진다.
+	auto latency = std::chrono::steady_clock::now() - write_start_time_;
+	uint64_t latency_us = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+	stats_last_write_latency_us_.store(latency_us, std::memory_order_relaxed);
+	MaxStat(stats_max_write_latency_us_, latency_us);
+	NetMetrics::RecordWrite(sending_bytes_, latency);
+
+	for (auto& buffer : sending_list_)
+	{
+		RecordSentMessage(buffer->Header().message_type, buffer->Size());
+	}
+
 	sending_list_.clear();
-	if (!pending_list_.empty())
+	sending_bytes_ = 0;
+	// 보내는 동안 쌓인 양이 계속 넘으면 여기서 끊는다.
+	if (!CheckSendBufferSize())
+		return;
+
+	if (ShouldWrite())
 	{
 		Write();
 	}
+	UpdateSendQueueStats();
+}
+
+#if defined(NET_HAS_IO_URING)
+inline void Session::UringRead(size_t min_read_bytes)
+{
+	int fd = socket_->native_handle();
+	if (uring_->HasBufferGroup())
+	{
+		// multishot 수신은 한번 제출하면 연결이 끊어지거나 커널에 맡긴 버퍼가 모자랄때까지 계속 완료된다.
+		if (uring_read_op_.IsPending())
+			return;
+
+		uring_read_op_.Hold(shared_from_this());
+		if (!uring_->ReceiveMultishot(fd, &uring_read_op_))
+		{
+			uring_read_op_.Release();
+			_Close(CloseReason::ActiveClose);
+		}
+		return;
+	}
+
+	if (!PrepareRead(min_read_bytes))
+	{
+		_Close(CloseReason::ActiveClose);
+		return;
+	}
+	TrackReceiveMemory();
+
+	uring_read_op_.Hold(shared_from_this());
+	if (!uring_->Receive(fd, read_buf_->Data() + read_buf_->WriterIndex(), read_buf_->WritableBytes(), &uring_read_op_))
+	{
+		uring_read_op_.Release();
+		_Close(CloseReason::ActiveClose);
+	}
+}
+
+void Session::HandleUringRead(int result, uint32_t flags)
+{
+	error_code error;
+	if (result == 0)
+		error = asio::error::eof;
+	else if (result < 0)
+		error = error_code(-result, boost::system::system_category());
+
+	const uint8_t* data = uring_->GetBuffer(flags);
+	if (data == nullptr)
+	{
+		if (error == asio::error::no_buffer_space)
+		{
+			// 커널에 맡긴 버퍼를 모두 사용중이다. 다른 세션들이 버퍼를 돌려준 뒤에 다시 제출한다.
+			Post([this, self = shared_from_this()]
+			{
+				if (!receive_yielded_)
+					Read(min_receive_size_);
+			});
+			return;
+		}
+
+		if (error == asio::error::operation_aborted && uring_->HasBufferGroup())
+		{
+			// 양보하면서 취소한 multishot 수신. 취소가 끝나기 전에 ResumeReceive 했으면 여기서 다시 제출한다.
+			if (IsOpen() && !receive_yielded_)
+				Read(min_receive_size_);
+			return;
+		}
+
+		// read_buf_ 에 바로 받았거나 실패했다.
+		HandleRead(error, error ? 0 : static_cast<size_t>(result));
+		return;
+	}
+
+	if (!IsOpen() || error)
+	{
+		uring_->ReleaseBuffer(flags);
+		if (IsOpen())
+			HandleReadError(error);
+		return;
+	}
+
+	// 수신 버퍼는 바로 돌려주고 처리하지 못한 조각만 세션에 남긴다.
+	size_t bytes_transferred = static_cast<size_t>(result);
+	Buffer* buf = PrepareSharedBuffer(bytes_transferred);
+	if (buf == nullptr)
+	{
+		uring_->ReleaseBuffer(flags);
+		return;
+	}
+	std::memcpy(buf->Data() + buf->WriterIndex(), data, bytes_transferred);
+	uring_->ReleaseBuffer(flags);
+
+	if (HandleSharedData(*buf, bytes_transferred))
+	{
+		// multishot 수신은 양보하는 동안에도 완료되어 남긴 조각이 계속 늘어나므로 취소한다.
+		// ResumeReceive 가 다시 제출한다.
+		if (IoUring::HasMore(flags) && !receive_yielded_)
+			uring_->Cancel(&uring_read_op_);
+		YieldReceive();
+		return;
+	}
+
+	if (!IoUring::HasMore(flags) && !receive_yielded_)
+		Read(min_receive_size_);
+}
+
+inline void Session::UringWrite()
+{
+	uring_write_iov_.clear();
+	for (auto& buffer : write_buffers_)
+	{
+		uring_write_iov_.push_back({ const_cast<void*>(buffer.data()), buffer.size() });
+	}
+	uring_write_index_ = 0;
+
+	SubmitUringWrite();
 }
 
+inline void Session::SubmitUringWrite()
+{
+	// 한번에 보낼수 있는 조각 수는 IOV_MAX 로 제한된다.
+	std::memset(&uring_write_message_, 0, sizeof(uring_write_message_));
+	uring_write_message_.msg_iov = uring_write_iov_.data() + uring_write_index_;
+	uring_write_message_.msg_iovlen = std::min<size_t>(uring_write_iov_.size() - uring_write_index_, IOV_MAX);
+
+	uring_write_op_.Hold(shared_from_this());
+	if (!uring_->SendMessage(socket_->native_handle(), &uring_write_message_, &uring_write_op_))
+	{
+		uring_write_op_.Release();
+		HandleWrite(asio::error::no_buffer_space);
+	}
+}
+
+void Session::HandleUringWrite(int result, uint32_t /*flags*/)
+{
+	if (result < 0)
+	{
+		HandleWrite(error_code(-result, boost::system::system_category()));
+		return;
+	}
+
+	// 보낸 만큼 조각을 넘기고 남은 조각이 있으면 이어서 보낸다.
+	size_t sent = static_cast<size_t>(result);
+	while (uring_write_index_ < uring_write_iov_.size())
+	{
+		iovec& iov = uring_write_iov_[uring_write_index_];
+		if (sent < iov.iov_len)
+		{
+			iov.iov_base = static_cast<uint8_t*>(iov.iov_base) + sent;
+			iov.iov_len -= sent;
+			break;
+		}
+
+		sent -= iov.iov_len;
+		uring_write_index_++;
+	}
+
+	if (uring_write_index_ < uring_write_iov_.size() && IsOpen())
+	{
+		SubmitUringWrite();
+		return;
+	}
+
+	HandleWrite(error_code());
+}
+#endif
+
 void Session::HandleError(const error_code & error)
 {
-	//   ̴.
+	// 상대방이 연결을 끊은것이다.
 	if (error == boost::asio::error::eof || error == boost::asio::error::operation_aborted)
 	{
 		return;
@@ -233,9 +1183,36 @@ void Session::_Close(CloseReason reason)
 	socket_->shutdown(tcp::socket::shutdown_both, ec);
 	socket_->close();
 	state_ = State::Closed;
+	udp_bound_ = false;
+
+	if (idle_wheel_)
+		idle_wheel_->Cancel(this);
+
+	// 수신 처리 도중에 닫혔을수 있으므로 버퍼는 지금 핸들러가 끝난 뒤에 돌려준다.
+	Post([this, self = shared_from_this()]
+	{
+		ReleaseBuffers();
+	});
 
 	if (close_handler)
 		close_handler(shared_from_this(), reason);
 }
 
+void Session::ReleaseBuffers()
+{
+	pending_list_.clear();
+	superseded_count_ = 0;
+	latest_index_.clear();
+	pending_bytes_ = 0;
+	UpdateSendQueueStats();
+
+#if defined(NET_HAS_IO_URING)
+	// 커널이 아직 read_buf_ 에 받고 있을수 있다.
+	if (uring_ && uring_read_op_.IsPending() && !uring_->HasBufferGroup())
+		return;
+#endif
+	read_buf_.reset();
+	TrackReceiveMemory();
+}
+
 } // namespace net
\ No newline at end of file
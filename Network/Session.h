@@ -1,19 +1,66 @@
 #pragma once
 
+#include <algorithm>
+#include <unordered_map>
 #include "Types.h"
 #include "ByteBuffer.h"
+#include "SendBuffer.h"
 #include "Config.h"
 #include "AsioHelper.h"
+#include "TimerWheel.h"
+#include "UdpChannel.h"
+#include "NetMetrics.h"
+#include "ThreadStats.h"
+#include "IoUring.h"
+#include "TokenBucket.h"
 
 namespace net {
 
 	enum class CloseReason {
-		ActiveClose = 0,	//   .
-		Disconnected,		// Ŭ̾Ʈ  .
-		Timeout				//
+		ActiveClose = 0,	// 서버에서 연결을 끊음.
+		Disconnected,		// 클라이언트에서 연결이 끊김.
+		Timeout,			// idle_timeout 동안 받은 데이터가 없음.
+		SendBufferOverflow,	// 보낼 데이터가 max_send_buffer_size 를 넘음.
+		RateLimited			// 메시지 비율 제한 위반이 max_rate_violations 에 이름.
 	};
 
-	class Session : public std::enable_shared_from_this<Session>
+	// 메시지를 보낼 채널.
+	enum class Channel {
+		Reliable = 0,		// TCP. 모든 메시지를 순서대로 전달한다.
+		Latest,				// TCP. 같은 key 로 보내지 않은 메시지가 있으면 교체한다.
+		Unreliable			// UDP. 잃어버리거나 늦게 도착한 메시지는 버린다. UDP 가 없으면 Latest 로 보낸다.
+	};
+
+	// 수신 버퍼가 사용하는 메모리. 프로세스 전체의 합계.
+	struct ReceiveMemoryStats
+	{
+		size_t current_bytes = 0;	// 현재 사용량.
+		size_t peak_bytes = 0;		// 최대 사용량.
+	};
+
+	// 세션의 송신 큐 상태.
+	struct SendQueueStats
+	{
+		size_t queued_messages = 0;	// 보내지 않은 메시지 수.
+		size_t queued_bytes = 0;	// 보내지 않았거나 전송중인 바이트.
+		uint64_t dropped_bytes = 0;	// 교체되거나 버려진 바이트.
+		uint64_t merged_messages = 0;	// 같은 key 의 새 메시지로 교체된 수.
+	};
+
+	// 세션의 송수신 통계. 바이트는 헤더를 포함해 실제로 오간 크기.
+	struct SessionStats
+	{
+		uint64_t received_messages = 0;
+		uint64_t received_bytes = 0;
+		uint64_t sent_messages = 0;
+		uint64_t sent_bytes = 0;
+		size_t send_queue_peak_bytes = 0;	// 송신 큐가 가장 컸을때의 크기.
+		uint64_t last_write_latency_us = 0;	// 마지막 async_write 의 시작부터 완료까지.
+		uint64_t max_write_latency_us = 0;
+		uint64_t rate_limited_messages = 0;	// 비율 제한을 넘어서 버린 메시지.
+	};
+
+	class Session : public std::enable_shared_from_this<Session>, public TimerWheel::Entry
 	{
 	public:
 		DECLARE_CLASS_PTR(Session)
@@ -24,7 +71,9 @@ namespace net {
 		Session(const Session&) = delete;
 		Session& operator=(const Session&) = delete;
 
-		Session(asio::io_context& io_context, int id, const ServerConfig& config);
+		// use_strand 가 false 이면 핸들러를 strand 없이 io_context 에서 바로 실행한다.
+		// io_context 를 하나의 스레드만 실행할 때만 사용해야 한다.
+		Session(asio::io_context& io_context, int id, const ServerConfig& config, bool use_strand = true);
 
 		virtual ~Session();
 
@@ -34,45 +83,154 @@ namespace net {
 
 		bool IsOpen() const;
 
-		//  Ѵ.
+		// 세션을 시작한다.
 		virtual void Start();
 
 		virtual void Close();
 
 		virtual void Send(const uint8_t * data, size_t size)
 		{
-			auto buffer = std::make_shared<Buffer>(size);
-			buffer->WriteBytes(data, size);
-
-			Send(std::move(buffer));
+			Send(ByteSendBuffer::Create(data, size));
 		}
 
 		virtual void Send(const Buffer& data)
 		{
-			Send(std::make_shared<Buffer>(data));
+			Send(ByteSendBuffer::Create(data.Data() + data.ReaderIndex(), data.ReadableBytes()));
 		}
 
 		virtual void Send(Buffer&& data)
 		{
-			Send(std::make_shared<Buffer>(std::move(data)));
+			Send(ByteSendBuffer::Create(std::move(data)));
 		}
 
+		// 버퍼를 복사하지 않고 참조해서 보낸다. 보낸 뒤에는 버퍼를 바꾸면 안된다.
 		virtual void Send(Ptr<Buffer> data)
+		{
+			Send(SharedByteSendBuffer::Create(std::move(data)));
+		}
+
+		// 헤더가 인코딩된 버퍼를 복사 없이 전송 큐에 넣는다.
+		virtual void Send(Ptr<const SendBuffer> data)
 		{
 			if (!IsOpen()) return;
 
 			PendWrite(data);
 		}
 
+		// 같은 key 로 아직 보내지 않은 메시지가 있으면 새 메시지로 교체한다.
+		// 위치 갱신처럼 마지막 값만 의미있는 메시지에 사용한다.
+		// 다른 메시지와 보낸 순서를 지킨다. 교체한 메시지는 새로 보낸 위치로 옮겨진다.
+		virtual void SendLatest(uint64_t key, Ptr<const SendBuffer> data)
+		{
+			if (!IsOpen()) return;
+
+			PendWriteLatest(key, data);
+		}
+
+		// 바인드된 UDP 채널로 보낸다. 받는 쪽은 같은 key 의 이전 sequence 메시지를 버린다.
+		// 한 세그먼트 유실이 뒤의 위치 갱신을 모두 막는 TCP 의 head-of-line blocking 을 피한다.
+		// UDP 가 바인드되지 않았거나 데이터그램 크기를 넘으면 SendLatest 로 보낸다.
+		virtual void SendUnreliable(uint64_t key, Ptr<const SendBuffer> data)
+		{
+			if (!IsOpen()) return;
+
+			PendUnreliable(key, data);
+		}
+
+		// channel 에 맞는 Send 함수로 보낸다. Reliable 이면 key 는 사용하지 않는다.
+		void Send(Channel channel, uint64_t key, Ptr<const SendBuffer> data)
+		{
+			switch (channel)
+			{
+			case Channel::Latest:
+				SendLatest(key, std::move(data));
+				break;
+			case Channel::Unreliable:
+				SendUnreliable(key, std::move(data));
+				break;
+			default:
+				Send(std::move(data));
+				break;
+			}
+		}
+
+		// 클라이언트가 UDP 채널을 바인드 했는지.
+		bool IsUdpBound() const
+		{
+			return udp_bound_.load(std::memory_order_acquire);
+		}
+
+		SendQueueStats GetSendQueueStats() const;
+		SessionStats GetStats() const;
+
+		// cork 상태에서는 Send 한 메시지를 모아 두었다가 Flush 하거나 cork_threshold 를 넘으면 한번에 보낸다.
+		void SetCorked(bool corked);
+		// 모아둔 메시지를 바로 보낸다. 지난 Flush 이후 큐에 들어간 메시지가 없으면 아무것도 하지 않는다.
+		void Flush();
+
+		// 처리할수 없는 메시지를 받았다. 모르는 타입이나 헤더와 payload 의 타입이 다른 메시지.
+		// 비율 제한 위반으로 세고 max_rate_violations 에 이르면 닫는다. 수신 핸들러 안에서 호출한다.
+		void RejectMessage(uint16_t message_type);
+
 		tcp::socket& GetSocket() { return *socket_; }
 
-		strand& GetStrand() { return *strand_; }
+		static ReceiveMemoryStats GetReceiveMemoryStats();
+
+		// 세션의 핸들러와 같은 문맥에서 직렬화 실행한다.
+		template <typename Handler>
+		void Dispatch(Handler&& handler)
+		{
+			if (strand_)
+				asio::dispatch(*strand_, std::forward<Handler>(handler));
+			else
+				asio::dispatch(socket_->get_executor(), std::forward<Handler>(handler));
+		}
+
+		template <typename Handler>
+		void Post(Handler&& handler)
+		{
+			if (strand_)
+				asio::post(*strand_, std::forward<Handler>(handler));
+			else
+				asio::post(socket_->get_executor(), std::forward<Handler>(handler));
+		}
 
 		std::function<void(const Ptr<Session>&)> open_handler;
 		std::function<void(const Ptr<Session>&, CloseReason reason)> close_handler;
-		std::function<void(const Ptr<Session>&, uint8_t*, size_t)> recv_handler;
+		std::function<void(const Ptr<Session>&, uint16_t/*message_type*/, uint8_t*, size_t)> recv_handler;
 
 	private:
+		friend class NetServer;
+
+		// NetServer 가 닫힌 세션 객체를 새 연결에 재사용할때 호출한다. 소켓은 호출한 쪽에서 교체한다.
+		void Reset(asio::io_context& io_context, int id, bool use_strand);
+
+		// 세션이 열리면 idle_wheel 에 예약한다. 받은 데이터 없이 timeout_ticks 가 지나면 닫힌다.
+		void SetIdleWheel(TimerWheel* idle_wheel, uint64_t timeout_ticks);
+		// idle_wheel 에서 만료되었을때 호출된다. 닫아야 하면 0, 아니면 남은 틱을 리턴한다.
+		uint64_t CheckIdle(uint64_t now) const;
+		void CloseByTimeout();
+
+		// 세션을 시작하기 전에 NetServer 가 UDP 채널과 token 을 정한다. 열리면 token 을 클라이언트에 보낸다.
+		void SetUdpChannel(const Ptr<UdpChannel>& udp_channel, uint64_t token);
+		uint64_t GetUdpToken() const
+		{
+			return udp_token_.load(std::memory_order_relaxed);
+		}
+		// NetServer 의 UDP 채널이 받은 데이터그램. token 은 확인된 상태다.
+		void HandleDatagram(const DatagramHeader& header, const asio::ip::udp::endpoint& endpoint, const uint8_t* payload, size_t size);
+		void SendUdpToken();
+
+#if defined(NET_HAS_IO_URING)
+		// 세션을 시작하기 전에 NetServer 가 io_context 의 링을 정한다. 설정되면 asio 대신 링으로 읽고 쓴다.
+		void SetIoUring(const Ptr<IoUring>& uring);
+		void UringRead(size_t min_read_bytes);
+		void HandleUringRead(int result, uint32_t flags);
+		void UringWrite();
+		void SubmitUringWrite();
+		void HandleUringWrite(int result, uint32_t flags);
+#endif
+
 		enum class State
 		{
 			Ready,
@@ -80,85 +238,242 @@ namespace net {
 			Closed
 		};
 
-		struct Header
-		{
-			int32_t payload_len;
-		};
-
 		void Read(size_t min_read_bytes);
 		void HandleRead(const error_code & error, std::size_t bytes_transferred);
 		bool PrepareRead(size_t min_prepare_bytes);
+		void HandleReadError(const error_code & error);
+
+		// shared_receive_buffer 모드.
+		// 소켓이 읽을수 있게 되면 스레드 공용 버퍼로 읽고, 처리하지 못한 프레임 조각만 read_buf_ 에 남긴다.
+		void HandleReadable(const error_code & error);
+		// 남은 조각 뒤에 read_size 이상 받을수 있는 버퍼. 실패하면 세션을 닫고 nullptr.
+		Buffer* PrepareSharedBuffer(size_t read_size);
+		// buf 에 받은 bytes 를 처리하고 남은 조각을 보관한다.
+		// 프레임 예산을 다 써서 멈췄으면 true.
+		bool HandleSharedData(Buffer& buf, size_t bytes_transferred);
+		// 수신 버퍼를 세션이 가지지 않고 프레임 조각만 보관하는지.
+		bool UsesSharedReceive() const;
+		// read_buf_ 에 남은 조각의 프레임 전체 크기. 헤더를 아직 받지 못했으면 0.
+		size_t PendingFrameSize() const;
+		void StashLeftover(Buffer& buf);
+		void TrackReceiveMemory();
+		// 프레임 예산을 다 쓰면 남은 프레임은 다른 핸들러가 실행된 뒤에 이어서 처리한다. 그동안 읽지 않는다.
+		void YieldReceive();
+		void ResumeReceive();
+		// 비율 제한을 넘었으면 위반을 세고 false. 위반이 max_rate_violations 에 이르면 세션을 닫는다.
+		bool AllowMessage(uint16_t message_type, TokenBucket::Clock::time_point now);
 
 		// Parse Message
-		void HandleReceiveData(Buffer& read_buf, size_t& next_read_size)
+		// 프레임 예산을 다 써서 멈췄으면 true.
+		bool HandleReceiveData(Buffer& read_buf, size_t& next_read_size)
 		{
-			DecodeRecvData(read_buf, next_read_size);
+			return DecodeRecvData(read_buf, next_read_size);
 		}
 
-		void PendWrite(const Ptr<Buffer>& buf);
+		void PendWrite(const Ptr<const SendBuffer>& buf);
+		void PendWriteLatest(uint64_t key, const Ptr<const SendBuffer>& buf);
+		void PendUnreliable(uint64_t key, const Ptr<const SendBuffer>& buf);
+		// 큐 크기가 max_send_buffer_size 를 send_overflow_timeout 동안 넘거나 두배를 넘으면 연결을 끊는다.
+		bool CheckSendBufferSize();
+		void UpdateSendQueueStats();
+		void RecordReceivedMessage(uint16_t message_type, size_t bytes);
+		void RecordSentMessage(uint16_t message_type, size_t bytes);
+		// 지금 Write 를 시작해야 하는지. cork 상태면 Flush 요청이 있거나 cork_threshold 를 넘었을 때.
+		bool ShouldWrite() const;
 		void Write();
 		void HandleWrite(const error_code& error);
 		void HandleError(const error_code& error);
+		// 닫힌 세션의 보내지 못한 메시지와 수신 버퍼를 돌려준다. 진행중인 읽기/쓰기의 버퍼는 완료 핸들러에서 돌려준다.
+		void ReleaseBuffers();
 		void _Close(CloseReason reason);
 
-		void EncodeSendData(Ptr<Buffer>& data)
+		bool DecodeRecvData(Buffer& buf, size_t&)
 		{
-			// Make Header
-			Header header;
-			header.payload_len = (int32_t)data->ReadableBytes();
-
-			// To Do : ȣȭ  ..
-
-			data->InsertBytes(data->ReaderIndex(), reinterpret_cast<uint8_t*>(&header.payload_len), 0, sizeof(header.payload_len));
-			data->WriterIndex(data->WriterIndex() + sizeof(header.payload_len));
-		}
-
-		void DecodeRecvData(Buffer& buf, size_t&)
-		{
-			Header header = { 0 };
-			// ó Ͱ  ݺ
+			FrameHeader header{};
+			size_t frames = 0;
+			// 한번에 받은 프레임들은 같은 시각으로 비율을 검사한다.
+			TokenBucket::Clock::time_point now;
+			if (rate_limited_)
+				now = TokenBucket::Clock::now();
+			// 처리할 데이터가 있으면 반복
 			while (buf.IsReadable())
 			{
 				// Decode Header
-				//   ŭ   
-				if (!buf.IsReadable(sizeof(Header)))
-					return;
+				// 헤더 사이즈 만큼 받지 못했으면 리턴
+				if (!buf.IsReadable(sizeof(FrameHeader)))
+					return false;
 
-				// TO DO :  ?
-				buf.GetPOD(buf.ReaderIndex(), header.payload_len);
+				// TO DO : 헤더 검증?
+				buf.GetPOD(buf.ReaderIndex(), header);
+				size_t payload_len = header.Length();
 
 				// Decode Body
-				// Header + Body  ŭ   
-				if (!buf.IsReadable(sizeof(Header) + header.payload_len))
-					return;
-
-				//  ŭ 
-				buf.SkipBytes(sizeof(Header));
-				// TO DO : ȣȭ?
+				// Header + Body 사이즈 만큼 받지 못했으면 리턴
+				if (!buf.IsReadable(sizeof(FrameHeader) + payload_len))
+					return false;
+
+				// 예산을 다 썼으면 남은 프레임은 이벤트 루프에 양보한 뒤에 처리한다.
+				if (max_frames_per_read_ > 0 && frames >= max_frames_per_read_)
+					return true;
+				frames++;
+
+				// 헤더 사이즈만큼 전진
+				buf.SkipBytes(sizeof(FrameHeader));
+				// TO DO : 복호화?
+
+				// payload 가 없는 프레임은 연결 유지용이다.
+				if (payload_len == 0)
+					continue;
+
+				// 클라이언트가 보내는 제어 메시지는 없다.
+				if (header.IsControl())
+				{
+					buf.SkipBytes(payload_len);
+					continue;
+				}
+
+				RecordReceivedMessage(header.message_type, sizeof(FrameHeader) + payload_len);
+
+				// 비율을 넘은 메시지는 압축을 풀지 않고 버린다.
+				if (rate_limited_ && !AllowMessage(header.message_type, now))
+				{
+					if (!IsOpen())
+						return false;
+					buf.SkipBytes(payload_len);
+					continue;
+				}
+
+				uint8_t* payload = buf.Data() + buf.ReaderIndex();
+				size_t payload_size = payload_len;
+				// 압축된 payload 는 풀어서 넘긴다.
+				if (header.IsCompressed())
+				{
+					payload = Compressor::DecompressPayload(payload, payload_len, max_decompressed_size_, payload_size);
+					if (payload == nullptr)
+					{
+						BOOST_LOG_TRIVIAL(info) << "Invalid compressed frame. session id: " << id_;
+						_Close(CloseReason::ActiveClose);
+						return false;
+					}
+				}
 
 				// Call receive handler
 				if (recv_handler)
-					recv_handler(shared_from_this(), buf.Data() + buf.ReaderIndex(), header.payload_len);
+					recv_handler(shared_from_this(), header.message_type, payload, payload_size);
 
-				// ٵ ŭ 
-				buf.SkipBytes(header.payload_len);
+				// 바디 사이즈만큼 전진
+				buf.SkipBytes(payload_len);
+				// 핸들러가 RejectMessage 로 닫았으면 남은 프레임은 처리하지 않는다.
+				if (!IsOpen())
+					return false;
 			}
+			return false;
+		}
+
+		// compress_threshold 보다 큰 프레임은 압축한 프레임으로 바꾼다.
+		Ptr<const SendBuffer> CompressFrame(const Ptr<const SendBuffer>& buf) const
+		{
+			if (compress_threshold_ == 0 || buf->Size() < sizeof(FrameHeader) + compress_threshold_)
+				return buf;
+
+			auto compressed = buf->Compressed();
+			return compressed ? compressed : buf;
 		}
 
 		std::unique_ptr<tcp::socket> socket_;
+		// io_context 를 여러 스레드가 실행할 때만 사용한다.
 		std::unique_ptr<strand> strand_;
 
 		int  id_;
 		State state_;
 
+		TimerWheel* idle_wheel_ = nullptr;
+		uint64_t idle_timeout_ticks_ = 0;
+		// 마지막으로 데이터를 받은 idle_wheel_ 의 틱. 읽을때 마다 갱신만 하고 휠은 만료될때 다시 예약한다.
+		std::atomic<uint64_t> last_receive_tick_{ 0 };
+
 		Ptr<Buffer> read_buf_;
-		std::vector<Ptr<Buffer>> pending_list_;
-		std::vector<Ptr<Buffer>> sending_list_;
+		// 수신 메모리 통계에 반영된 read_buf_ 의 크기.
+		size_t receive_memory_ = 0;
+		// 보낼 메시지. SendLatest 로 교체된 자리는 nullptr 로 남기고 Write 할때 뺀다.
+		std::vector<Ptr<const SendBuffer>> pending_list_;
+		size_t superseded_count_ = 0;
+		std::vector<Ptr<const SendBuffer>> sending_list_;
+		// sending_list_ 의 메모리 조각. Write 마다 재사용한다.
+		std::vector<asio::const_buffer> write_buffers_;
+		// 읽기/쓰기 완료 핸들러가 재사용하는 메모리.
+		HandlerMemory read_memory_;
+		HandlerMemory write_memory_;
+		// SendLatest 로 보낸 메시지의 pending_list_ 위치. key 마다 하나만 남는다.
+		std::unordered_map<uint64_t, size_t> latest_index_;
+		// 큐가 max_send_buffer_size 를 넘은 시간. 넘지 않았으면 기본값.
+		std::chrono::steady_clock::time_point send_overflow_start_time_;
+		size_t pending_bytes_ = 0;
+		size_t sending_bytes_ = 0;
+		bool cork_ = false;		// 설정값
+		bool corked_ = false;
+		bool flush_requested_ = false;
+		// Flush 할 메시지가 있는지. 세션 문맥에서 큐에 넣은 뒤에 켜고 Flush 에서 끈다.
+		std::atomic<bool> unflushed_{ false };
+
+		// 다른 스레드에서 읽는 송신 큐 통계.
+		std::atomic<size_t> stats_queued_messages_{ 0 };
+		std::atomic<size_t> stats_queued_bytes_{ 0 };
+		StatCounter stats_dropped_bytes_{ 0 };
+		StatCounter stats_merged_messages_{ 0 };
+		// 다른 스레드에서 읽는 송수신 통계. 세션 문맥에서만 쓰므로 AddStat 으로 더한다.
+		StatCounter stats_received_messages_{ 0 };
+		StatCounter stats_received_bytes_{ 0 };
+		StatCounter stats_sent_messages_{ 0 };
+		StatCounter stats_sent_bytes_{ 0 };
+		std::atomic<size_t> stats_send_queue_peak_bytes_{ 0 };
+		StatCounter stats_last_write_latency_us_{ 0 };
+		StatCounter stats_max_write_latency_us_{ 0 };
+		StatCounter stats_rate_limited_messages_{ 0 };
+		// 남은 프레임을 이어서 처리하는 핸들러가 예약되어 있는지.
+		bool receive_yielded_ = false;
+		// 연결마다 새로 채운다. type_buckets_ 는 message_type_rate_limits_ 와 같은 순서.
+		TokenBucket message_bucket_;
+		std::vector<std::pair<uint16_t, TokenBucket>> type_buckets_;
+		size_t rate_violations_ = 0;
+		// 진행중인 async_write 를 시작한 시간.
+		std::chrono::steady_clock::time_point write_start_time_;
+
+		// UDP 채널. NetServer 의 모든 세션이 공유한다.
+		Ptr<UdpChannel> udp_channel_;
+		std::atomic<uint64_t> udp_token_{ 0 };
+		std::atomic<bool> udp_bound_{ false };
+		// 아래는 세션 문맥에서만 사용한다.
+		asio::ip::udp::endpoint udp_endpoint_;
+		uint32_t udp_send_sequence_ = 0;
+		SequenceFilter udp_receive_filter_;
+
+#if defined(NET_HAS_IO_URING)
+		Ptr<IoUring> uring_;
+		IoUringMemberOperation<Session> uring_read_op_{ this, &Session::HandleUringRead };
+		IoUringMemberOperation<Session> uring_write_op_{ this, &Session::HandleUringWrite };
+		// 진행중인 sendmsg 의 메모리 조각. 일부만 보내면 남은 조각부터 다시 보낸다.
+		std::vector<iovec> uring_write_iov_;
+		size_t uring_write_index_ = 0;
+		msghdr uring_write_message_;
+#endif
 
 		// config
 		bool	no_delay_ = false;
 		size_t	min_receive_size_;
 		size_t	max_receive_buffer_size_;
+		bool	shared_receive_buffer_ = false;
+		size_t	cork_threshold_;
+		size_t	max_send_buffer_size_;
+		std::chrono::milliseconds	send_overflow_timeout_;
+		size_t	compress_threshold_;
+		size_t	max_decompressed_size_;
+		size_t	max_frames_per_read_;
+		RateLimit	message_rate_limit_;
+		std::vector<std::pair<uint16_t, RateLimit>> message_type_rate_limits_;
+		size_t	max_rate_violations_;
+		std::vector<uint16_t>	udp_message_types_;
+		bool	rate_limited_ = false;	// 비율 제한이 하나라도 있는지.
 	};
 
 } // namespace net
\ No newline at end of file
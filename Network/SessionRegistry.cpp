@@ -0,0 +1,150 @@
+#include "SessionRegistry.h"
+
+namespace net {
+
+SessionRegistry::SessionRegistry(size_t capacity)
+	: slots_(std::max<size_t>(capacity, 1))
+	, recycle_bin_(std::make_shared<RecycleBin>(slots_.size()))
+	, free_next_(std::make_unique<std::atomic<uint32_t>[]>(slots_.size()))
+{
+	// index 에 필요한 bit 수. 나머지 bit 는 generation 에 사용한다.
+	index_bits_ = 1;
+	while ((size_t(1) << index_bits_) < slots_.size())
+	{
+		index_bits_++;
+	}
+	if (index_bits_ > 24)
+	{
+		throw std::invalid_argument("SessionRegistry capacity is too large");
+	}
+	index_mask_ = (size_t(1) << index_bits_) - 1;
+	max_generation_ = (1 << (31 - index_bits_)) - 1;
+
+	// 앞 번호의 슬롯부터 사용하도록 뒤에서 부터 넣는다.
+	for (size_t i = slots_.size(); i > 0; i--)
+	{
+		PushFree(i - 1);
+	}
+}
+
+bool SessionRegistry::Acquire(int& id)
+{
+	size_t index = 0;
+	if (!PopFree(index))
+		return false;
+
+	Slot& slot = slots_[index];
+	slot.generation = (slot.generation >= max_generation_) ? 1 : slot.generation + 1;
+	id = (slot.generation << index_bits_) | static_cast<int>(index);
+	return true;
+}
+
+void SessionRegistry::Release(int id)
+{
+	size_t index = Index(id);
+	if (index >= slots_.size())
+		return;
+
+	int expected = id;
+	// 이미 반환된 id 면 무시한다.
+	if (!slots_[index].id.compare_exchange_strong(expected, 0))
+		return;
+
+	// 슬롯이 참조를 들고 있으면 객체가 돌아오지 않는다.
+	std::atomic_store(&slots_[index].session, Ptr<Session>());
+	PushFree(index);
+}
+
+void SessionRegistry::Set(int id, const Ptr<Session>& session)
+{
+	Slot& slot = slots_[Index(id)];
+	std::atomic_store(&slot.session, session);
+	slot.id.store(id);
+}
+
+Ptr<Session> SessionRegistry::Find(int id) const
+{
+	size_t index = Index(id);
+	if (id <= 0 || index >= slots_.size())
+		return nullptr;
+
+	const Slot& slot = slots_[index];
+	if (slot.id.load() != id)
+		return nullptr;
+
+	auto session = std::atomic_load(&slot.session);
+	// 읽는 도중에 슬롯이 반환되었을수 있다.
+	if (slot.id.load() != id)
+		return nullptr;
+
+	return session;
+}
+
+Ptr<Session> SessionRegistry::MakeRecyclable(int id, std::unique_ptr<Session> session)
+{
+	return Ptr<Session>(session.release(), Recycler{ recycle_bin_, Index(id) });
+}
+
+Ptr<Session> SessionRegistry::TakeRecyclable(int id)
+{
+	size_t index = Index(id);
+	Session* session = recycle_bin_->Take(index);
+	if (session == nullptr)
+		return nullptr;
+
+	return Ptr<Session>(session, Recycler{ recycle_bin_, index });
+}
+
+SessionRegistry::RecycleBin::RecycleBin(size_t size)
+	: sessions(std::make_unique<std::atomic<Session*>[]>(size))
+	, size(size)
+{
+}
+
+SessionRegistry::RecycleBin::~RecycleBin()
+{
+	for (size_t i = 0; i < size; i++)
+	{
+		delete sessions[i].load();
+	}
+}
+
+void SessionRegistry::RecycleBin::Put(size_t index, Session* session)
+{
+	delete sessions[index].exchange(session, std::memory_order_acq_rel);
+}
+
+Session* SessionRegistry::RecycleBin::Take(size_t index)
+{
+	return sessions[index].exchange(nullptr, std::memory_order_acq_rel);
+}
+
+void SessionRegistry::PushFree(size_t index)
+{
+	uint64_t head = free_head_.load();
+	uint64_t new_head = 0;
+	do
+	{
+		free_next_[index].store(static_cast<uint32_t>(head & INDEX_MASK));
+		new_head = (((head >> 32) + 1) << 32) | (index + 1);
+	} while (!free_head_.compare_exchange_weak(head, new_head));
+}
+
+bool SessionRegistry::PopFree(size_t& index)
+{
+	uint64_t head = free_head_.load();
+	uint64_t new_head = 0;
+	do
+	{
+		uint64_t top = head & INDEX_MASK;
+		if (top == 0)
+			return false;
+
+		index = static_cast<size_t>(top - 1);
+		new_head = (((head >> 32) + 1) << 32) | free_next_[index].load();
+	} while (!free_head_.compare_exchange_weak(head, new_head));
+
+	return true;
+}
+
+} // namespace net
\ No newline at end of file
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <vector>
+#include "Session.h"
+
+namespace net {
+
+	// 고정 크기 슬롯 테이블로 관리하는 세션 목록.
+	// 세션 id 는 슬롯 index 와 generation 으로 만들기 때문에 슬롯이 재사용되어도 이전 id 로는 찾을수 없다.
+	// 조회와 슬롯 할당/반환에 락을 사용하지 않는다.
+	class SessionRegistry
+	{
+	public:
+		SessionRegistry(const SessionRegistry&) = delete;
+		SessionRegistry& operator=(const SessionRegistry&) = delete;
+
+		explicit SessionRegistry(size_t capacity);
+
+		size_t Capacity() const
+		{
+			return slots_.size();
+		}
+
+		// id 의 슬롯 index.
+		size_t Index(int id) const
+		{
+			return static_cast<size_t>(id) & index_mask_;
+		}
+
+		// 빈 슬롯을 예약하고 새 id 를 발급한다. 빈 슬롯이 없으면 false.
+		bool Acquire(int& id);
+
+		// 예약한 슬롯을 반환한다. 세션 객체는 마지막 참조가 사라질때 재사용을 위해 슬롯으로 돌아온다.
+		void Release(int id);
+
+		// 예약한 슬롯에 세션을 등록한다. 이후 Find 로 찾을수 있다.
+		void Set(int id, const Ptr<Session>& session);
+
+		Ptr<Session> Find(int id) const;
+
+		// 새로 만든 세션 객체를 마지막 참조가 사라지면 id 의 슬롯으로 돌아오게 감싼다.
+		Ptr<Session> MakeRecyclable(int id, std::unique_ptr<Session> session);
+
+		// id 의 슬롯으로 돌아온 이전 세션 객체. 없으면 nullptr.
+		// 모든 참조가 사라진 뒤에 돌아온 객체라서 다른 스레드의 핸들러와 겹치지 않는다.
+		Ptr<Session> TakeRecyclable(int id);
+
+		// 등록된 모든 세션에 대해 실행한다.
+		template <typename Function>
+		void ForEach(Function&& func) const
+		{
+			for (auto& slot : slots_)
+			{
+				if (slot.id.load() == 0)
+					continue;
+
+				auto session = std::atomic_load(&slot.session);
+				if (session)
+					func(session);
+			}
+		}
+
+	private:
+		static constexpr uint64_t INDEX_MASK = 0xffffffff;
+
+		// 마지막 참조가 사라진 세션 객체를 슬롯 index 별로 보관한다.
+		// 세션은 레지스트리보다 오래 남을수 있으므로 deleter 가 공유한다.
+		struct RecycleBin
+		{
+			explicit RecycleBin(size_t size);
+			~RecycleBin();
+
+			// 먼저 돌아와 있던 객체는 지운다.
+			void Put(size_t index, Session* session);
+			Session* Take(size_t index);
+
+			std::unique_ptr<std::atomic<Session*>[]> sessions;
+			size_t size;
+		};
+
+		struct Recycler
+		{
+			void operator()(Session* session) const
+			{
+				bin->Put(index, session);
+			}
+
+			Ptr<RecycleBin> bin;
+			size_t index;
+		};
+
+		struct Slot
+		{
+			// std::atomic_load/atomic_store 로만 접근한다.
+			Ptr<Session> session;
+			// 등록된 세션의 id. 비어있으면 0.
+			std::atomic<int> id{ 0 };
+			// 슬롯을 예약한 쪽만 사용한다.
+			int generation = 0;
+		};
+
+		void PushFree(size_t index);
+		bool PopFree(size_t& index);
+
+		std::vector<Slot> slots_;
+		Ptr<RecycleBin> recycle_bin_;
+		// 빈 슬롯 스택. ABA 를 막기 위해 상위 32bit 에 tag, 하위 32bit 에 index + 1 (0 이면 비어있음).
+		std::atomic<uint64_t> free_head_{ 0 };
+		std::unique_ptr<std::atomic<uint32_t>[]> free_next_;
+		int index_bits_;
+		size_t index_mask_;
+		int max_generation_;
+	};
+
+} // namespace net
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+
+namespace net {
+
+	// 스레드별 통계 카운터. 소유한 스레드만 쓰고 다른 스레드는 읽기만 한다.
+	using StatCounter = std::atomic<uint64_t>;
+
+	// 한 스레드만 쓰므로 read-modify-write 대신 load/store 로 충분하다.
+	inline void AddStat(StatCounter& counter, uint64_t value)
+	{
+		counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+	}
+
+	inline void MaxStat(StatCounter& counter, uint64_t value)
+	{
+		if (value > counter.load(std::memory_order_relaxed))
+			counter.store(value, std::memory_order_relaxed);
+	}
+
+	inline uint64_t LoadStat(const StatCounter& counter)
+	{
+		return counter.load(std::memory_order_relaxed);
+	}
+
+	// 통계를 모으기 위한 살아있는 스레드의 카운터 목록과 종료된 스레드의 합계.
+	// Counters 는 스레드마다 하나씩 만드는 카운터, Totals 는 합계.
+	// Accumulate 는 void(Totals&, const Counters&) 로 카운터의 값을 합계에 더한다.
+	template <typename Counters, typename Totals>
+	class ThreadStatsRegistry
+	{
+	public:
+		static ThreadStatsRegistry& Instance()
+		{
+			// 스레드 카운터가 정적 객체 소멸 이후에 해제될수 있으므로 해제하지 않는다.
+			static ThreadStatsRegistry* registry = new ThreadStatsRegistry();
+			return *registry;
+		}
+
+		void Register(Counters* counters)
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			counters_.push_back(counters);
+		}
+
+		// 스레드가 종료될때 부른다. 목록에서 빼고 값은 합계에 남긴다.
+		template <typename Accumulate>
+		void Retire(Counters* counters, Accumulate&& accumulate)
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			counters_.erase(std::remove(counters_.begin(), counters_.end(), counters), counters_.end());
+			accumulate(retired_, *counters);
+		}
+
+		// 종료된 스레드를 포함한 합계.
+		template <typename Accumulate>
+		Totals Collect(Accumulate&& accumulate)
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			Totals totals = retired_;
+			for (auto counters : counters_)
+			{
+				accumulate(totals, *counters);
+			}
+			return totals;
+		}
+
+	private:
+		ThreadStatsRegistry() = default;
+
+		std::mutex mutex_;
+		std::vector<Counters*> counters_;
+		Totals retired_{};
+	};
+
+} // namespace net
\ No newline at end of file
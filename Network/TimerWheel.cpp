@@ -0,0 +1,119 @@
+#include "TimerWheel.h"
+
+namespace net {
+
+TimerWheel::TimerWheel()
+{
+	for (auto& level : slots_)
+	{
+		for (auto& head : level)
+		{
+			head.prev_ = &head;
+			head.next_ = &head;
+		}
+	}
+}
+
+TimerWheel::~TimerWheel()
+{
+	for (auto& level : slots_)
+	{
+		for (auto& head : level)
+		{
+			while (head.next_ != &head)
+			{
+				Unlink(head.next_);
+			}
+		}
+	}
+}
+
+void TimerWheel::Schedule(Entry* entry, uint64_t ticks)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	if (entry->IsScheduled())
+		Unlink(entry);
+
+	entry->expire_ = now_.load(std::memory_order_relaxed) + std::max<uint64_t>(std::min(ticks, MAX_TICKS), 1);
+	Link(entry);
+}
+
+void TimerWheel::Cancel(Entry* entry)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	if (entry->IsScheduled())
+		Unlink(entry);
+}
+
+void TimerWheel::Tick(const ExpireHandler& on_expire)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	uint64_t now = now_.load(std::memory_order_relaxed) + 1;
+	now_.store(now, std::memory_order_relaxed);
+
+	// 하위 레벨이 한바퀴 돌면 상위 레벨의 다음 슬롯을 내려보낸다.
+	for (size_t level = 1; level < LEVEL_COUNT; level++)
+	{
+		if ((now & ((uint64_t(1) << (SLOT_BITS * level)) - 1)) != 0)
+			break;
+
+		Cascade(level, (now >> (SLOT_BITS * level)) & (SLOT_COUNT - 1));
+	}
+
+	// 만료된 슬롯을 떼어내서 처리한다. 처리중에 다시 예약된 엔트리는 다른 슬롯에 들어간다.
+	Entry& head = slots_[0][now & (SLOT_COUNT - 1)];
+	while (head.next_ != &head)
+	{
+		Entry* entry = head.next_;
+		Unlink(entry);
+
+		uint64_t ticks = on_expire(entry);
+		if (ticks > 0)
+		{
+			entry->expire_ = now + std::min(ticks, MAX_TICKS);
+			Link(entry);
+		}
+	}
+}
+
+void TimerWheel::Link(Entry* entry)
+{
+	uint64_t now = now_.load(std::memory_order_relaxed);
+	uint64_t delta = entry->expire_ - now;
+
+	size_t level = 0;
+	while (level < LEVEL_COUNT - 1 && delta >= (uint64_t(1) << (SLOT_BITS * (level + 1))))
+	{
+		level++;
+	}
+
+	Entry& head = slots_[level][(entry->expire_ >> (SLOT_BITS * level)) & (SLOT_COUNT - 1)];
+	entry->prev_ = head.prev_;
+	entry->next_ = &head;
+	head.prev_->next_ = entry;
+	head.prev_ = entry;
+}
+
+void TimerWheel::Unlink(Entry* entry)
+{
+	entry->prev_->next_ = entry->next_;
+	entry->next_->prev_ = entry->prev_;
+	entry->prev_ = nullptr;
+	entry->next_ = nullptr;
+}
+
+void TimerWheel::Cascade(size_t level, size_t slot)
+{
+	Entry& head = slots_[level][slot];
+	while (head.next_ != &head)
+	{
+		Entry* entry = head.next_;
+		Unlink(entry);
+		Link(entry);
+	}
+}
+
+} // namespace net
\ No newline at end of file
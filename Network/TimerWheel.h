@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include "Types.h"
+
+namespace net {
+
+	// 계층형 타이밍 휠.
+	// 레벨마다 64개의 슬롯을 두고, 먼 만료 시간은 상위 레벨에 넣었다가 가까워지면 아래 레벨로 옮긴다.
+	// 예약과 취소는 O(1) 이고 엔트리는 호출한 쪽의 객체에 포함되므로 할당이 없다.
+	class TimerWheel
+	{
+	public:
+		// 휠에 넣을 객체가 상속하는 링크.
+		class Entry
+		{
+		public:
+			Entry() = default;
+			Entry(const Entry&) = delete;
+			Entry& operator=(const Entry&) = delete;
+
+			bool IsScheduled() const
+			{
+				return next_ != nullptr;
+			}
+
+		private:
+			friend class TimerWheel;
+
+			Entry* prev_ = nullptr;
+			Entry* next_ = nullptr;
+			uint64_t expire_ = 0;
+		};
+
+		// 만료된 엔트리마다 호출된다. 0 이 아닌 값을 리턴하면 그 틱 만큼 뒤로 다시 예약한다.
+		// 휠의 락을 잡은 상태로 호출되므로 휠의 함수를 호출하면 안된다.
+		using ExpireHandler = std::function<uint64_t(Entry*)>;
+
+		static constexpr size_t SLOT_BITS = 6;
+		static constexpr size_t SLOT_COUNT = size_t(1) << SLOT_BITS;
+		static constexpr size_t LEVEL_COUNT = 4;
+		// 예약할수 있는 최대 틱. 넘으면 이 값으로 줄인다.
+		static constexpr uint64_t MAX_TICKS = (uint64_t(1) << (SLOT_BITS * LEVEL_COUNT)) - 1;
+
+		TimerWheel(const TimerWheel&) = delete;
+		TimerWheel& operator=(const TimerWheel&) = delete;
+
+		TimerWheel();
+		// 남은 엔트리는 예약되지 않은 상태로 만든다.
+		~TimerWheel();
+
+		// 현재 틱. 락 없이 읽을수 있다.
+		uint64_t Now() const
+		{
+			return now_.load(std::memory_order_relaxed);
+		}
+
+		// ticks 뒤에 만료되도록 예약한다. 이미 예약되어 있으면 옮긴다.
+		void Schedule(Entry* entry, uint64_t ticks);
+
+		// 예약을 취소한다. 예약되어 있지 않으면 아무것도 하지 않는다.
+		void Cancel(Entry* entry);
+
+		// 한 틱 전진하고 만료된 엔트리를 처리한다.
+		void Tick(const ExpireHandler& on_expire);
+
+	private:
+		void Link(Entry* entry);
+		static void Unlink(Entry* entry);
+		// 상위 레벨 슬롯의 엔트리를 현재 시간 기준으로 다시 배치한다.
+		void Cascade(size_t level, size_t slot);
+
+		std::mutex mutex_;
+		std::atomic<uint64_t> now_{ 0 };
+		// 슬롯마다 원형 리스트의 헤드.
+		std::array<std::array<Entry, SLOT_COUNT>, LEVEL_COUNT> slots_;
+	};
+
+} // namespace net
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <chrono>
+#include <algorithm>
+#include "Config.h"
+
+namespace net {
+
+	// 초당 rate 개씩 채워지고 burst 개까지 모이는 토큰.
+	// 시간은 호출한 쪽이 넘기므로 여러 버킷을 같은 시각으로 검사할수 있다.
+	class TokenBucket
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		TokenBucket() = default;
+
+		TokenBucket(const RateLimit& limit, Clock::time_point now)
+			: rate_(limit.rate)
+			, burst_(std::max(limit.burst, 1.0))
+			, tokens_(burst_)
+			, last_time_(now)
+		{
+		}
+
+		bool IsLimited() const
+		{
+			return rate_ > 0;
+		}
+
+		// 토큰이 있으면 하나를 쓰고 true.
+		bool Consume(Clock::time_point now)
+		{
+			if (rate_ <= 0)
+				return true;
+
+			if (now > last_time_)
+			{
+				tokens_ = std::min(burst_, tokens_ + std::chrono::duration<double>(now - last_time_).count() * rate_);
+				last_time_ = now;
+			}
+
+			if (tokens_ < 1)
+				return false;
+
+			tokens_ -= 1;
+			return true;
+		}
+
+	private:
+		double rate_ = 0;
+		double burst_ = 1;
+		double tokens_ = 0;
+		Clock::time_point last_time_;
+	};
+
+} // namespace net
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include <cstring>
+#include "UdpChannel.h"
+
+namespace net {
+
+UdpChannel::UdpChannel(asio::io_context& io_context, const udp::endpoint& endpoint, size_t max_datagram_size)
+	: socket_(io_context)
+	, max_datagram_size_(std::max(max_datagram_size, sizeof(DatagramHeader) + 1))
+{
+	socket_.open(endpoint.protocol());
+	socket_.bind(endpoint);
+	// 보내기는 여러 스레드에서 바로 하므로 블럭되지 않게 한다.
+	socket_.non_blocking(true);
+	port_ = socket_.local_endpoint().port();
+
+	receive_buf_.resize(max_datagram_size_);
+}
+
+UdpChannel::~UdpChannel()
+{
+	Close();
+}
+
+void UdpChannel::Start(const DatagramHandler& handler)
+{
+	handler_ = handler;
+	Receive();
+}
+
+void UdpChannel::Close()
+{
+	if (closed_.exchange(true))
+		return;
+
+	error_code ec;
+	socket_.close(ec);
+}
+
+bool UdpChannel::SendTo(const udp::endpoint& endpoint, const DatagramHeader& header, const uint8_t* payload, size_t size)
+{
+	if (closed_.load(std::memory_order_relaxed) || sizeof(header) + size > max_datagram_size_)
+		return false;
+
+	std::array<asio::const_buffer, 2> bufs = {
+		asio::buffer(&header, sizeof(header)),
+		asio::buffer(payload, size)
+	};
+
+	error_code ec;
+	socket_.send_to(bufs, endpoint, 0, ec);
+	return !ec;
+}
+
+bool UdpChannel::SendFrame(const udp::endpoint& endpoint, uint64_t token, uint32_t sequence, uint64_t key, const SendBuffer& frame)
+{
+	if (frame.Size() <= sizeof(FrameHeader))
+		return false;
+
+	FrameHeader frame_header = frame.Header();
+	size_t payload_size = frame.Size() - sizeof(FrameHeader);
+	if (frame_header.IsCompressed() || payload_size > MaxPayloadSize())
+		return false;
+
+	DatagramHeader header = { static_cast<uint8_t>(DatagramType::Data), token, sequence, key, frame_header.message_type };
+	return SendTo(endpoint, header, frame.Data() + sizeof(FrameHeader), payload_size);
+}
+
+void UdpChannel::Receive()
+{
+	if (closed_.load())
+		return;
+
+	socket_.async_receive_from(asio::buffer(receive_buf_), sender_, MakeAllocHandler(receive_memory_,
+		[this, self = shared_from_this()](const error_code& error, std::size_t bytes_transferred)
+	{
+		if (error == asio::error::operation_aborted || closed_.load())
+			return;
+
+		// 한 데이터그램의 오류(ICMP port unreachable 등)는 무시하고 계속 받는다.
+		if (!error && bytes_transferred >= sizeof(DatagramHeader))
+		{
+			DatagramHeader header;
+			std::memcpy(&header, receive_buf_.data(), sizeof(header));
+			if (handler_)
+				handler_(header, sender_, receive_buf_.data() + sizeof(header), bytes_transferred - sizeof(header));
+		}
+
+		Receive();
+	}));
+}
+
+} // namespace net
\ No newline at end of file
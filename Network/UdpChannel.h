@@ -0,0 +1,138 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <unordered_map>
+#include "Types.h"
+#include "AsioHelper.h"
+#include "SendBuffer.h"
+
+namespace net {
+
+	// TCP 프레임의 CONTROL payload 첫 바이트.
+	enum class ControlType : uint8_t
+	{
+		UdpToken = 1,	// [type][uint64 token][uint16 udp port] 서버가 세션을 열때 보낸다.
+	};
+
+	// UDP 데이터그램 종류.
+	enum class DatagramType : uint8_t
+	{
+		Bind = 1,		// 클라이언트 -> 서버. token 으로 세션에 UDP 주소를 등록한다.
+		BindAck,		// 서버 -> 클라이언트. 등록 완료.
+		Data			// payload 가 있는 메시지.
+	};
+
+#pragma pack(push, 1)
+	// 모든 데이터그램 앞에 붙는 헤더.
+	struct DatagramHeader
+	{
+		uint8_t type;
+		uint64_t token;		// TCP 세션에서 받은 token. 세션을 찾고 위조를 막는다.
+		uint32_t sequence;	// 보내는 쪽이 데이터그램마다 1씩 증가시킨다.
+		uint64_t key;		// 같은 key 의 메시지는 마지막 것만 의미가 있다.
+		uint16_t message_type;	// 프레임 헤더의 message_type.
+	};
+#pragma pack(pop)
+
+	// key 마다 받은 마지막 sequence 를 기억하고 이전 데이터그램을 걸러낸다.
+	// 순서가 바뀌어 늦게 도착한 이동 갱신이 최신 위치를 덮어쓰지 않게 한다.
+	// 서버는 key 를 클라이언트가 정하므로 기억하는 key 의 수를 제한한다. max_keys 가 0 이면 제한하지 않는다.
+	class SequenceFilter
+	{
+	public:
+		static constexpr size_t DEFAULT_MAX_KEYS = 256;
+
+		explicit SequenceFilter(size_t max_keys = DEFAULT_MAX_KEYS)
+			: max_keys_(max_keys)
+		{
+		}
+
+		// 처음 보는 key 이거나 마지막보다 새 sequence 면 true.
+		// 기억하는 key 가 max_keys 에 이르면 새 key 는 받지 않는다.
+		bool Accept(uint64_t key, uint32_t sequence)
+		{
+			auto iter = last_sequences_.find(key);
+			if (iter == last_sequences_.end())
+			{
+				if (max_keys_ > 0 && last_sequences_.size() >= max_keys_)
+					return false;
+
+				last_sequences_.emplace(key, sequence);
+				return true;
+			}
+
+			// sequence 가 한바퀴 돌아도 비교할수 있도록 차이의 부호로 판단한다.
+			uint32_t& last = iter->second;
+			if (static_cast<int32_t>(sequence - last) <= 0)
+				return false;
+
+			last = sequence;
+			return true;
+		}
+
+		void Clear()
+		{
+			last_sequences_.clear();
+		}
+
+	private:
+		std::unordered_map<uint64_t, uint32_t> last_sequences_;
+		size_t max_keys_;
+	};
+
+	// DatagramHeader 로 구분되는 데이터그램을 주고 받는 UDP 소켓.
+	// 서버는 모든 세션이 하나를 공유하고 클라이언트는 연결마다 하나를 사용한다.
+	class UdpChannel : public std::enable_shared_from_this<UdpChannel>
+	{
+	public:
+		using udp = asio::ip::udp;
+
+		// 받은 데이터그램. payload 는 핸들러가 리턴하면 재사용된다.
+		using DatagramHandler = std::function<void(const DatagramHeader&, const udp::endpoint&, const uint8_t*, size_t)>;
+
+		UdpChannel(const UdpChannel&) = delete;
+		UdpChannel& operator=(const UdpChannel&) = delete;
+
+		// max_datagram_size 는 헤더를 포함한 최대 크기. 경로 MTU 를 넘지 않게 잡는다.
+		UdpChannel(asio::io_context& io_context, const udp::endpoint& endpoint, size_t max_datagram_size);
+		~UdpChannel();
+
+		// 받기 시작한다. 핸들러는 io_context 에서 하나씩 호출된다.
+		void Start(const DatagramHandler& handler);
+		void Close();
+
+		// 블럭하지 않고 바로 보낸다. 소켓 버퍼가 가득 찼거나 실패하면 버리고 false.
+		// 보내기만 하므로 여러 스레드에서 동시에 호출할수 있다.
+		bool SendTo(const udp::endpoint& endpoint, const DatagramHeader& header, const uint8_t* payload, size_t size);
+
+		// 프레임 헤더를 뺀 payload 를 Data 데이터그램으로 보낸다.
+		// 압축된 프레임이거나 크기를 넘어서 보내지 못하면 false.
+		bool SendFrame(const udp::endpoint& endpoint, uint64_t token, uint32_t sequence, uint64_t key, const SendBuffer& frame);
+
+		// 헤더를 제외하고 보낼수 있는 payload 크기.
+		size_t MaxPayloadSize() const
+		{
+			return max_datagram_size_ - sizeof(DatagramHeader);
+		}
+
+		uint16_t GetPort() const
+		{
+			return port_;
+		}
+
+	private:
+		void Receive();
+
+		udp::socket socket_;
+		uint16_t port_ = 0;
+		size_t max_datagram_size_;
+		std::atomic<bool> closed_{ false };
+
+		DatagramHandler handler_;
+		std::vector<uint8_t> receive_buf_;
+		udp::endpoint sender_;
+		HandlerMemory receive_memory_;
+	};
+
+} // namespace net
\ No newline at end of file
@@ -7,4 +7,8 @@
 #include "Config.h"
 #include "Session.h"
 #include "ByteBuffer.h"
+#include "BufferPool.h"
+#include "NetMetrics.h"
+#include "UdpChannel.h"
+#include "SendBuffer.h"
 #include "AsioHelper.h"
\ No newline at end of file
@@ -25,27 +25,18 @@ public struct MapData : IFlatbufferObject
   public bool MutateMapType(ProtocolCS.MapType map_type) { int o = __p.__offset(8); if (o != 0) { __p.bb.PutInt(o + __p.bb_pos, (int)map_type); return true; } else { return false; } }
   public GateInfo? MapGates(int j) { int o = __p.__offset(10); return o != 0 ? (GateInfo?)(new GateInfo()).__assign(__p.__indirect(__p.__vector(o) + j * 4), __p.bb) : null; }
   public int MapGatesLength { get { int o = __p.__offset(10); return o != 0 ? __p.__vector_len(o) : 0; } }
+  public ProtocolCS.Vec3? AreaMin { get { int o = __p.__offset(12); return o != 0 ? (ProtocolCS.Vec3?)(new ProtocolCS.Vec3()).__assign(o + __p.bb_pos, __p.bb) : null; } }
+  public ProtocolCS.Vec3? AreaMax { get { int o = __p.__offset(14); return o != 0 ? (ProtocolCS.Vec3?)(new ProtocolCS.Vec3()).__assign(o + __p.bb_pos, __p.bb) : null; } }
 
-  public static Offset<MapData> CreateMapData(FlatBufferBuilder builder,
-      StringOffset entity_idOffset = default(StringOffset),
-      int map_id = 0,
-      ProtocolCS.MapType map_type = ProtocolCS.MapType.NONE,
-      VectorOffset map_gatesOffset = default(VectorOffset)) {
-    builder.StartObject(4);
-    MapData.AddMapGates(builder, map_gatesOffset);
-    MapData.AddMapType(builder, map_type);
-    MapData.AddMapId(builder, map_id);
-    MapData.AddEntityId(builder, entity_idOffset);
-    return MapData.EndMapData(builder);
-  }
-
-  public static void StartMapData(FlatBufferBuilder builder) { builder.StartObject(4); }
+  public static void StartMapData(FlatBufferBuilder builder) { builder.StartObject(6); }
   public static void AddEntityId(FlatBufferBuilder builder, StringOffset entityIdOffset) { builder.AddOffset(0, entityIdOffset.Value, 0); }
   public static void AddMapId(FlatBufferBuilder builder, int mapId) { builder.AddInt(1, mapId, 0); }
   public static void AddMapType(FlatBufferBuilder builder, ProtocolCS.MapType mapType) { builder.AddInt(2, (int)mapType, 0); }
   public static void AddMapGates(FlatBufferBuilder builder, VectorOffset mapGatesOffset) { builder.AddOffset(3, mapGatesOffset.Value, 0); }
   public static VectorOffset CreateMapGatesVector(FlatBufferBuilder builder, Offset<GateInfo>[] data) { builder.StartVector(4, data.Length, 4); for (int i = data.Length - 1; i >= 0; i--) builder.AddOffset(data[i].Value); return builder.EndVector(); }
   public static void StartMapGatesVector(FlatBufferBuilder builder, int numElems) { builder.StartVector(4, numElems, 4); }
+  public static void AddAreaMin(FlatBufferBuilder builder, Offset<ProtocolCS.Vec3> areaMinOffset) { builder.AddStruct(4, areaMinOffset.Value, 0); }
+  public static void AddAreaMax(FlatBufferBuilder builder, Offset<ProtocolCS.Vec3> areaMaxOffset) { builder.AddStruct(5, areaMaxOffset.Value, 0); }
   public static Offset<MapData> EndMapData(FlatBufferBuilder builder) {
     int o = builder.EndObject();
     return new Offset<MapData>(o);
@@ -0,0 +1,52 @@
+// <auto-generated>
+//  automatically generated by the FlatBuffers compiler, do not modify
+// </auto-generated>
+
+namespace ProtocolCS.World
+{
+
+using global::System;
+using global::FlatBuffers;
+
+public struct MoveSnapshot : IFlatbufferObject
+{
+  private Table __p;
+  public ByteBuffer ByteBuffer { get { return __p.bb; } }
+  public static MoveSnapshot GetRootAsMoveSnapshot(ByteBuffer _bb) { return GetRootAsMoveSnapshot(_bb, new MoveSnapshot()); }
+  public static MoveSnapshot GetRootAsMoveSnapshot(ByteBuffer _bb, MoveSnapshot obj) { return (obj.__assign(_bb.GetInt(_bb.Position) + _bb.Position, _bb)); }
+  public void __init(int _i, ByteBuffer _bb) { __p.bb_pos = _i; __p.bb = _bb; }
+  public MoveSnapshot __assign(int _i, ByteBuffer _bb) { __init(_i, _bb); return this; }
+
+  public SnapshotPosition? Positions(int j) { int o = __p.__offset(4); return o != 0 ? (SnapshotPosition?)(new SnapshotPosition()).__assign(__p.__vector(o) + j * 8, __p.bb) : null; }
+  public int PositionsLength { get { int o = __p.__offset(4); return o != 0 ? __p.__vector_len(o) : 0; } }
+  public SnapshotRotation? Rotations(int j) { int o = __p.__offset(6); return o != 0 ? (SnapshotRotation?)(new SnapshotRotation()).__assign(__p.__vector(o) + j * 4, __p.bb) : null; }
+  public int RotationsLength { get { int o = __p.__offset(6); return o != 0 ? __p.__vector_len(o) : 0; } }
+  public SnapshotVelocity? Velocities(int j) { int o = __p.__offset(8); return o != 0 ? (SnapshotVelocity?)(new SnapshotVelocity()).__assign(__p.__vector(o) + j * 8, __p.bb) : null; }
+  public int VelocitiesLength { get { int o = __p.__offset(8); return o != 0 ? __p.__vector_len(o) : 0; } }
+
+  public static Offset<MoveSnapshot> CreateMoveSnapshot(FlatBufferBuilder builder,
+      VectorOffset positionsOffset = default(VectorOffset),
+      VectorOffset rotationsOffset = default(VectorOffset),
+      VectorOffset velocitiesOffset = default(VectorOffset)) {
+    builder.StartObject(3);
+    MoveSnapshot.AddVelocities(builder, velocitiesOffset);
+    MoveSnapshot.AddRotations(builder, rotationsOffset);
+    MoveSnapshot.AddPositions(builder, positionsOffset);
+    return MoveSnapshot.EndMoveSnapshot(builder);
+  }
+
+  public static void StartMoveSnapshot(FlatBufferBuilder builder) { builder.StartObject(3); }
+  public static void AddPositions(FlatBufferBuilder builder, VectorOffset positionsOffset) { builder.AddOffset(0, positionsOffset.Value, 0); }
+  public static void StartPositionsVector(FlatBufferBuilder builder, int numElems) { builder.StartVector(8, numElems, 2); }
+  public static void AddRotations(FlatBufferBuilder builder, VectorOffset rotationsOffset) { builder.AddOffset(1, rotationsOffset.Value, 0); }
+  public static void StartRotationsVector(FlatBufferBuilder builder, int numElems) { builder.StartVector(4, numElems, 2); }
+  public static void AddVelocities(FlatBufferBuilder builder, VectorOffset velocitiesOffset) { builder.AddOffset(2, velocitiesOffset.Value, 0); }
+  public static void StartVelocitiesVector(FlatBufferBuilder builder, int numElems) { builder.StartVector(8, numElems, 2); }
+  public static Offset<MoveSnapshot> EndMoveSnapshot(FlatBufferBuilder builder) {
+    int o = builder.EndObject();
+    return new Offset<MoveSnapshot>(o);
+  }
+};
+
+
+}
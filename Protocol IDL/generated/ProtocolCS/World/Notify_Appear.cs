@@ -18,16 +18,21 @@ public struct Notify_Appear : IFlatbufferObject
   public Notify_Appear __assign(int _i, ByteBuffer _bb) { __init(_i, _bb); return this; }
 
   public Actor? Entity { get { int o = __p.__offset(4); return o != 0 ? (Actor?)(new Actor()).__assign(__p.__indirect(o + __p.bb_pos), __p.bb) : null; } }
+  public ushort NetId { get { int o = __p.__offset(6); return o != 0 ? __p.bb.GetUshort(o + __p.bb_pos) : (ushort)0; } }
+  public bool MutateNetId(ushort net_id) { int o = __p.__offset(6); if (o != 0) { __p.bb.PutUshort(o + __p.bb_pos, net_id); return true; } else { return false; } }
 
   public static Offset<Notify_Appear> CreateNotify_Appear(FlatBufferBuilder builder,
-      Offset<Actor> entityOffset = default(Offset<Actor>)) {
-    builder.StartObject(1);
+      Offset<Actor> entityOffset = default(Offset<Actor>),
+      ushort net_id = 0) {
+    builder.StartObject(2);
     Notify_Appear.AddEntity(builder, entityOffset);
+    Notify_Appear.AddNetId(builder, net_id);
     return Notify_Appear.EndNotify_Appear(builder);
   }
 
-  public static void StartNotify_Appear(FlatBufferBuilder builder) { builder.StartObject(1); }
+  public static void StartNotify_Appear(FlatBufferBuilder builder) { builder.StartObject(2); }
   public static void AddEntity(FlatBufferBuilder builder, Offset<Actor> entityOffset) { builder.AddOffset(0, entityOffset.Value, 0); }
+  public static void AddNetId(FlatBufferBuilder builder, ushort netId) { builder.AddUshort(1, netId, 0); }
   public static Offset<Notify_Appear> EndNotify_Appear(FlatBufferBuilder builder) {
     int o = builder.EndObject();
     return new Offset<Notify_Appear>(o);
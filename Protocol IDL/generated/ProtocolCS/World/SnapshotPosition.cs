@@ -0,0 +1,38 @@
+// <auto-generated>
+//  automatically generated by the FlatBuffers compiler, do not modify
+// </auto-generated>
+
+namespace ProtocolCS.World
+{
+
+using global::System;
+using global::FlatBuffers;
+
+public struct SnapshotPosition : IFlatbufferObject
+{
+  private Struct __p;
+  public ByteBuffer ByteBuffer { get { return __p.bb; } }
+  public void __init(int _i, ByteBuffer _bb) { __p.bb_pos = _i; __p.bb = _bb; }
+  public SnapshotPosition __assign(int _i, ByteBuffer _bb) { __init(_i, _bb); return this; }
+
+  public ushort NetId { get { return __p.bb.GetUshort(__p.bb_pos + 0); } }
+  public void MutateNetId(ushort net_id) { __p.bb.PutUshort(__p.bb_pos + 0, net_id); }
+  public ushort X { get { return __p.bb.GetUshort(__p.bb_pos + 2); } }
+  public void MutateX(ushort x) { __p.bb.PutUshort(__p.bb_pos + 2, x); }
+  public ushort Y { get { return __p.bb.GetUshort(__p.bb_pos + 4); } }
+  public void MutateY(ushort y) { __p.bb.PutUshort(__p.bb_pos + 4, y); }
+  public ushort Z { get { return __p.bb.GetUshort(__p.bb_pos + 6); } }
+  public void MutateZ(ushort z) { __p.bb.PutUshort(__p.bb_pos + 6, z); }
+
+  public static Offset<SnapshotPosition> CreateSnapshotPosition(FlatBufferBuilder builder, ushort NetId, ushort X, ushort Y, ushort Z) {
+    builder.Prep(2, 8);
+    builder.PutUshort(Z);
+    builder.PutUshort(Y);
+    builder.PutUshort(X);
+    builder.PutUshort(NetId);
+    return new Offset<SnapshotPosition>(builder.Offset);
+  }
+};
+
+
+}
@@ -0,0 +1,32 @@
+// <auto-generated>
+//  automatically generated by the FlatBuffers compiler, do not modify
+// </auto-generated>
+
+namespace ProtocolCS.World
+{
+
+using global::System;
+using global::FlatBuffers;
+
+public struct SnapshotRotation : IFlatbufferObject
+{
+  private Struct __p;
+  public ByteBuffer ByteBuffer { get { return __p.bb; } }
+  public void __init(int _i, ByteBuffer _bb) { __p.bb_pos = _i; __p.bb = _bb; }
+  public SnapshotRotation __assign(int _i, ByteBuffer _bb) { __init(_i, _bb); return this; }
+
+  public ushort NetId { get { return __p.bb.GetUshort(__p.bb_pos + 0); } }
+  public void MutateNetId(ushort net_id) { __p.bb.PutUshort(__p.bb_pos + 0, net_id); }
+  public ushort Rotation { get { return __p.bb.GetUshort(__p.bb_pos + 2); } }
+  public void MutateRotation(ushort rotation) { __p.bb.PutUshort(__p.bb_pos + 2, rotation); }
+
+  public static Offset<SnapshotRotation> CreateSnapshotRotation(FlatBufferBuilder builder, ushort NetId, ushort Rotation) {
+    builder.Prep(2, 4);
+    builder.PutUshort(Rotation);
+    builder.PutUshort(NetId);
+    return new Offset<SnapshotRotation>(builder.Offset);
+  }
+};
+
+
+}
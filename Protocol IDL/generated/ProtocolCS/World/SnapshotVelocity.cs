@@ -0,0 +1,38 @@
+// <auto-generated>
+//  automatically generated by the FlatBuffers compiler, do not modify
+// </auto-generated>
+
+namespace ProtocolCS.World
+{
+
+using global::System;
+using global::FlatBuffers;
+
+public struct SnapshotVelocity : IFlatbufferObject
+{
+  private Struct __p;
+  public ByteBuffer ByteBuffer { get { return __p.bb; } }
+  public void __init(int _i, ByteBuffer _bb) { __p.bb_pos = _i; __p.bb = _bb; }
+  public SnapshotVelocity __assign(int _i, ByteBuffer _bb) { __init(_i, _bb); return this; }
+
+  public ushort NetId { get { return __p.bb.GetUshort(__p.bb_pos + 0); } }
+  public void MutateNetId(ushort net_id) { __p.bb.PutUshort(__p.bb_pos + 0, net_id); }
+  public short X { get { return __p.bb.GetShort(__p.bb_pos + 2); } }
+  public void MutateX(short x) { __p.bb.PutShort(__p.bb_pos + 2, x); }
+  public short Y { get { return __p.bb.GetShort(__p.bb_pos + 4); } }
+  public void MutateY(short y) { __p.bb.PutShort(__p.bb_pos + 4, y); }
+  public short Z { get { return __p.bb.GetShort(__p.bb_pos + 6); } }
+  public void MutateZ(short z) { __p.bb.PutShort(__p.bb_pos + 6, z); }
+
+  public static Offset<SnapshotVelocity> CreateSnapshotVelocity(FlatBufferBuilder builder, ushort NetId, short X, short Y, short Z) {
+    builder.Prep(2, 8);
+    builder.PutShort(Z);
+    builder.PutShort(Y);
+    builder.PutShort(X);
+    builder.PutUshort(NetId);
+    return new Offset<SnapshotVelocity>(builder.Offset);
+  }
+};
+
+
+}
@@ -14,6 +14,7 @@ public enum UpdateType : byte
  DamageInfo = 4,
  StateInfo = 5,
  AttributeInfo = 6,
+ MoveSnapshot = 7,
 };
 
 
@@ -21,19 +21,24 @@ public struct MessageRoot : IFlatbufferObject
   public MessageType MessageType { get { int o = __p.__offset(4); return o != 0 ? (MessageType)__p.bb.Get(o + __p.bb_pos) : MessageType.NONE; } }
   public bool MutateMessageType(MessageType message_type) { int o = __p.__offset(4); if (o != 0) { __p.bb.Put(o + __p.bb_pos, (byte)message_type); return true; } else { return false; } }
   public TTable? Message<TTable>() where TTable : struct, IFlatbufferObject { int o = __p.__offset(6); return o != 0 ? (TTable?)__p.__union<TTable>(o) : null; }
+  public uint CorrelationId { get { int o = __p.__offset(8); return o != 0 ? __p.bb.GetUint(o + __p.bb_pos) : (uint)0; } }
+  public bool MutateCorrelationId(uint correlation_id) { int o = __p.__offset(8); if (o != 0) { __p.bb.PutUint(o + __p.bb_pos, correlation_id); return true; } else { return false; } }
 
   public static Offset<MessageRoot> CreateMessageRoot(FlatBufferBuilder builder,
       MessageType message_type = MessageType.NONE,
-      int messageOffset = 0) {
-    builder.StartObject(2);
+      int messageOffset = 0,
+      uint correlation_id = 0) {
+    builder.StartObject(3);
+    MessageRoot.AddCorrelationId(builder, correlation_id);
     MessageRoot.AddMessage(builder, messageOffset);
     MessageRoot.AddMessageType(builder, message_type);
     return MessageRoot.EndMessageRoot(builder);
   }
 
-  public static void StartMessageRoot(FlatBufferBuilder builder) { builder.StartObject(2); }
+  public static void StartMessageRoot(FlatBufferBuilder builder) { builder.StartObject(3); }
   public static void AddMessageType(FlatBufferBuilder builder, MessageType messageType) { builder.AddByte(0, (byte)messageType, 0); }
   public static void AddMessage(FlatBufferBuilder builder, int messageOffset) { builder.AddOffset(1, messageOffset, 0); }
+  public static void AddCorrelationId(FlatBufferBuilder builder, uint correlationId) { builder.AddUint(2, correlationId, 0); }
   public static Offset<MessageRoot> EndMessageRoot(FlatBufferBuilder builder) {
     int o = builder.EndObject();
     return new Offset<MessageRoot>(o);
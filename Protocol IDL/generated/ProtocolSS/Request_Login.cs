@@ -21,19 +21,24 @@ public struct Request_Login : IFlatbufferObject
   public ArraySegment<byte>? GetClientNameBytes() { return __p.__vector_as_arraysegment(4); }
   public int ClientType { get { int o = __p.__offset(6); return o != 0 ? __p.bb.GetInt(o + __p.bb_pos) : (int)0; } }
   public bool MutateClientType(int client_type) { int o = __p.__offset(6); if (o != 0) { __p.bb.PutInt(o + __p.bb_pos, client_type); return true; } else { return false; } }
+  public int LinkSessionId { get { int o = __p.__offset(8); return o != 0 ? __p.bb.GetInt(o + __p.bb_pos) : (int)0; } }
+  public bool MutateLinkSessionId(int link_session_id) { int o = __p.__offset(8); if (o != 0) { __p.bb.PutInt(o + __p.bb_pos, link_session_id); return true; } else { return false; } }
 
   public static Offset<Request_Login> CreateRequest_Login(FlatBufferBuilder builder,
       StringOffset client_nameOffset = default(StringOffset),
-      int client_type = 0) {
-    builder.StartObject(2);
+      int client_type = 0,
+      int link_session_id = 0) {
+    builder.StartObject(3);
+    Request_Login.AddLinkSessionId(builder, link_session_id);
     Request_Login.AddClientType(builder, client_type);
     Request_Login.AddClientName(builder, client_nameOffset);
     return Request_Login.EndRequest_Login(builder);
   }
 
-  public static void StartRequest_Login(FlatBufferBuilder builder) { builder.StartObject(2); }
+  public static void StartRequest_Login(FlatBufferBuilder builder) { builder.StartObject(3); }
   public static void AddClientName(FlatBufferBuilder builder, StringOffset clientNameOffset) { builder.AddOffset(0, clientNameOffset.Value, 0); }
   public static void AddClientType(FlatBufferBuilder builder, int clientType) { builder.AddInt(1, clientType, 0); }
+  public static void AddLinkSessionId(FlatBufferBuilder builder, int linkSessionId) { builder.AddInt(2, linkSessionId, 0); }
   public static Offset<Request_Login> EndRequest_Login(FlatBufferBuilder builder) {
     int o = builder.EndObject();
     return new Offset<Request_Login>(o);
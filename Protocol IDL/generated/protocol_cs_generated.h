@@ -96,6 +96,15 @@ struct StateInfoT;
 struct AttributeInfo;
 struct AttributeInfoT;
 
+struct SnapshotPosition;
+
+struct SnapshotRotation;
+
+struct SnapshotVelocity;
+
+struct MoveSnapshot;
+struct MoveSnapshotT;
+
 struct Request_Login;
 struct Request_LoginT;
 
@@ -333,8 +342,9 @@ enum class UpdateType : uint8_t {
   DamageInfo = 4,
   StateInfo = 5,
   AttributeInfo = 6,
+  MoveSnapshot = 7,
   MIN = NONE,
-  MAX = AttributeInfo
+  MAX = MoveSnapshot
 };
 
 inline const char **EnumNamesUpdateType() {
@@ -346,6 +356,7 @@ inline const char **EnumNamesUpdateType() {
     "DamageInfo",
     "StateInfo",
     "AttributeInfo",
+    "MoveSnapshot",
     nullptr
   };
   return names;
@@ -384,6 +395,10 @@ template<> struct UpdateTypeTraits<AttributeInfo> {
   static const UpdateType enum_value = UpdateType::AttributeInfo;
 };
 
+template<> struct UpdateTypeTraits<MoveSnapshot> {
+  static const UpdateType enum_value = UpdateType::MoveSnapshot;
+};
+
 struct UpdateTypeUnion {
   UpdateType type;
   void *value;
@@ -437,6 +452,10 @@ struct UpdateTypeUnion {
     return type == UpdateType::AttributeInfo ?
       reinterpret_cast<AttributeInfoT *>(value) : nullptr;
   }
+  MoveSnapshotT *AsMoveSnapshot() {
+    return type == UpdateType::MoveSnapshot ?
+      reinterpret_cast<MoveSnapshotT *>(value) : nullptr;
+  }
 };
 
 bool VerifyUpdateType(flatbuffers::Verifier &verifier, const void *obj, UpdateType type);
@@ -861,6 +880,135 @@ MANUALLY_ALIGNED_STRUCT(4) Vec3 FLATBUFFERS_FINAL_CLASS {
 };
 STRUCT_END(Vec3, 12);
 
+namespace World {
+
+MANUALLY_ALIGNED_STRUCT(2) SnapshotPosition FLATBUFFERS_FINAL_CLASS {
+ private:
+  uint16_t net_id_;
+  uint16_t x_;
+  uint16_t y_;
+  uint16_t z_;
+
+ public:
+  SnapshotPosition() {
+    memset(this, 0, sizeof(SnapshotPosition));
+  }
+  SnapshotPosition(const SnapshotPosition &_o) {
+    memcpy(this, &_o, sizeof(SnapshotPosition));
+  }
+  SnapshotPosition(uint16_t _net_id, uint16_t _x, uint16_t _y, uint16_t _z)
+      : net_id_(flatbuffers::EndianScalar(_net_id)),
+        x_(flatbuffers::EndianScalar(_x)),
+        y_(flatbuffers::EndianScalar(_y)),
+        z_(flatbuffers::EndianScalar(_z)) {
+  }
+  uint16_t net_id() const {
+    return flatbuffers::EndianScalar(net_id_);
+  }
+  void mutate_net_id(uint16_t _net_id) {
+    flatbuffers::WriteScalar(&net_id_, _net_id);
+  }
+  uint16_t x() const {
+    return flatbuffers::EndianScalar(x_);
+  }
+  void mutate_x(uint16_t _x) {
+    flatbuffers::WriteScalar(&x_, _x);
+  }
+  uint16_t y() const {
+    return flatbuffers::EndianScalar(y_);
+  }
+  void mutate_y(uint16_t _y) {
+    flatbuffers::WriteScalar(&y_, _y);
+  }
+  uint16_t z() const {
+    return flatbuffers::EndianScalar(z_);
+  }
+  void mutate_z(uint16_t _z) {
+    flatbuffers::WriteScalar(&z_, _z);
+  }
+};
+STRUCT_END(SnapshotPosition, 8);
+
+MANUALLY_ALIGNED_STRUCT(2) SnapshotRotation FLATBUFFERS_FINAL_CLASS {
+ private:
+  uint16_t net_id_;
+  uint16_t rotation_;
+
+ public:
+  SnapshotRotation() {
+    memset(this, 0, sizeof(SnapshotRotation));
+  }
+  SnapshotRotation(const SnapshotRotation &_o) {
+    memcpy(this, &_o, sizeof(SnapshotRotation));
+  }
+  SnapshotRotation(uint16_t _net_id, uint16_t _rotation)
+      : net_id_(flatbuffers::EndianScalar(_net_id)),
+        rotation_(flatbuffers::EndianScalar(_rotation)) {
+  }
+  uint16_t net_id() const {
+    return flatbuffers::EndianScalar(net_id_);
+  }
+  void mutate_net_id(uint16_t _net_id) {
+    flatbuffers::WriteScalar(&net_id_, _net_id);
+  }
+  uint16_t rotation() const {
+    return flatbuffers::EndianScalar(rotation_);
+  }
+  void mutate_rotation(uint16_t _rotation) {
+    flatbuffers::WriteScalar(&rotation_, _rotation);
+  }
+};
+STRUCT_END(SnapshotRotation, 4);
+
+MANUALLY_ALIGNED_STRUCT(2) SnapshotVelocity FLATBUFFERS_FINAL_CLASS {
+ private:
+  uint16_t net_id_;
+  int16_t x_;
+  int16_t y_;
+  int16_t z_;
+
+ public:
+  SnapshotVelocity() {
+    memset(this, 0, sizeof(SnapshotVelocity));
+  }
+  SnapshotVelocity(const SnapshotVelocity &_o) {
+    memcpy(this, &_o, sizeof(SnapshotVelocity));
+  }
+  SnapshotVelocity(uint16_t _net_id, int16_t _x, int16_t _y, int16_t _z)
+      : net_id_(flatbuffers::EndianScalar(_net_id)),
+        x_(flatbuffers::EndianScalar(_x)),
+        y_(flatbuffers::EndianScalar(_y)),
+        z_(flatbuffers::EndianScalar(_z)) {
+  }
+  uint16_t net_id() const {
+    return flatbuffers::EndianScalar(net_id_);
+  }
+  void mutate_net_id(uint16_t _net_id) {
+    flatbuffers::WriteScalar(&net_id_, _net_id);
+  }
+  int16_t x() const {
+    return flatbuffers::EndianScalar(x_);
+  }
+  void mutate_x(int16_t _x) {
+    flatbuffers::WriteScalar(&x_, _x);
+  }
+  int16_t y() const {
+    return flatbuffers::EndianScalar(y_);
+  }
+  void mutate_y(int16_t _y) {
+    flatbuffers::WriteScalar(&y_, _y);
+  }
+  int16_t z() const {
+    return flatbuffers::EndianScalar(z_);
+  }
+  void mutate_z(int16_t _z) {
+    flatbuffers::WriteScalar(&z_, _z);
+  }
+};
+STRUCT_END(SnapshotVelocity, 8);
+
+}  // namespace World
+
 struct Notify_UnauthedAccessT : public flatbuffers::NativeTable {
   typedef Notify_UnauthedAccess TableType;
   Notify_UnauthedAccessT() {
@@ -2507,6 +2655,8 @@ struct MapDataT : public flatbuffers::NativeTable {
   int32_t map_id;
   ProtocolCS::MapType map_type;
   std::vector<std::unique_ptr<GateInfoT>> map_gates;
+  std::unique_ptr<ProtocolCS::Vec3> area_min;
+  std::unique_ptr<ProtocolCS::Vec3> area_max;
   MapDataT()
       : map_id(0),
         map_type(ProtocolCS::MapType::NONE) {
@@ -2519,7 +2669,9 @@ struct MapData FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
     VT_ENTITY_ID = 4,
     VT_MAP_ID = 6,
     VT_MAP_TYPE = 8,
-    VT_MAP_GATES = 10
+    VT_MAP_GATES = 10,
+    VT_AREA_MIN = 12,
+    VT_AREA_MAX = 14
   };
   const flatbuffers::String *entity_id() const {
     return GetPointer<const flatbuffers::String *>(VT_ENTITY_ID);
@@ -2545,6 +2697,18 @@ struct MapData FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   flatbuffers::Vector<flatbuffers::Offset<GateInfo>> *mutable_map_gates() {
     return GetPointer<flatbuffers::Vector<flatbuffers::Offset<GateInfo>> *>(VT_MAP_GATES);
   }
+  const ProtocolCS::Vec3 *area_min() const {
+    return GetStruct<const ProtocolCS::Vec3 *>(VT_AREA_MIN);
+  }
+  ProtocolCS::Vec3 *mutable_area_min() {
+    return GetStruct<ProtocolCS::Vec3 *>(VT_AREA_MIN);
+  }
+  const ProtocolCS::Vec3 *area_max() const {
+    return GetStruct<const ProtocolCS::Vec3 *>(VT_AREA_MAX);
+  }
+  ProtocolCS::Vec3 *mutable_area_max() {
+    return GetStruct<ProtocolCS::Vec3 *>(VT_AREA_MAX);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffset(verifier, VT_ENTITY_ID) &&
@@ -2554,6 +2718,8 @@ struct MapData FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            VerifyOffset(verifier, VT_MAP_GATES) &&
            verifier.Verify(map_gates()) &&
            verifier.VerifyVectorOfTables(map_gates()) &&
+           VerifyField<ProtocolCS::Vec3>(verifier, VT_AREA_MIN) &&
+           VerifyField<ProtocolCS::Vec3>(verifier, VT_AREA_MAX) &&
            verifier.EndTable();
   }
   MapDataT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
@@ -2576,13 +2742,19 @@ struct MapDataBuilder {
   void add_map_gates(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<GateInfo>>> map_gates) {
     fbb_.AddOffset(MapData::VT_MAP_GATES, map_gates);
   }
+  void add_area_min(const ProtocolCS::Vec3 *area_min) {
+    fbb_.AddStruct(MapData::VT_AREA_MIN, area_min);
+  }
+  void add_area_max(const ProtocolCS::Vec3 *area_max) {
+    fbb_.AddStruct(MapData::VT_AREA_MAX, area_max);
+  }
   MapDataBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
   }
   MapDataBuilder &operator=(const MapDataBuilder &);
   flatbuffers::Offset<MapData> Finish() {
-    const auto end = fbb_.EndTable(start_, 4);
+    const auto end = fbb_.EndTable(start_, 6);
     auto o = flatbuffers::Offset<MapData>(end);
     return o;
   }
@@ -2593,8 +2765,12 @@ inline flatbuffers::Offset<MapData> CreateMapData(
     flatbuffers::Offset<flatbuffers::String> entity_id = 0,
     int32_t map_id = 0,
     ProtocolCS::MapType map_type = ProtocolCS::MapType::NONE,
-    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<GateInfo>>> map_gates = 0) {
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<GateInfo>>> map_gates = 0,
+    const ProtocolCS::Vec3 *area_min = 0,
+    const ProtocolCS::Vec3 *area_max = 0) {
   MapDataBuilder builder_(_fbb);
+  builder_.add_area_max(area_max);
+  builder_.add_area_min(area_min);
   builder_.add_map_gates(map_gates);
   builder_.add_map_type(map_type);
   builder_.add_map_id(map_id);
@@ -2607,13 +2783,17 @@ inline flatbuffers::Offset<MapData> CreateMapDataDirect(
     const char *entity_id = nullptr,
     int32_t map_id = 0,
     ProtocolCS::MapType map_type = ProtocolCS::MapType::NONE,
-    const std::vector<flatbuffers::Offset<GateInfo>> *map_gates = nullptr) {
+    const std::vector<flatbuffers::Offset<GateInfo>> *map_gates = nullptr,
+    const ProtocolCS::Vec3 *area_min = 0,
+    const ProtocolCS::Vec3 *area_max = 0) {
   return ProtocolCS::World::CreateMapData(
       _fbb,
       entity_id ? _fbb.CreateString(entity_id) : 0,
       map_id,
       map_type,
-      map_gates ? _fbb.CreateVector<flatbuffers::Offset<GateInfo>>(*map_gates) : 0);
+      map_gates ? _fbb.CreateVector<flatbuffers::Offset<GateInfo>>(*map_gates) : 0,
+      area_min,
+      area_max);
 }
 
 flatbuffers::Offset<MapData> CreateMapData(flatbuffers::FlatBufferBuilder &_fbb, const MapDataT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
@@ -3231,6 +3411,105 @@ inline flatbuffers::Offset<AttributeInfo> CreateAttributeInfoDirect(
 
 flatbuffers::Offset<AttributeInfo> CreateAttributeInfo(flatbuffers::FlatBufferBuilder &_fbb, const AttributeInfoT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
 
+struct MoveSnapshotT : public flatbuffers::NativeTable {
+  typedef MoveSnapshot TableType;
+  std::vector<SnapshotPosition> positions;
+  std::vector<SnapshotRotation> rotations;
+  std::vector<SnapshotVelocity> velocities;
+  MoveSnapshotT() {
+  }
+};
+
+struct MoveSnapshot FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef MoveSnapshotT NativeTableType;
+  enum {
+    VT_POSITIONS = 4,
+    VT_ROTATIONS = 6,
+    VT_VELOCITIES = 8
+  };
+  const flatbuffers::Vector<const SnapshotPosition *> *positions() const {
+    return GetPointer<const flatbuffers::Vector<const SnapshotPosition *> *>(VT_POSITIONS);
+  }
+  flatbuffers::Vector<const SnapshotPosition *> *mutable_positions() {
+    return GetPointer<flatbuffers::Vector<const SnapshotPosition *> *>(VT_POSITIONS);
+  }
+  const flatbuffers::Vector<const SnapshotRotation *> *rotations() const {
+    return GetPointer<const flatbuffers::Vector<const SnapshotRotation *> *>(VT_ROTATIONS);
+  }
+  flatbuffers::Vector<const SnapshotRotation *> *mutable_rotations() {
+    return GetPointer<flatbuffers::Vector<const SnapshotRotation *> *>(VT_ROTATIONS);
+  }
+  const flatbuffers::Vector<const SnapshotVelocity *> *velocities() const {
+    return GetPointer<const flatbuffers::Vector<const SnapshotVelocity *> *>(VT_VELOCITIES);
+  }
+  flatbuffers::Vector<const SnapshotVelocity *> *mutable_velocities() {
+    return GetPointer<flatbuffers::Vector<const SnapshotVelocity *> *>(VT_VELOCITIES);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_POSITIONS) &&
+           verifier.Verify(positions()) &&
+           VerifyOffset(verifier, VT_ROTATIONS) &&
+           verifier.Verify(rotations()) &&
+           VerifyOffset(verifier, VT_VELOCITIES) &&
+           verifier.Verify(velocities()) &&
+           verifier.EndTable();
+  }
+  MoveSnapshotT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  void UnPackTo(MoveSnapshotT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  static flatbuffers::Offset<MoveSnapshot> Pack(flatbuffers::FlatBufferBuilder &_fbb, const MoveSnapshotT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+};
+
+struct MoveSnapshotBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_positions(flatbuffers::Offset<flatbuffers::Vector<const SnapshotPosition *>> positions) {
+    fbb_.AddOffset(MoveSnapshot::VT_POSITIONS, positions);
+  }
+  void add_rotations(flatbuffers::Offset<flatbuffers::Vector<const SnapshotRotation *>> rotations) {
+    fbb_.AddOffset(MoveSnapshot::VT_ROTATIONS, rotations);
+  }
+  void add_velocities(flatbuffers::Offset<flatbuffers::Vector<const SnapshotVelocity *>> velocities) {
+    fbb_.AddOffset(MoveSnapshot::VT_VELOCITIES, velocities);
+  }
+  MoveSnapshotBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  MoveSnapshotBuilder &operator=(const MoveSnapshotBuilder &);
+  flatbuffers::Offset<MoveSnapshot> Finish() {
+    const auto end = fbb_.EndTable(start_, 3);
+    auto o = flatbuffers::Offset<MoveSnapshot>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<MoveSnapshot> CreateMoveSnapshot(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::Vector<const SnapshotPosition *>> positions = 0,
+    flatbuffers::Offset<flatbuffers::Vector<const SnapshotRotation *>> rotations = 0,
+    flatbuffers::Offset<flatbuffers::Vector<const SnapshotVelocity *>> velocities = 0) {
+  MoveSnapshotBuilder builder_(_fbb);
+  builder_.add_velocities(velocities);
+  builder_.add_rotations(rotations);
+  builder_.add_positions(positions);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<MoveSnapshot> CreateMoveSnapshotDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const std::vector<const SnapshotPosition *> *positions = nullptr,
+    const std::vector<const SnapshotRotation *> *rotations = nullptr,
+    const std::vector<const SnapshotVelocity *> *velocities = nullptr) {
+  return ProtocolCS::World::CreateMoveSnapshot(
+      _fbb,
+      positions ? _fbb.CreateVector<const SnapshotPosition *>(*positions) : 0,
+      rotations ? _fbb.CreateVector<const SnapshotRotation *>(*rotations) : 0,
+      velocities ? _fbb.CreateVector<const SnapshotVelocity *>(*velocities) : 0);
+}
+
+flatbuffers::Offset<MoveSnapshot> CreateMoveSnapshot(flatbuffers::FlatBufferBuilder &_fbb, const MoveSnapshotT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+
 struct Request_LoginT : public flatbuffers::NativeTable {
   typedef Request_Login TableType;
   std::string credential;
@@ -3824,14 +4103,17 @@ flatbuffers::Offset<Request_Respawn> CreateRequest_Respawn(flatbuffers::FlatBuff
 struct Notify_AppearT : public flatbuffers::NativeTable {
   typedef Notify_Appear TableType;
   std::unique_ptr<ActorT> entity;
-  Notify_AppearT() {
+  uint16_t net_id;
+  Notify_AppearT()
+      : net_id(0) {
   }
 };
 
 struct Notify_Appear FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   typedef Notify_AppearT NativeTableType;
   enum {
-    VT_ENTITY = 4
+    VT_ENTITY = 4,
+    VT_NET_ID = 6
   };
   const Actor *entity() const {
     return GetPointer<const Actor *>(VT_ENTITY);
@@ -3839,10 +4121,17 @@ struct Notify_Appear FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   Actor *mutable_entity() {
     return GetPointer<Actor *>(VT_ENTITY);
   }
+  uint16_t net_id() const {
+    return GetField<uint16_t>(VT_NET_ID, 0);
+  }
+  bool mutate_net_id(uint16_t _net_id) {
+    return SetField<uint16_t>(VT_NET_ID, _net_id, 0);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffset(verifier, VT_ENTITY) &&
            verifier.VerifyTable(entity()) &&
+           VerifyField<uint16_t>(verifier, VT_NET_ID) &&
            verifier.EndTable();
   }
   Notify_AppearT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
@@ -3856,13 +4145,16 @@ struct Notify_AppearBuilder {
   void add_entity(flatbuffers::Offset<Actor> entity) {
     fbb_.AddOffset(Notify_Appear::VT_ENTITY, entity);
   }
+  void add_net_id(uint16_t net_id) {
+    fbb_.AddElement<uint16_t>(Notify_Appear::VT_NET_ID, net_id, 0);
+  }
   Notify_AppearBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
   }
   Notify_AppearBuilder &operator=(const Notify_AppearBuilder &);
   flatbuffers::Offset<Notify_Appear> Finish() {
-    const auto end = fbb_.EndTable(start_, 1);
+    const auto end = fbb_.EndTable(start_, 2);
     auto o = flatbuffers::Offset<Notify_Appear>(end);
     return o;
   }
@@ -3870,9 +4162,11 @@ struct Notify_AppearBuilder {
 
 inline flatbuffers::Offset<Notify_Appear> CreateNotify_Appear(
     flatbuffers::FlatBufferBuilder &_fbb,
-    flatbuffers::Offset<Actor> entity = 0) {
+    flatbuffers::Offset<Actor> entity = 0,
+    uint16_t net_id = 0) {
   Notify_AppearBuilder builder_(_fbb);
   builder_.add_entity(entity);
+  builder_.add_net_id(net_id);
   return builder_.Finish();
 }
 
@@ -3992,6 +4286,9 @@ struct Notify_Update FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   const AttributeInfo *update_data_as_AttributeInfo() const {
     return update_data_type() == UpdateType::AttributeInfo ? static_cast<const AttributeInfo *>(update_data()) : nullptr;
   }
+  const MoveSnapshot *update_data_as_MoveSnapshot() const {
+    return update_data_type() == UpdateType::MoveSnapshot ? static_cast<const MoveSnapshot *>(update_data()) : nullptr;
+  }
   void *mutable_update_data() {
     return GetPointer<void *>(VT_UPDATE_DATA);
   }
@@ -4033,6 +4330,10 @@ template<> inline const AttributeInfo *Notify_Update::update_data_as<AttributeIn
   return update_data_as_AttributeInfo();
 }
 
+template<> inline const MoveSnapshot *Notify_Update::update_data_as<MoveSnapshot>() const {
+  return update_data_as_MoveSnapshot();
+}
+
 struct Notify_UpdateBuilder {
   flatbuffers::FlatBufferBuilder &fbb_;
   flatbuffers::uoffset_t start_;
@@ -5054,6 +5355,8 @@ inline void MapData::UnPackTo(MapDataT *_o, const flatbuffers::resolver_function
   { auto _e = map_id(); _o->map_id = _e; };
   { auto _e = map_type(); _o->map_type = _e; };
   { auto _e = map_gates(); if (_e) { _o->map_gates.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->map_gates[_i] = std::unique_ptr<GateInfoT>(_e->Get(_i)->UnPack(_resolver)); } } };
+  { auto _e = area_min(); if (_e) _o->area_min = std::unique_ptr<ProtocolCS::Vec3>(new ProtocolCS::Vec3(*_e)); };
+  { auto _e = area_max(); if (_e) _o->area_max = std::unique_ptr<ProtocolCS::Vec3>(new ProtocolCS::Vec3(*_e)); };
 }
 
 inline flatbuffers::Offset<MapData> MapData::Pack(flatbuffers::FlatBufferBuilder &_fbb, const MapDataT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
@@ -5067,12 +5370,16 @@ inline flatbuffers::Offset<MapData> CreateMapData(flatbuffers::FlatBufferBuilder
   auto _map_id = _o->map_id;
   auto _map_type = _o->map_type;
   auto _map_gates = _o->map_gates.size() ? _fbb.CreateVector<flatbuffers::Offset<GateInfo>>(_o->map_gates.size(), [&](size_t i) { return CreateGateInfo(_fbb, _o->map_gates[i].get(), _rehasher); }) : 0;
+  auto _area_min = _o->area_min ? _o->area_min.get() : 0;
+  auto _area_max = _o->area_max ? _o->area_max.get() : 0;
   return ProtocolCS::World::CreateMapData(
       _fbb,
       _entity_id,
       _map_id,
       _map_type,
-      _map_gates);
+      _map_gates,
+      _area_min,
+      _area_max);
 }
 
 inline ActorT *Actor::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
@@ -5264,6 +5571,37 @@ inline flatbuffers::Offset<AttributeInfo> CreateAttributeInfo(flatbuffers::FlatB
       _mp);
 }
 
+inline MoveSnapshotT *MoveSnapshot::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
+  auto _o = new MoveSnapshotT();
+  UnPackTo(_o, _resolver);
+  return _o;
+}
+
+inline void MoveSnapshot::UnPackTo(MoveSnapshotT *_o, const flatbuffers::resolver_function_t *_resolver) const {
+  (void)_o;
+  (void)_resolver;
+  { auto _e = positions(); if (_e) { _o->positions.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->positions[_i] = *_e->Get(_i); } } };
+  { auto _e = rotations(); if (_e) { _o->rotations.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->rotations[_i] = *_e->Get(_i); } } };
+  { auto _e = velocities(); if (_e) { _o->velocities.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->velocities[_i] = *_e->Get(_i); } } };
+}
+
+inline flatbuffers::Offset<MoveSnapshot> MoveSnapshot::Pack(flatbuffers::FlatBufferBuilder &_fbb, const MoveSnapshotT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
+  return CreateMoveSnapshot(_fbb, _o, _rehasher);
+}
+
+inline flatbuffers::Offset<MoveSnapshot> CreateMoveSnapshot(flatbuffers::FlatBufferBuilder &_fbb, const MoveSnapshotT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
+  (void)_rehasher;
+  (void)_o;
+  auto _positions = _o->positions.size() ? _fbb.CreateVectorOfStructs(_o->positions) : 0;
+  auto _rotations = _o->rotations.size() ? _fbb.CreateVectorOfStructs(_o->rotations) : 0;
+  auto _velocities = _o->velocities.size() ? _fbb.CreateVectorOfStructs(_o->velocities) : 0;
+  return ProtocolCS::World::CreateMoveSnapshot(
+      _fbb,
+      _positions,
+      _rotations,
+      _velocities);
+}
+
 inline Request_LoginT *Request_Login::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
   auto _o = new Request_LoginT();
   UnPackTo(_o, _resolver);
@@ -5511,6 +5849,7 @@ inline void Notify_Appear::UnPackTo(Notify_AppearT *_o, const flatbuffers::resol
   (void)_o;
   (void)_resolver;
   { auto _e = entity(); if (_e) _o->entity = std::unique_ptr<ActorT>(_e->UnPack(_resolver)); };
+  { auto _e = net_id(); _o->net_id = _e; };
 }
 
 inline flatbuffers::Offset<Notify_Appear> Notify_Appear::Pack(flatbuffers::FlatBufferBuilder &_fbb, const Notify_AppearT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
@@ -5521,9 +5860,11 @@ inline flatbuffers::Offset<Notify_Appear> CreateNotify_Appear(flatbuffers::FlatB
   (void)_rehasher;
   (void)_o;
   auto _entity = _o->entity ? CreateActor(_fbb, _o->entity.get(), _rehasher) : 0;
+  auto _net_id = _o->net_id;
   return ProtocolCS::World::CreateNotify_Appear(
       _fbb,
-      _entity);
+      _entity,
+      _net_id);
 }
 
 inline Notify_DisappearT *Notify_Disappear::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
@@ -5782,6 +6123,10 @@ inline bool VerifyUpdateType(flatbuffers::Verifier &verifier, const void *obj, U
       auto ptr = reinterpret_cast<const AttributeInfo *>(obj);
       return verifier.VerifyTable(ptr);
     }
+    case UpdateType::MoveSnapshot: {
+      auto ptr = reinterpret_cast<const MoveSnapshot *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
     default: return false;
   }
 }
@@ -5823,6 +6168,10 @@ inline void *UpdateTypeUnion::UnPack(const void *obj, UpdateType type, const fla
       auto ptr = reinterpret_cast<const AttributeInfo *>(obj);
       return ptr->UnPack(resolver);
     }
+    case UpdateType::MoveSnapshot: {
+      auto ptr = reinterpret_cast<const MoveSnapshot *>(obj);
+      return ptr->UnPack(resolver);
+    }
     default: return nullptr;
   }
 }
@@ -5853,6 +6202,10 @@ inline flatbuffers::Offset<void> UpdateTypeUnion::Pack(flatbuffers::FlatBufferBu
       auto ptr = reinterpret_cast<const AttributeInfoT *>(value);
       return CreateAttributeInfo(_fbb, ptr, _rehasher).Union();
     }
+    case UpdateType::MoveSnapshot: {
+      auto ptr = reinterpret_cast<const MoveSnapshotT *>(value);
+      return CreateMoveSnapshot(_fbb, ptr, _rehasher).Union();
+    }
     default: return 0;
   }
 }
@@ -5883,6 +6236,10 @@ inline UpdateTypeUnion::UpdateTypeUnion(const UpdateTypeUnion &u) FLATBUFFERS_NO
       value = new AttributeInfoT(*reinterpret_cast<AttributeInfoT *>(u.value));
       break;
     }
+    case UpdateType::MoveSnapshot: {
+      value = new MoveSnapshotT(*reinterpret_cast<MoveSnapshotT *>(u.value));
+      break;
+    }
     default:
       break;
   }
@@ -5920,6 +6277,11 @@ inline void UpdateTypeUnion::Reset() {
       delete ptr;
       break;
     }
+    case UpdateType::MoveSnapshot: {
+      auto ptr = reinterpret_cast<MoveSnapshotT *>(value);
+      delete ptr;
+      break;
+    }
     default: break;
   }
   value = nullptr;
@@ -337,8 +337,10 @@ struct Request_LoginT : public flatbuffers::NativeTable {
   typedef Request_Login TableType;
   std::string client_name;
   int32_t client_type;
+  int32_t link_session_id;
   Request_LoginT()
-      : client_type(0) {
+      : client_type(0),
+        link_session_id(0) {
   }
 };
 
@@ -346,7 +348,8 @@ struct Request_Login FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   typedef Request_LoginT NativeTableType;
   enum {
     VT_CLIENT_NAME = 4,
-    VT_CLIENT_TYPE = 6
+    VT_CLIENT_TYPE = 6,
+    VT_LINK_SESSION_ID = 8
   };
   const flatbuffers::String *client_name() const {
     return GetPointer<const flatbuffers::String *>(VT_CLIENT_NAME);
@@ -360,11 +363,18 @@ struct Request_Login FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   bool mutate_client_type(int32_t _client_type) {
     return SetField<int32_t>(VT_CLIENT_TYPE, _client_type, 0);
   }
+  int32_t link_session_id() const {
+    return GetField<int32_t>(VT_LINK_SESSION_ID, 0);
+  }
+  bool mutate_link_session_id(int32_t _link_session_id) {
+    return SetField<int32_t>(VT_LINK_SESSION_ID, _link_session_id, 0);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffset(verifier, VT_CLIENT_NAME) &&
            verifier.Verify(client_name()) &&
            VerifyField<int32_t>(verifier, VT_CLIENT_TYPE) &&
+           VerifyField<int32_t>(verifier, VT_LINK_SESSION_ID) &&
            verifier.EndTable();
   }
   Request_LoginT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
@@ -381,13 +391,16 @@ struct Request_LoginBuilder {
   void add_client_type(int32_t client_type) {
     fbb_.AddElement<int32_t>(Request_Login::VT_CLIENT_TYPE, client_type, 0);
   }
+  void add_link_session_id(int32_t link_session_id) {
+    fbb_.AddElement<int32_t>(Request_Login::VT_LINK_SESSION_ID, link_session_id, 0);
+  }
   Request_LoginBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
   }
   Request_LoginBuilder &operator=(const Request_LoginBuilder &);
   flatbuffers::Offset<Request_Login> Finish() {
-    const auto end = fbb_.EndTable(start_, 2);
+    const auto end = fbb_.EndTable(start_, 3);
     auto o = flatbuffers::Offset<Request_Login>(end);
     return o;
   }
@@ -396,8 +409,10 @@ struct Request_LoginBuilder {
 inline flatbuffers::Offset<Request_Login> CreateRequest_Login(
     flatbuffers::FlatBufferBuilder &_fbb,
     flatbuffers::Offset<flatbuffers::String> client_name = 0,
-    int32_t client_type = 0) {
+    int32_t client_type = 0,
+    int32_t link_session_id = 0) {
   Request_LoginBuilder builder_(_fbb);
+  builder_.add_link_session_id(link_session_id);
   builder_.add_client_type(client_type);
   builder_.add_client_name(client_name);
   return builder_.Finish();
@@ -406,11 +421,13 @@ inline flatbuffers::Offset<Request_Login> CreateRequest_Login(
 inline flatbuffers::Offset<Request_Login> CreateRequest_LoginDirect(
     flatbuffers::FlatBufferBuilder &_fbb,
     const char *client_name = nullptr,
-    int32_t client_type = 0) {
+    int32_t client_type = 0,
+    int32_t link_session_id = 0) {
   return ProtocolSS::CreateRequest_Login(
       _fbb,
       client_name ? _fbb.CreateString(client_name) : 0,
-      client_type);
+      client_type,
+      link_session_id);
 }
 
 flatbuffers::Offset<Request_Login> CreateRequest_Login(flatbuffers::FlatBufferBuilder &_fbb, const Request_LoginT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
@@ -1256,7 +1273,9 @@ flatbuffers::Offset<RelayMessage> CreateRelayMessage(flatbuffers::FlatBufferBuil
 struct MessageRootT : public flatbuffers::NativeTable {
   typedef MessageRoot TableType;
   MessageTypeUnion message;
-  MessageRootT() {
+  uint32_t correlation_id;
+  MessageRootT()
+      : correlation_id(0) {
   }
 };
 
@@ -1264,7 +1283,8 @@ struct MessageRoot FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   typedef MessageRootT NativeTableType;
   enum {
     VT_MESSAGE_TYPE = 4,
-    VT_MESSAGE = 6
+    VT_MESSAGE = 6,
+    VT_CORRELATION_ID = 8
   };
   MessageType message_type() const {
     return static_cast<MessageType>(GetField<uint8_t>(VT_MESSAGE_TYPE, 0));
@@ -1312,11 +1332,18 @@ struct MessageRoot FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   void *mutable_message() {
     return GetPointer<void *>(VT_MESSAGE);
   }
+  uint32_t correlation_id() const {
+    return GetField<uint32_t>(VT_CORRELATION_ID, 0);
+  }
+  bool mutate_correlation_id(uint32_t _correlation_id) {
+    return SetField<uint32_t>(VT_CORRELATION_ID, _correlation_id, 0);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<uint8_t>(verifier, VT_MESSAGE_TYPE) &&
            VerifyOffset(verifier, VT_MESSAGE) &&
            VerifyMessageType(verifier, message(), message_type()) &&
+           VerifyField<uint32_t>(verifier, VT_CORRELATION_ID) &&
            verifier.EndTable();
   }
   MessageRootT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
@@ -1377,13 +1404,16 @@ struct MessageRootBuilder {
   void add_message(flatbuffers::Offset<void> message) {
     fbb_.AddOffset(MessageRoot::VT_MESSAGE, message);
   }
+  void add_correlation_id(uint32_t correlation_id) {
+    fbb_.AddElement<uint32_t>(MessageRoot::VT_CORRELATION_ID, correlation_id, 0);
+  }
   MessageRootBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
   }
   MessageRootBuilder &operator=(const MessageRootBuilder &);
   flatbuffers::Offset<MessageRoot> Finish() {
-    const auto end = fbb_.EndTable(start_, 2);
+    const auto end = fbb_.EndTable(start_, 3);
     auto o = flatbuffers::Offset<MessageRoot>(end);
     return o;
   }
@@ -1392,8 +1422,10 @@ struct MessageRootBuilder {
 inline flatbuffers::Offset<MessageRoot> CreateMessageRoot(
     flatbuffers::FlatBufferBuilder &_fbb,
     MessageType message_type = MessageType::NONE,
-    flatbuffers::Offset<void> message = 0) {
+    flatbuffers::Offset<void> message = 0,
+    uint32_t correlation_id = 0) {
   MessageRootBuilder builder_(_fbb);
+  builder_.add_correlation_id(correlation_id);
   builder_.add_message(message);
   builder_.add_message_type(message_type);
   return builder_.Finish();
@@ -1459,6 +1491,7 @@ inline void Request_Login::UnPackTo(Request_LoginT *_o, const flatbuffers::resol
   (void)_resolver;
   { auto _e = client_name(); if (_e) _o->client_name = _e->str(); };
   { auto _e = client_type(); _o->client_type = _e; };
+  { auto _e = link_session_id(); _o->link_session_id = _e; };
 }
 
 inline flatbuffers::Offset<Request_Login> Request_Login::Pack(flatbuffers::FlatBufferBuilder &_fbb, const Request_LoginT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
@@ -1470,10 +1503,12 @@ inline flatbuffers::Offset<Request_Login> CreateRequest_Login(flatbuffers::FlatB
   (void)_o;
   auto _client_name = _o->client_name.size() ? _fbb.CreateString(_o->client_name) : 0;
   auto _client_type = _o->client_type;
+  auto _link_session_id = _o->link_session_id;
   return ProtocolSS::CreateRequest_Login(
       _fbb,
       _client_name,
-      _client_type);
+      _client_type,
+      _link_session_id);
 }
 
 inline Reply_LoginT *Reply_Login::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
@@ -1748,6 +1783,7 @@ inline void MessageRoot::UnPackTo(MessageRootT *_o, const flatbuffers::resolver_
   (void)_resolver;
   { auto _e = message_type(); _o->message.type = _e; };
   { auto _e = message(); if (_e) _o->message.value = MessageTypeUnion::UnPack(_e, message_type(), _resolver); };
+  { auto _e = correlation_id(); _o->correlation_id = _e; };
 }
 
 inline flatbuffers::Offset<MessageRoot> MessageRoot::Pack(flatbuffers::FlatBufferBuilder &_fbb, const MessageRootT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
@@ -1759,10 +1795,12 @@ inline flatbuffers::Offset<MessageRoot> CreateMessageRoot(flatbuffers::FlatBuffe
   (void)_o;
   auto _message_type = _o->message.type;
   auto _message = _o->message.Pack(_fbb);
+  auto _correlation_id = _o->correlation_id;
   return ProtocolSS::CreateMessageRoot(
       _fbb,
       _message_type,
-      _message);
+      _message,
+      _correlation_id);
 }
 
 inline bool VerifyMessageType(flatbuffers::Verifier &verifier, const void *obj, MessageType type) {
@@ -1,31 +1,658 @@
 // TestClient.cpp : Defines the entry point for the console application.
 //
+// TestServer 에 접속해서 시나리오를 실행하고 결과를 JSON 으로 출력하는 벤치마크.
+//   echo   : 연결마다 ping-pong 을 messages 번. 왕복 지연시간 p50/p99/p999.
+//   fanout : 서버가 모든 연결에 messages 개씩 보낸다. 받는 쪽 처리량.
+//   ingest : 모든 연결이 messages 개씩 보낸다. 서버가 받은 처리량.
+//   churn  : 연결 connections 개를 유지하면서 접속/종료를 messages 번. 접속 후 첫 응답까지의 시간.
+//
+//   TestClient --scenario echo --connections 100 --size 64 --messages 10000 --output result.json
+//
 
 #include "stdafx.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <mutex>
+#include <algorithm>
+#include <condition_variable>
+#include <boost/program_options.hpp>
+#include <boost/log/expressions.hpp>
 #include <network.h>
+#include "../TestServer/BenchProtocol.h"
+#include "../TestServer/AllocationCounter.h"
+
+namespace po = boost::program_options;
+using Clock = std::chrono::steady_clock;
+
+struct Options
+{
+    std::string scenario;
+    std::string host;
+    std::string port;
+    size_t connections;
+    size_t threads;
+    size_t message_size;
+    size_t messages;
+    size_t timeout;
+    bool no_delay;
+    std::string output;
+};
+
+struct Result
+{
+    bool ok = true;
+    double elapsed_sec = 0;
+    uint64_t messages = 0;
+    uint64_t bytes = 0;
+    uint64_t server_messages = 0;
+    uint64_t heap_allocations = 0;          // 측정 구간의 전체 힙 할당.
+    uint64_t handler_heap_allocations = 0;  // 그중 완료 핸들러가 재사용하지 못한 할당.
+    uint64_t server_heap_allocations = 0;   // 측정 구간의 서버 힙 할당.
+    std::vector<uint64_t> latency_ns;
+};
+
+// 측정 구간의 힙 할당 횟수.
+class AllocationCounter
+{
+public:
+    AllocationCounter()
+        : heap_(g_heap_allocations.load())
+        , handler_(net::HandlerMemory::GetHeapAllocationCount())
+    {
+    }
+
+    void Stop(Result& result) const
+    {
+        result.heap_allocations = g_heap_allocations.load() - heap_;
+        result.handler_heap_allocations = net::HandlerMemory::GetHeapAllocationCount() - handler_;
+    }
+
+private:
+    uint64_t heap_;
+    uint64_t handler_;
+};
+
+struct Connection
+{
+    Ptr<net::NetClient> client;
+    uint64_t received = 0;
+    std::vector<uint64_t> latency_ns;
+    std::vector<uint8_t> payload;
+};
 
-void OnEvent(net::NetEventType ev)
+// 카운트가 0 이 될때까지 기다린다.
+class Latch
 {
-    BOOST_LOG_TRIVIAL(info) << "OnEvent " << static_cast<int>(ev);
+public:
+    explicit Latch(size_t count)
+        : count_(count)
+    {
+    }
+
+    void CountDown()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (count_ > 0 && --count_ == 0)
+            cv_.notify_all();
+    }
+
+    bool WaitFor(size_t seconds)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, std::chrono::seconds(seconds), [this] { return count_ == 0; });
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    size_t count_;
+};
+
+uint64_t NowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+double Seconds(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
 }
 
-void OnMessage(const uint8_t* buf, size_t size)
+std::vector<uint8_t> MakePayload(bench::Op op, size_t size)
 {
-    BOOST_LOG_TRIVIAL(info) << "OnMessage";
+    std::vector<uint8_t> payload(std::max<size_t>(size, 1 + sizeof(uint64_t)), 0);
+    payload[0] = op;
+    return payload;
 }
 
-int main()
+Ptr<net::NetClient> CreateClient(const Ptr<net::EventLoop>& event_loop, const Options& options)
 {
-    auto event_loop = std::make_shared<net::EventLoop>(2);
     net::ClientConfig config;
     config.event_loop = event_loop;
+    config.no_delay = options.no_delay;
+    return net::NetClient::Create(config);
+}
 
-    auto client = net::NetClient::Create(config);
-    client->RegisterNetEventHandler(OnEvent);
-    client->RegisterMessageHandler(OnMessage);
+// 서버의 Stats 응답.
+struct ServerStats
+{
+    uint64_t messages = 0;          // Ingest 로 받은 메시지 수.
+    uint64_t bytes = 0;
+    uint64_t heap_allocations = 0;  // 서버 프로세스의 전체 힙 할당 수.
+};
+
+bool ReadServerStats(const uint8_t* buf, size_t size, ServerStats& stats)
+{
+    if (size < bench::STATS_REPLY_SIZE || buf[0] != bench::Stats)
+        return false;
 
-    client->Connect("127.0.0.1", "8888");
+    stats.messages = bench::Read<uint64_t>(buf, 1);
+    stats.bytes = bench::Read<uint64_t>(buf, 9);
+    stats.heap_allocations = bench::Read<uint64_t>(buf, 17);
+    return true;
+}
+
+// 측정하는 연결과 따로 접속해서 서버 통계를 요청한다.
+class ServerStatsQuery
+{
+public:
+    bool Connect(const Ptr<net::EventLoop>& event_loop, const Options& options)
+    {
+        timeout_ = options.timeout;
+        client_ = CreateClient(event_loop, options);
+        auto opened = std::make_shared<Latch>(1);
+        client_->RegisterNetEventHandler([opened](const net::NetEventType& ev)
+        {
+            if (ev == net::NetEventType::Opened)
+                opened->CountDown();
+        });
+        client_->RegisterMessageHandler([this](uint16_t /*message_type*/, const uint8_t* buf, size_t size)
+        {
+            ServerStats stats;
+            if (!ReadServerStats(buf, size, stats))
+                return;
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            stats_ = stats;
+            replies_++;
+            cv_.notify_all();
+        });
+        client_->Connect(options.host, options.port);
+        return opened->WaitFor(timeout_);
+    }
+
+    bool Query(ServerStats& stats)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        size_t expected = replies_ + 1;
+        uint8_t request = bench::Stats;
+        client_->Send(&request, 1);
+        if (!cv_.wait_for(lock, std::chrono::seconds(timeout_), [&] { return replies_ >= expected; }))
+            return false;
+
+        stats = stats_;
+        return true;
+    }
+
+    // 서버가 스레드 사용률을 로그로 남긴다. 응답은 없다.
+    void LogThreadStats()
+    {
+        uint8_t request = bench::ThreadStats;
+        client_->Send(&request, 1);
+    }
+
+    void Close()
+    {
+        if (client_)
+            client_->Close();
+    }
+
+private:
+    Ptr<net::NetClient> client_;
+    size_t timeout_ = 0;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    ServerStats stats_;
+    size_t replies_ = 0;
+};
+
+// 측정 구간의 서버 힙 할당 횟수.
+class ServerAllocationCounter
+{
+public:
+    bool Start(const Ptr<net::EventLoop>& event_loop, const Options& options)
+    {
+        return query_.Connect(event_loop, options) && query_.Query(start_);
+    }
+
+    // 측정이 끝났을때 한번 서버 스레드 사용률도 남긴다.
+    void Stop(Result& result)
+    {
+        ServerStats stats;
+        query_.LogThreadStats();
+        if (query_.Query(stats))
+            result.server_heap_allocations = stats.heap_allocations - start_.heap_allocations;
+        query_.Close();
+    }
+
+private:
+    ServerStatsQuery query_;
+    ServerStats start_;
+};
+
+// connections 개를 접속시킨다. handler 는 접속 전에 등록해야 한다.
+bool ConnectAll(std::vector<Connection>& connections, const Options& options, const std::function<void(Connection&, const uint8_t*, size_t)>& handler)
+{
+    auto opened = std::make_shared<Latch>(connections.size());
+    for (auto& conn : connections)
+    {
+        Connection* c = &conn;
+        conn.client->RegisterMessageHandler([c, handler](uint16_t /*message_type*/, const uint8_t* buf, size_t size)
+        {
+            handler(*c, buf, size);
+        });
+        conn.client->RegisterNetEventHandler([opened](const net::NetEventType& ev)
+        {
+            if (ev == net::NetEventType::Opened)
+                opened->CountDown();
+        });
+        conn.client->Connect(options.host, options.port);
+    }
+    return opened->WaitFor(options.timeout);
+}
+
+Result RunEcho(const Ptr<net::EventLoop>& event_loop, const Options& options)
+{
+    Result result;
+    std::vector<Connection> connections(options.connections);
+    for (auto& conn : connections)
+    {
+        conn.client = CreateClient(event_loop, options);
+        conn.latency_ns.reserve(options.messages);
+        conn.payload = MakePayload(bench::Echo, options.message_size);
+    }
+
+    Latch done(connections.size());
+    auto ping = [](Connection& conn)
+    {
+        bench::Write<uint64_t>(conn.payload.data(), 1, NowNs());
+        conn.client->Send(conn.payload.data(), conn.payload.size());
+    };
+
+    // 응답은 연결의 strand 에서 처리되므로 연결별 데이터에 락이 필요없다.
+    auto on_message = [&](Connection& conn, const uint8_t* buf, size_t /*size*/)
+    {
+        conn.latency_ns.emplace_back(NowNs() - bench::Read<uint64_t>(buf, 1));
+        if (++conn.received < options.messages)
+        {
+            ping(conn);
+        }
+        else
+        {
+            done.CountDown();
+        }
+    };
+
+    ServerAllocationCounter server_allocations;
+    if (!ConnectAll(connections, options, on_message) || !server_allocations.Start(event_loop, options))
+    {
+        result.ok = false;
+        return result;
+    }
+
+    AllocationCounter allocations;
+    auto start = Clock::now();
+    for (auto& conn : connections)
+    {
+        ping(conn);
+    }
+    result.ok = done.WaitFor(options.timeout);
+    result.elapsed_sec = Seconds(start);
+    allocations.Stop(result);
+    server_allocations.Stop(result);
+
+    for (auto& conn : connections)
+    {
+        conn.client->Close();
+    }
+    event_loop->Stop();
     event_loop->Wait();
 
-    return 0;
+    for (auto& conn : connections)
+    {
+        result.messages += conn.received;
+        result.latency_ns.insert(result.latency_ns.end(), conn.latency_ns.begin(), conn.latency_ns.end());
+    }
+    result.bytes = result.messages * connections[0].payload.size();
+    return result;
+}
+
+Result RunFanOut(const Ptr<net::EventLoop>& event_loop, const Options& options)
+{
+    Result result;
+    std::vector<Connection> connections(options.connections);
+    for (auto& conn : connections)
+    {
+        conn.client = CreateClient(event_loop, options);
+    }
+
+    Latch done(connections.size());
+    auto on_message = [&](Connection& conn, const uint8_t* buf, size_t /*size*/)
+    {
+        if (buf[0] != bench::FanOutData)
+            return;
+
+        if (++conn.received == options.messages)
+            done.CountDown();
+    };
+
+    ServerAllocationCounter server_allocations;
+    if (!ConnectAll(connections, options, on_message) || !server_allocations.Start(event_loop, options))
+    {
+        result.ok = false;
+        return result;
+    }
+
+    uint8_t request[9];
+    request[0] = bench::FanOut;
+    bench::Write<uint32_t>(request, 1, static_cast<uint32_t>(options.messages));
+    bench::Write<uint32_t>(request, 5, static_cast<uint32_t>(options.message_size));
+
+    AllocationCounter allocations;
+    auto start = Clock::now();
+    connections[0].client->Send(request, sizeof(request));
+    result.ok = done.WaitFor(options.timeout);
+    result.elapsed_sec = Seconds(start);
+    allocations.Stop(result);
+    server_allocations.Stop(result);
+
+    for (auto& conn : connections)
+    {
+        conn.client->Close();
+    }
+    event_loop->Stop();
+    event_loop->Wait();
+
+    for (auto& conn : connections)
+    {
+        result.messages += conn.received;
+    }
+    result.bytes = result.messages * std::max<size_t>(options.message_size, 1);
+    return result;
+}
+
+Result RunIngest(const Ptr<net::EventLoop>& event_loop, const Options& options)
+{
+    Result result;
+    std::vector<Connection> connections(options.connections);
+    for (auto& conn : connections)
+    {
+        conn.client = CreateClient(event_loop, options);
+    }
+
+    // 서버의 통계 응답. 기준값을 얻을때와 끝났을때 사용한다.
+    std::atomic<uint64_t> server_messages{ 0 };
+    std::unique_ptr<Latch> stats_latch;
+    auto on_message = [&](Connection& /*conn*/, const uint8_t* buf, size_t size)
+    {
+        ServerStats stats;
+        if (!ReadServerStats(buf, size, stats))
+            return;
+
+        uint64_t messages = stats.messages;
+        uint64_t current = server_messages.load();
+        while (messages > current && !server_messages.compare_exchange_weak(current, messages))
+        {
+        }
+        stats_latch->CountDown();
+    };
+
+    ServerAllocationCounter server_allocations;
+    if (!ConnectAll(connections, options, on_message) || !server_allocations.Start(event_loop, options))
+    {
+        result.ok = false;
+        return result;
+    }
+
+    uint8_t stats_request = bench::Stats;
+    stats_latch = std::make_unique<Latch>(1);
+    connections[0].client->Send(&stats_request, 1);
+    if (!stats_latch->WaitFor(options.timeout))
+    {
+        result.ok = false;
+        return result;
+    }
+    uint64_t baseline = server_messages.load();
+
+    // 연결마다 보낸 뒤 통계를 요청한다. 응답이 오면 그 연결에서 보낸 메시지는 모두 처리된 것이다.
+    stats_latch = std::make_unique<Latch>(connections.size());
+    auto payload = MakePayload(bench::Ingest, options.message_size);
+    auto buf = net::ByteSendBuffer::Create(payload.data(), payload.size());
+    AllocationCounter allocations;
+    auto start = Clock::now();
+    for (size_t i = 0; i < options.messages; i++)
+    {
+        for (auto& conn : connections)
+        {
+            conn.client->Send(buf);
+        }
+    }
+    for (auto& conn : connections)
+    {
+        conn.client->Send(&stats_request, 1);
+    }
+    result.ok = stats_latch->WaitFor(options.timeout);
+    result.elapsed_sec = Seconds(start);
+    allocations.Stop(result);
+    server_allocations.Stop(result);
+
+    for (auto& conn : connections)
+    {
+        conn.client->Close();
+    }
+    event_loop->Stop();
+    event_loop->Wait();
+
+    result.messages = options.messages * connections.size();
+    result.bytes = result.messages * payload.size();
+    result.server_messages = server_messages.load() - baseline;
+    result.ok = result.ok && result.server_messages >= result.messages;
+    return result;
+}
+
+Result RunChurn(const Ptr<net::EventLoop>& event_loop, const Options& options)
+{
+    Result result;
+    std::mutex mutex;
+    // 닫은 클라이언트도 끝날때까지 보관한다. 핸들러가 클라이언트를 참조하기 때문.
+    std::vector<Ptr<net::NetClient>> clients;
+    std::vector<uint64_t> latency_ns;
+    std::atomic<size_t> started{ 0 };
+    std::atomic<size_t> completed{ 0 };
+    std::atomic<size_t> failed{ 0 };
+    Latch done(options.messages);
+    auto payload = MakePayload(bench::Echo, options.message_size);
+
+    // 접속해서 echo 응답을 받으면 닫고 다음 접속을 시작한다.
+    std::function<void()> connect_next = [&]()
+    {
+        if (started.fetch_add(1) >= options.messages)
+            return;
+
+        auto client = CreateClient(event_loop, options);
+        net::NetClient* c = client.get();
+        uint64_t connect_time = NowNs();
+        c->RegisterNetEventHandler([&, c](const net::NetEventType& ev)
+        {
+            if (ev == net::NetEventType::Opened)
+            {
+                c->Send(payload.data(), payload.size());
+            }
+            else if (ev == net::NetEventType::ConnectFailed)
+            {
+                failed++;
+                done.CountDown();
+                connect_next();
+            }
+        });
+        c->RegisterMessageHandler([&, c, connect_time](uint16_t /*message_type*/, const uint8_t* /*buf*/, size_t /*size*/)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                latency_ns.emplace_back(NowNs() - connect_time);
+            }
+            c->Close();
+            completed++;
+            done.CountDown();
+            connect_next();
+        });
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            clients.emplace_back(client);
+        }
+        c->Connect(options.host, options.port);
+    };
+
+    ServerAllocationCounter server_allocations;
+    if (!server_allocations.Start(event_loop, options))
+    {
+        result.ok = false;
+        return result;
+    }
+
+    AllocationCounter allocations;
+    auto start = Clock::now();
+    for (size_t i = 0; i < options.connections; i++)
+    {
+        connect_next();
+    }
+    result.ok = done.WaitFor(options.timeout) && failed == 0;
+    result.elapsed_sec = Seconds(start);
+    allocations.Stop(result);
+    server_allocations.Stop(result);
+
+    event_loop->Stop();
+    event_loop->Wait();
+
+    result.messages = completed;
+    result.bytes = result.messages * payload.size();
+    result.latency_ns = std::move(latency_ns);
+    return result;
+}
+
+void WriteJson(std::ostream& os, const Options& options, Result& result)
+{
+    std::sort(result.latency_ns.begin(), result.latency_ns.end());
+    auto percentile = [&result](double p) -> double
+    {
+        if (result.latency_ns.empty())
+            return 0;
+        size_t index = std::min(result.latency_ns.size() - 1, static_cast<size_t>(p * result.latency_ns.size()));
+        return result.latency_ns[index] / 1000.0;
+    };
+
+    double elapsed = std::max(result.elapsed_sec, 1e-9);
+    os << "{\n"
+        << "  \"scenario\": \"" << options.scenario << "\",\n"
+        << "  \"ok\": " << (result.ok ? "true" : "false") << ",\n"
+        << "  \"connections\": " << options.connections << ",\n"
+        << "  \"threads\": " << options.threads << ",\n"
+        << "  \"message_size\": " << options.message_size << ",\n"
+        << "  \"no_delay\": " << (options.no_delay ? "true" : "false") << ",\n"
+        << "  \"elapsed_sec\": " << result.elapsed_sec << ",\n"
+        << "  \"messages\": " << result.messages << ",\n"
+        << "  \"bytes\": " << result.bytes << ",\n"
+        << "  \"messages_per_sec\": " << result.messages / elapsed << ",\n"
+        << "  \"mb_per_sec\": " << result.bytes / elapsed / (1024 * 1024) << ",\n"
+        << "  \"heap_allocs_per_message\": " << (result.messages ? double(result.heap_allocations) / result.messages : 0) << ",\n"
+        << "  \"handler_heap_allocs\": " << result.handler_heap_allocations << ",\n"
+        << "  \"server_heap_allocs_per_message\": " << (result.messages ? double(result.server_heap_allocations) / result.messages : 0);
+    if (options.scenario == "ingest")
+    {
+        os << ",\n  \"server_messages\": " << result.server_messages;
+    }
+    if (!result.latency_ns.empty())
+    {
+        os << ",\n  \"latency_us\": { "
+            << "\"p50\": " << percentile(0.50) << ", "
+            << "\"p99\": " << percentile(0.99) << ", "
+            << "\"p999\": " << percentile(0.999) << ", "
+            << "\"max\": " << result.latency_ns.back() / 1000.0 << " }";
+    }
+    os << "\n}" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+
+    po::options_description desc("TestClient");
+    desc.add_options()
+        ("help", "help message")
+        ("scenario", po::value<std::string>(&options.scenario)->default_value("echo"), "echo | fanout | ingest | churn")
+        ("host", po::value<std::string>(&options.host)->default_value("127.0.0.1"))
+        ("port", po::value<std::string>(&options.port)->default_value("8888"))
+        ("connections", po::value<size_t>(&options.connections)->default_value(1))
+        ("threads", po::value<size_t>(&options.threads)->default_value(2))
+        ("size", po::value<size_t>(&options.message_size)->default_value(64), "payload size")
+        ("messages", po::value<size_t>(&options.messages)->default_value(10000), "per connection (churn: total connects)")
+        ("timeout", po::value<size_t>(&options.timeout)->default_value(60), "seconds")
+        ("no-delay", po::bool_switch(&options.no_delay))
+        ("output", po::value<std::string>(&options.output), "json file (default: stdout)");
+
+    po::variables_map vm;
+    try
+    {
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << "\n" << desc << std::endl;
+        return 1;
+    }
+
+    if (vm.count("help"))
+    {
+        std::cout << desc << std::endl;
+        return 0;
+    }
+
+    // 결과 JSON 과 섞이지 않도록 경고 이상만 로그를 남긴다.
+    boost::log::core::get()->set_filter(boost::log::trivial::severity >= boost::log::trivial::warning);
+
+    options.connections = std::max<size_t>(options.connections, 1);
+    options.threads = std::max<size_t>(options.threads, 1);
+    options.messages = std::max<size_t>(options.messages, 1);
+
+    auto event_loop = std::make_shared<net::EventLoop>(options.threads);
+
+    Result result;
+    if (options.scenario == "echo")
+        result = RunEcho(event_loop, options);
+    else if (options.scenario == "fanout")
+        result = RunFanOut(event_loop, options);
+    else if (options.scenario == "ingest")
+        result = RunIngest(event_loop, options);
+    else if (options.scenario == "churn")
+        result = RunChurn(event_loop, options);
+    else
+    {
+        std::cerr << "Unknown scenario: " << options.scenario << "\n" << desc << std::endl;
+        return 1;
+    }
+
+    if (options.output.empty())
+    {
+        WriteJson(std::cout, options, result);
+    }
+    else
+    {
+        std::ofstream file(options.output);
+        WriteJson(file, options, result);
+    }
+
+    return result.ok ? 0 : 1;
 }
\ No newline at end of file
@@ -5,10 +5,14 @@
 
 #pragma once
 
+#if defined(_WIN32)
 #include "targetver.h"
+#endif
 
 #include <stdio.h>
+#if defined(_WIN32)
 #include <tchar.h>
+#endif
 
 
 
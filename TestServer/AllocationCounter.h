@@ -0,0 +1,39 @@
+#pragma once
+
+#include <new>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+
+// 벤치마크 중의 힙 할당 횟수를 세기 위해 전역 operator new 를 교체한다.
+// 교체 함수는 inline 일수 없으므로 실행 파일마다 한 소스에서만 포함한다.
+std::atomic<uint64_t> g_heap_allocations{ 0 };
+
+void* operator new(size_t size)
+{
+    g_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    void* p = std::malloc(size ? size : 1);
+    if (p == nullptr)
+        throw std::bad_alloc();
+    return p;
+}
+
+// GCC 는 operator new 가 malloc 으로 할당한 것을 모르고 free 를 호출하는 곳마다 경고한다.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
\ No newline at end of file
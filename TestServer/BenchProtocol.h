@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+// TestServer 와 TestClient 가 주고받는 벤치마크 메시지.
+// payload 의 첫 바이트가 명령이고 나머지는 명령마다 다르다.
+namespace bench {
+
+    enum Op : uint8_t
+    {
+        Echo = 'E',         // [op][uint64 보낸 시간(ns)][padding] 그대로 돌려준다.
+        Ingest = 'I',       // [op][padding] 받은 수만 센다.
+        FanOut = 'F',       // [op][uint32 count][uint32 size] 모든 연결에 FanOutData 를 count 번 보낸다.
+        FanOutData = 'f',   // [op][padding]
+        Stats = 'S',        // 요청 [op], 응답 [op][uint64 받은 메시지 수][uint64 받은 바이트][uint64 서버 힙 할당 수]
+        ThreadStats = 'T',  // 요청 [op] 서버가 스레드 사용률을 로그로 남긴다. 응답은 없다.
+    };
+
+    constexpr size_t STATS_REPLY_SIZE = 25;
+
+    template <typename T>
+    inline void Write(uint8_t* dst, size_t offset, T value)
+    {
+        std::memcpy(dst + offset, &value, sizeof(T));
+    }
+
+    template <typename T>
+    inline T Read(const uint8_t* src, size_t offset)
+    {
+        T value;
+        std::memcpy(&value, src + offset, sizeof(T));
+        return value;
+    }
+
+} // namespace bench
\ No newline at end of file
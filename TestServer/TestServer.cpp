@@ -1,36 +1,188 @@
 // TestServer.cpp : Defines the entry point for the console application.
 //
+// TestClient 의 벤치마크 시나리오를 처리하는 서버.
+//   TestServer --port 8888 --threads 4 --no-delay
+//   TestServer --port 8888 --threads 4 --context-per-thread --io-uring
+//   TestServer --port 8888 --threads 4 --context-per-thread --spin-time 50 --cpus 0,1,2,3
+//   TestServer --port 8888 --stats-interval 1000
+//
 
 #include "stdafx.h"
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <boost/program_options.hpp>
 #include <network.h>
+#include "BenchProtocol.h"
+#include "AllocationCounter.h"
+
+namespace po = boost::program_options;
+
+std::mutex g_mutex;
+std::unordered_map<int, Ptr<net::Session>> g_sessions;
+std::atomic<uint64_t> g_ingest_messages{ 0 };
+std::atomic<uint64_t> g_ingest_bytes{ 0 };
+Ptr<net::EventLoop> g_event_loop;
 
 void OnOpen(const Ptr<net::Session>& session)
 {
-    BOOST_LOG_TRIVIAL(info) << "OnOpen";
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_sessions.emplace(session->GetID(), session);
+}
+
+void OnClose(const Ptr<net::Session>& session, const net::CloseReason& /*reason*/)
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_sessions.erase(session->GetID());
+}
+
+// 한번 만든 버퍼를 모든 세션에 보낸다.
+void FanOut(uint32_t count, uint32_t size)
+{
+    std::vector<uint8_t> payload(std::max<uint32_t>(size, 1), 0);
+    payload[0] = bench::FanOutData;
+    auto buf = net::ByteSendBuffer::Create(payload.data(), payload.size());
+
+    std::vector<Ptr<net::Session>> sessions;
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        sessions.reserve(g_sessions.size());
+        for (auto& pair : g_sessions)
+        {
+            sessions.emplace_back(pair.second);
+        }
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        for (auto& session : sessions)
+        {
+            session->Send(buf);
+        }
+    }
 }
 
-void OnClose(const Ptr<net::Session>& session, const net::CloseReason& reason)
+// 스레드마다 핸들러를 실행한 시간, poll 만 한 시간, 블록한 시간의 비율.
+void LogThreadStats()
 {
-    BOOST_LOG_TRIVIAL(info) << "OnClose";
+    for (auto& stats : g_event_loop->GetThreadStats())
+    {
+        uint64_t total = std::max<uint64_t>(stats.busy_time + stats.spin_time + stats.idle_time, 1);
+        BOOST_LOG_TRIVIAL(info) << stats.name << " cpu:" << stats.cpu
+            << " busy:" << stats.busy_time * 100 / total << "%"
+            << " spin:" << stats.spin_time * 100 / total << "%"
+            << " idle:" << stats.idle_time * 100 / total << "%"
+            << " handlers:" << stats.handlers << " wakeups:" << stats.wakeups;
+    }
 }
 
-void OnMessage(const Ptr<net::Session>& session, const uint8_t* buf, size_t size)
+void OnMessage(const Ptr<net::Session>& session, uint16_t /*message_type*/, const uint8_t* buf, size_t size)
 {
-    BOOST_LOG_TRIVIAL(info) << "OnMessage";
+    if (size == 0)
+        return;
+
+    switch (buf[0])
+    {
+    case bench::Echo:
+        session->Send(buf, size);
+        break;
+    case bench::Ingest:
+        g_ingest_messages.fetch_add(1, std::memory_order_relaxed);
+        g_ingest_bytes.fetch_add(size, std::memory_order_relaxed);
+        break;
+    case bench::FanOut:
+        if (size >= 9)
+            FanOut(bench::Read<uint32_t>(buf, 1), bench::Read<uint32_t>(buf, 5));
+        break;
+    case bench::Stats:
+    {
+        uint8_t reply[bench::STATS_REPLY_SIZE];
+        reply[0] = bench::Stats;
+        bench::Write<uint64_t>(reply, 1, g_ingest_messages.load());
+        bench::Write<uint64_t>(reply, 9, g_ingest_bytes.load());
+        bench::Write<uint64_t>(reply, 17, g_heap_allocations.load());
+        session->Send(reply, sizeof(reply));
+        break;
+    }
+    case bench::ThreadStats:
+        LogThreadStats();
+        break;
+    default:
+        BOOST_LOG_TRIVIAL(info) << "Unknown op: " << static_cast<int>(buf[0]);
+        break;
+    }
 }
 
-int main()
+int main(int argc, char* argv[])
 {
-    auto event_loop = std::make_shared<net::EventLoop>(2);
+    uint16_t port;
+    size_t thread_count;
+    bool no_delay;
+    bool context_per_thread;
+    bool io_uring;
+    size_t spin_time;
+    bool thread_stats;
+    size_t stats_interval;
+    std::string cpus;
+
+    po::options_description desc("TestServer");
+    desc.add_options()
+        ("help", "help message")
+        ("port", po::value<uint16_t>(&port)->default_value(8888))
+        ("threads", po::value<size_t>(&thread_count)->default_value(2))
+        ("no-delay", po::bool_switch(&no_delay))
+        ("context-per-thread", po::bool_switch(&context_per_thread))
+        ("io-uring", po::bool_switch(&io_uring))
+        ("spin-time", po::value<size_t>(&spin_time)->default_value(0), "us to poll before blocking")
+        ("thread-stats", po::bool_switch(&thread_stats), "count event loop thread usage")
+        ("cpus", po::value<std::string>(&cpus)->default_value(""), "comma separated cpus to pin threads")
+        ("stats-interval", po::value<size_t>(&stats_interval)->default_value(0), "ms between network stats logs");
+
+    po::variables_map vm;
+    try
+    {
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << "\n" << desc << std::endl;
+        return 1;
+    }
+
+    if (vm.count("help"))
+    {
+        std::cout << desc << std::endl;
+        return 0;
+    }
+
+    net::EventLoopConfig loop_config;
+    loop_config.thread_count = thread_count;
+    loop_config.mode = context_per_thread ? net::EventLoopMode::ContextPerThread : net::EventLoopMode::Shared;
+    loop_config.spin_time = spin_time;
+    loop_config.thread_stats = thread_stats;
+    std::stringstream cpu_list(cpus);
+    std::string cpu;
+    while (std::getline(cpu_list, cpu, ','))
+    {
+        if (!cpu.empty())
+            loop_config.cpu_affinity.push_back(std::stoi(cpu));
+    }
+    auto event_loop = std::make_shared<net::EventLoop>(loop_config);
+    g_event_loop = event_loop;
     net::ServerConfig config;
     config.event_loop = event_loop;
+    config.no_delay = no_delay;
+    config.io_uring = io_uring;
+    config.stats_log_interval = stats_interval;
 
     auto server = net::NetServer::Create(config);
     server->RegisterSessionOpenedHandler(OnOpen);
     server->RegisterSessionClosedHandler(OnClose);
     server->RegisterMessageHandler(OnMessage);
 
-    server->Start(8888);
+    server->Start(port);
     event_loop->Wait();
 
     return 0;